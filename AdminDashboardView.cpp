@@ -14,16 +14,30 @@
 #include <QFrame> // Added for separator line
 #include <QTabWidget>
 #include "SystemInteractionModule.h" // Include the definition for SystemInteractionModule
+#include "ConfigStore.h"
+#include "BackgroundRenderer.h"
+#include "Trace.h"
 #include <QProgressDialog> // For better user feedback during detection
 #include "DetectionResultDialog.h" // Make sure this is included
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QFile>
 #include <QPainter>
+#include <QPaintEvent>
 #include <QPixmap>
 #include <QSettings> // 用于注册表操作
 #include <QCheckBox>
 
+// 图标尚未解析时列表项显示的灰色占位图标
+static const QIcon& placeholderIcon() {
+    static const QIcon icon = [] {
+        QPixmap defaultPixmap(32, 32);
+        defaultPixmap.fill(Qt::gray);
+        return QIcon(defaultPixmap);
+    }();
+    return icon;
+}
+
 AdminDashboardView::AdminDashboardView(SystemInteractionModule* systemInteractionModule, QWidget *parent)
     : QWidget(parent)
     , m_mainLayout(nullptr)
@@ -55,6 +69,8 @@ AdminDashboardView::AdminDashboardView(SystemInteractionModule* systemInteractio
     , m_forceTopmostCheckBox(nullptr)
 {
     qDebug() << "管理员仪表盘(AdminDashboardView): 已创建。";
+    m_background = new BackgroundRenderer(this, QColor(236, 239, 241));
+    m_background->setImage(":/images/admin_bg.jpg");
     setupUi();
 
     // Connect the detectionCompleted signal from SystemInteractionModule
@@ -74,76 +90,7 @@ void AdminDashboardView::setupUi()
     setWindowTitle("管理员仪表盘");
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     this->setObjectName("AdminDashboardView");
-    this->setStyleSheet("QWidget#AdminDashboardView { background-image: url(:/images/admin_bg.jpg); background-repeat: no-repeat; background-position: center; background-attachment: fixed; }");
-    // setMinimumSize(800, 600); // Increased size for more content
-
-    // Material Design inspired stylesheet
-    this->setStyleSheet(QString(
-        "QWidget { background-color: #ECEFF1; color: #263238; }" // Main background and default text color
-        "QLabel { background-color: transparent; }" // Ensure labels have transparent background
-        "QPushButton {"
-        "    background-color: #536DFE; /* Indigo A200 */"
-        "    color: white;"
-        "    border: none;"
-        "    padding: 8px 16px;"
-        "    font-size: 13px;" // Slightly smaller font for material like buttons
-        "    border-radius: 4px;"
-        "    text-transform: uppercase;" // Material buttons often have uppercase text
-        "}"
-        "QPushButton:hover {"
-        "    background-color: #3D5AFE; /* Indigo A400 */"
-        "}"
-        "QPushButton:pressed {"
-        "    background-color: #304FFE; /* Indigo A700 */"
-        "}"
-        "QListWidget {"
-        "    background-color: #FFFFFF;"
-        "    border: 1px solid #CFD8DC; /* Blue Grey 100 */"
-        "    border-radius: 4px;"
-        "    padding: 4px;"
-        "}"
-        "QListWidget::item {"
-        "    padding: 8px 12px; /* More padding for items */"
-        "    border-bottom: 1px solid #ECEFF1; /* Separator for items */"
-        "}"
-        "QListWidget::item:last-child {"
-        "    border-bottom: none;"
-        "}"
-        "QListWidget::item:selected {"
-        "    background-color: #536DFE; /* Indigo A200 */"
-        "    color: white;"
-        "    border-radius: 2px;" // Slight radius for selected item background
-        "}"
-        "QLineEdit {" // Basic styling for QInputDialog's line edit if needed
-        "    padding: 6px;"
-        "    border: 1px solid #CFD8DC;"
-        "    border-radius: 4px;"
-        "    background-color: white;"
-        "    min-height: 20px; /* Ensure line edits have a decent height */"
-        "}"
-        "QGroupBox { font-weight: bold; border: 1px solid #CFD8DC; border-radius: 4px; margin-top: 10px; }" 
-        "QGroupBox::title { subcontrol-origin: margin; subcontrol-position: top left; padding: 0 5px 0 5px; background-color: #ECEFF1; }"
-        "QTabWidget::pane { border: 1px solid #CFD8DC; border-top: 1px solid #CFD8DC; border-radius: 4px; background-color: #FFFFFF; margin-top: -1px; }"
-        "QTabWidget::tab-bar { alignment: left; }"
-        "QTabBar::tab {"
-        "    background-color: #ECEFF1; /* Light background for inactive tabs */"
-        "    color: #263238; /* Dark text for inactive tabs */"
-        "    border: 1px solid #CFD8DC;"
-        "    border-bottom: none; /* Remove bottom border for tabs */"
-        "    border-top-left-radius: 4px;"
-        "    border-top-right-radius: 4px;"
-        "    padding: 8px 16px;"
-        "    margin-right: 2px; /* Space between tabs */"
-        "}"
-        "QTabBar::tab:selected {"
-        "    background-color: #FFFFFF; /* White background for selected tab */"
-        "    color: #263238; /* Dark text for selected tab */"
-        "    border-color: #CFD8DC;"
-        "}"
-        "QTabBar::tab:hover {"
-        "    background-color: #E0E0E0; /* Slightly darker on hover */"
-        "}"
-    ));
+    // 仪表盘样式（Material Design 风格）来自应用级主题中的 AdminDashboardView.qss，按对象名限定范围
 
     m_mainLayout = new QVBoxLayout(this);
     m_mainLayout->setSpacing(15);
@@ -193,7 +140,7 @@ void AdminDashboardView::setupUi()
     QHBoxLayout* hotkeyDisplayLayout = new QHBoxLayout();
     m_currentHotkeyTitleLabel = new QLabel("当前管理员热键:", hotkeySettingsGroup);
     m_currentHotkeyDisplayLabel = new QLabel("[" + tr("未设置或加载中...") + "]", hotkeySettingsGroup);
-    m_currentHotkeyDisplayLabel->setStyleSheet("font-weight: bold; padding: 2px 5px; background-color: white; border: 1px solid #CFD8DC; border-radius: 3px;");
+    m_currentHotkeyDisplayLabel->setObjectName("currentHotkeyDisplayLabel");
     m_editHotkeyButton = new QPushButton("修改热键...", hotkeySettingsGroup);
     connect(m_editHotkeyButton, &QPushButton::clicked, this, &AdminDashboardView::onChangeHotkeyClicked);
     hotkeyDisplayLayout->addWidget(m_currentHotkeyTitleLabel);
@@ -241,20 +188,8 @@ void AdminDashboardView::setupUi()
     m_detectionWaitMsSpinBox->setRange(1000, 60000);
     m_detectionWaitMsSpinBox->setSingleStep(1000);
     m_detectionWaitMsSpinBox->setSuffix(" ms");
-    // 读取config.json初始化
-    QFile configFile("config.json");
-    int waitMs = 10000;
-    if (configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QJsonParseError err;
-        QJsonDocument doc = QJsonDocument::fromJson(configFile.readAll(), &err);
-        if (err.error == QJsonParseError::NoError && doc.isObject()) {
-            QJsonObject obj = doc.object();
-            if (obj.contains("detection_wait_ms") && obj["detection_wait_ms"].isDouble()) {
-                waitMs = obj["detection_wait_ms"].toInt();
-            }
-        }
-    }
-    m_detectionWaitMsSpinBox->setValue(waitMs);
+    m_detectionWaitMsSpinBox->setValue(ConfigStore::instance().detectionWaitMs());
+    connect(&ConfigStore::instance(), &ConfigStore::detectionWaitMsChanged, m_detectionWaitMsSpinBox, &QSpinBox::setValue);
     m_saveDetectionWaitMsButton = new QPushButton("保存", detectionWaitGroup);
     connect(m_saveDetectionWaitMsButton, &QPushButton::clicked, this, &AdminDashboardView::onDetectionWaitMsSaveClicked);
     detectionWaitLayout->addWidget(detectionWaitLabel);
@@ -304,23 +239,7 @@ void AdminDashboardView::setupUi()
     });
 
     m_exitApplicationButton = new QPushButton("退出整个程序", this);
-    m_exitApplicationButton->setStyleSheet(
-        "QPushButton {" \
-        "    background-color: #D32F2F; /* Red 700 */" \
-        "    color: white;" \
-        "    border: none;" \
-        "    padding: 8px 16px;" \
-        "    font-size: 13px;" \
-        "    border-radius: 4px;" \
-        "    text-transform: uppercase;" \
-        "}" \
-        "QPushButton:hover {" \
-        "    background-color: #C62828; /* Red 800 */" \
-        "}" \
-        "QPushButton:pressed {" \
-        "    background-color: #B71C1C; /* Red 900 */" \
-        "}"
-    );
+    m_exitApplicationButton->setObjectName("exitApplicationButton"); // 红色警示样式见 AdminDashboardView.qss
     connect(m_exitApplicationButton, &QPushButton::clicked, this, &AdminDashboardView::onExitApplicationClicked);
     
     QHBoxLayout* bottomLayout = new QHBoxLayout();
@@ -354,6 +273,8 @@ void AdminDashboardView::populateWhitelistView()
         item->setToolTip(itemText); // 设置工具提示显示完整文本
         if (!app.icon.isNull()) {
             item->setIcon(app.icon);
+        } else {
+            item->setIcon(placeholderIcon());
         }
         // 创建自定义小部件，包含两个QCheckBox
         QWidget* widget = new QWidget();
@@ -378,6 +299,37 @@ void AdminDashboardView::populateWhitelistView()
         widget->setLayout(layout);
         m_whitelistListWidget->addItem(item);
         m_whitelistListWidget->setItemWidget(item, widget);
+        if (app.icon.isNull()) {
+            requestAppIcon(app.path);
+        }
+    }
+}
+
+void AdminDashboardView::requestAppIcon(const QString& appPath)
+{
+    QFuture<IconHandle> future = IconRegistry::instance().acquireAsync(appPath);
+    if (future.isFinished()) {
+        applyAppIcon(appPath, future.result()); // 已解析过，直接使用
+        return;
+    }
+    // 回调在 GUI 线程执行；列表可能已重建，按路径重新查找列表项
+    future.then(this, [this, appPath](IconHandle handle) {
+        applyAppIcon(appPath, handle);
+    });
+}
+
+void AdminDashboardView::applyAppIcon(const QString& appPath, IconHandle handle)
+{
+    const QIcon icon = IconRegistry::instance().icon(handle);
+    if (icon.isNull()) {
+        qWarning() << "AdminDashboardView: icon for" << appPath << "could not be extracted, keeping placeholder.";
+        return;
+    }
+    for (int row = 0; row < m_whitelistListWidget->count(); ++row) {
+        QListWidgetItem* item = m_whitelistListWidget->item(row);
+        if (item->data(Qt::UserRole).toString() == appPath) {
+            item->setIcon(icon);
+        }
     }
 }
 
@@ -468,14 +420,7 @@ void AdminDashboardView::onAddAppClicked()
     // 自动补全 mainExecutableHint，确保后续状态栏能正确探测进程
     QFileInfo fi(appPath);
     newApp.mainExecutableHint = fi.fileName(); // 以文件名作为进程名Hint
-    // Try to get icon - for now, this might be a basic attempt or rely on AdminModule later
-    // For immediate UI update, we might need a temporary icon or SystemInteractionModule direct call if safe.
-    // Let's assume icon loading is handled when the list is fully processed by AdminModule/UserModeModule.
-    // For this local view, we might not load it here, or just try a basic QIcon(appPath).
-    newApp.icon = QIcon(appPath); // Basic icon load attempt for the list view
-    if (newApp.icon.isNull()) {
-        qWarning() << "AdminDashboardView: Could not load icon for" << appPath << "during add.";
-    }
+    // 图标留空：列表与 Dock 都会通过 IconRegistry 异步提取
 
     // 在populateWhitelistView()中，为每个应用条目动态添加QWidget（含两个QCheckBox），并与AppInfo的smartTopmost/forceTopmost字段联动。勾选变化时，更新m_currentApps并emit whitelistChanged。
     // 在onAddAppClicked和onDetectionDialogApplied中，弹窗增加两个QCheckBox，用户可选择置顶策略，保存到newApp.smartTopmost/forceTopmost。
@@ -695,18 +640,7 @@ void AdminDashboardView::onDetectionDialogApplied(const QString& finalMainExecut
     newApp.mainExecutableHint = finalMainExecutableHint;
     newApp.windowFindingHints = finalWindowHints;
 
-    // --- BEGIN MODIFICATION: Get and set the icon ---
-    if (m_systemInteractionModulePtr && !m_pendingDetectionAppPath.isEmpty()) {
-        newApp.icon = m_systemInteractionModulePtr->getIconForExecutable(m_pendingDetectionAppPath);
-        if (newApp.icon.isNull()) {
-            qWarning() << "AdminDashboardView: Failed to get icon for" << m_pendingDetectionAppPath << ". Using default icon.";
-            // Optionally set a default icon here if desired, e.g.:
-            // newApp.icon = QApplication::style()->standardIcon(QStyle::SP_ExecutableFile);
-        }
-    } else {
-        qWarning() << "AdminDashboardView: SystemInteractionModule is null or pending app path is empty, cannot get icon. App will have no icon.";
-    }
-    // --- END MODIFICATION ---
+    // 图标留空：populateWhitelistView() 先显示占位图标，再通过 IconRegistry 异步提取
 
     // 在populateWhitelistView()中，为每个应用条目动态添加QWidget（含两个QCheckBox），并与AppInfo的smartTopmost/forceTopmost字段联动。勾选变化时，更新m_currentApps并emit whitelistChanged。
     // 在onAddAppClicked和onDetectionDialogApplied中，弹窗增加两个QCheckBox，用户可选择置顶策略，保存到newApp.smartTopmost/forceTopmost。
@@ -726,38 +660,14 @@ void AdminDashboardView::onDetectionDialogApplied(const QString& finalMainExecut
 
 void AdminDashboardView::onDetectionWaitMsSaveClicked() {
     int newWaitMs = m_detectionWaitMsSpinBox->value();
-    QFile configFile("config.json");
-    if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, "保存失败", "无法打开配置文件");
-        return;
-    }
-    QJsonParseError err;
-    QJsonDocument doc = QJsonDocument::fromJson(configFile.readAll(), &err);
-    configFile.close();
-    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
-        QMessageBox::warning(this, "保存失败", "配置文件格式错误");
-        return;
-    }
-    QJsonObject obj = doc.object();
-    obj["detection_wait_ms"] = newWaitMs;
-    if (!configFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        QMessageBox::warning(this, "保存失败", "无法写入配置文件");
-        return;
-    }
-    configFile.write(QJsonDocument(obj).toJson(QJsonDocument::Indented));
-    configFile.close();
+    ConfigStore::instance().setDetectionWaitMs(newWaitMs);
     QMessageBox::information(this, "保存成功", "探测等待时间已保存");
 }
 
 void AdminDashboardView::paintEvent(QPaintEvent *event) {
-    Q_UNUSED(event);
+    Trace::Span span("ui.paint.adminDashboard");
     QPainter painter(this);
-    QPixmap bg(":/images/admin_bg.jpg");
-    if (!bg.isNull()) {
-        painter.drawPixmap(this->rect(), bg);
-    } else {
-        painter.fillRect(this->rect(), QColor(236, 239, 241)); // Fallback background
-    }
+    m_background->paint(painter, event->rect());
 }
 
 // 辅助函数：检测当前是否已设置自启动，并同步复选框
@@ -10,6 +10,7 @@
 #include <QLineEdit> // Added for QLineEdit
 #include <windows.h> // Added for DWORD type
 #include "common_types.h" // Corrected path
+#include "IconRegistry.h"
 #include "DetectionResultDialog.h" // <<< Include DetectionResultDialog
 #include <QSpinBox>
 #include <QCheckBox> // 新增：用于自启动复选框
@@ -21,6 +22,7 @@
 // class HotkeySettingsWidget;
 class SystemInteractionModule; // Forward declare
 class UserModeModule; // Forward declare
+class BackgroundRenderer;
 
 class AdminDashboardView : public QWidget
 {
@@ -66,6 +68,10 @@ private slots:
 private:
     void setupUi();
     void populateWhitelistView(); // Helper to refresh the list view
+    // 通过 IconRegistry 异步取应用图标，列表项先显示占位图标
+    void requestAppIcon(const QString& appPath);
+    // 图标解析完成后替换对应列表项的占位图标
+    void applyAppIcon(const QString& appPath, IconHandle handle);
 
     // Main layout and TabWidget
     QVBoxLayout *m_mainLayout;
@@ -124,6 +130,7 @@ private:
     void updateTopmostCheckBoxState(); // 辅助函数
 
     QProgressDialog* m_detectionProgressDialog; // 新增：探测进度弹窗指针
+    BackgroundRenderer* m_background = nullptr; // 背景图片（预缩放缓存）
 
     bool isSmartTopmostEnabled() const;
     bool isForceTopmostEnabled() const;
@@ -5,7 +5,6 @@
 #include <QLineEdit>
 #include <QDebug>
 #include <QCoreApplication>
-#include <QFile>
 
 AdminLoginView::AdminLoginView(QWidget *parent)
     : QWidget{parent}
@@ -28,16 +27,7 @@ void AdminLoginView::setupUi()
 
     setWindowFlags(Qt::Tool | Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint);
 
-    QFile styleFile(QCoreApplication::applicationDirPath() + "/AdminLoginView.qss");
-    if (styleFile.open(QFile::ReadOnly | QFile::Text)) {
-        QString styleSheet = QLatin1String(styleFile.readAll());
-        this->setStyleSheet(styleSheet);
-        styleFile.close();
-        qDebug() << "管理员登录视图(AdminLoginView): 成功加载 AdminLoginView.qss";
-    } else {
-        qWarning() << "管理员登录视图(AdminLoginView): 无法加载 AdminLoginView.qss: " << styleFile.errorString();
-        this->setStyleSheet("background-color: #f0f0f0; border: 1px solid #cccccc; border-radius: 5px;");
-    }
+    // 样式来自应用级主题中的 AdminLoginView.qss（已编译进资源），按对象名 AdminLoginView 匹配
 
     m_infoLabel->setText("请输入管理员密码");
     m_infoLabel->setAlignment(Qt::AlignCenter);
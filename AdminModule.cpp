@@ -2,6 +2,8 @@
 #include "AdminLoginView.h"
 #include "AdminDashboardView.h"
 #include "SystemInteractionModule.h"
+#include "ConfigStore.h"
+#include "IconRegistry.h"
 #include "common_types.h"
 #include <QDebug>
 #include <QFile>
@@ -15,6 +17,7 @@
 #include <QDir>
 #include <QCryptographicHash>
 #include <QTimer>
+#include <QSet>
 
 AdminModule::AdminModule(SystemInteractionModule* systemInteraction, AdminDashboardView* dashboardView, QObject *parent)
     : QObject(parent),
@@ -36,6 +39,12 @@ AdminModule::AdminModule(SystemInteractionModule* systemInteraction, AdminDashbo
         connect(m_adminDashboardView, &AdminDashboardView::changePasswordRequested, this, &AdminModule::onChangePasswordRequested);
         connect(m_adminDashboardView, &AdminDashboardView::adminLoginHotkeyChanged, this, &AdminModule::onAdminLoginHotkeyChanged);
     }
+    // 配置文件被外部修改时只更新变化的部分（白名单只为变化的应用重新取图标）
+    connect(&ConfigStore::instance(), &ConfigStore::configReloaded, this, &AdminModule::onConfigReloaded);
+    // 配置在后台线程写入，失败时才提示管理员
+    connect(&ConfigStore::instance(), &ConfigStore::saveFailed, this, [this](const QString& error) {
+        QMessageBox::critical(m_adminDashboardView, "保存失败", "无法将配置写入配置文件：" + error);
+    });
     qDebug() << "管理员模块(AdminModule): 构造函数结束。";
 }
 
@@ -191,7 +200,7 @@ void AdminModule::onAdminLoginHotkeyChanged(const QList<DWORD>& newHotkeySequenc
     qDebug() << "管理员模块(AdminModule): 转换后的热键字符串:" << newHotkeyVkStrings.join(" + ");
 
     if (saveAdminLoginHotkeyToConfig(newHotkeyVkStrings)) {
-        // m_systemInteractionModulePtr->loadConfiguration(); // This is already called inside saveAdminLoginHotkeyToConfig
+        // SystemInteractionModule 通过 ConfigStore::shortcutsChanged 自动重新加载热键
         qDebug() << "管理员模块(AdminModule): 管理员登录热键已更新并保存到配置。 SystemInteractionModule 将重新加载配置。";
         emit configurationChanged();
     } else {
@@ -229,150 +238,22 @@ void AdminModule::onWhitelistUpdated(const QList<AppInfo>& updatedWhitelist) {
 
 void AdminModule::loadConfig()
 {
-    QString configPath = AdminModule::getConfigFilePath();
-    qDebug() << "管理员模块(AdminModule): 尝试从以下路径加载配置文件:" << configPath;
-
-    QFile configFile(configPath);
-    bool needSaveDefault = false; // 标记是否需要补全并保存
-    if (!configFile.exists()) {
-        qWarning() << "管理员模块(AdminModule): 配置文件不存在，将创建默认配置。 Path:" << configPath;
-        // 1. 首次生成时，主动设置默认密码和默认热键，避免生成空配置
-        if (m_adminPasswordHash.isEmpty()) {
-            QCryptographicHash hasher(QCryptographicHash::Sha256);
-            hasher.addData("123456"); // 默认密码
-            m_adminPasswordHash = QString::fromUtf8(hasher.result().toHex());
-        }
-        if (m_currentAdminLoginHotkeyVkCodes.isEmpty()) {
-            m_currentAdminLoginHotkeyVkCodes.clear();
-            m_currentAdminLoginHotkeyVkCodes.append(VK_LCONTROL);
-            m_currentAdminLoginHotkeyVkCodes.append(VK_LSHIFT);
-            m_currentAdminLoginHotkeyVkCodes.append(0x41); // A
-        }
-        needSaveDefault = true;
-    } else if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "管理员模块(AdminModule): 无法打开配置文件进行读取。 Path:" << configPath;
-        return;
-    }
-
-    QJsonObject rootObj;
-    if (configFile.isOpen()) {
-        QByteArray configData = configFile.readAll();
-        configFile.close();
-        QJsonDocument configDoc = QJsonDocument::fromJson(configData);
-        if (configDoc.isObject()) {
-            rootObj = configDoc.object();
-        }
-    }
-
-    // 自动补全 admin_password 字段
-    if (!rootObj.contains("admin_password") || !rootObj["admin_password"].isString()) {
-        QCryptographicHash hasher(QCryptographicHash::Sha256);
-        hasher.addData("123456");
-        rootObj["admin_password"] = QString::fromUtf8(hasher.result().toHex());
-        m_adminPasswordHash = rootObj["admin_password"].toString();
-        needSaveDefault = true;
-        qDebug() << "管理员模块(AdminModule): 自动补全默认管理员密码。";
-    } else {
-        m_adminPasswordHash = rootObj["admin_password"].toString();
-    }
-
-    // 自动补全 shortcuts 字段
-    if (!rootObj.contains("shortcuts") || !rootObj["shortcuts"].isObject()) {
-        QJsonObject shortcutsObj;
-        QJsonObject adminLoginObj;
-        QJsonArray hotkeyArray;
-        hotkeyArray.append("VK_LCONTROL");
-        hotkeyArray.append("VK_LSHIFT");
-        hotkeyArray.append("A");
-        adminLoginObj["key_sequence"] = hotkeyArray;
-        shortcutsObj["admin_login"] = adminLoginObj;
-        rootObj["shortcuts"] = shortcutsObj;
-        m_currentAdminLoginHotkeyVkCodes.clear();
-        m_currentAdminLoginHotkeyVkCodes.append(VK_LCONTROL);
-        m_currentAdminLoginHotkeyVkCodes.append(VK_LSHIFT);
-        m_currentAdminLoginHotkeyVkCodes.append(0x41); // A
-        needSaveDefault = true;
-        qDebug() << "管理员模块(AdminModule): 自动补全默认管理员热键。";
-    } else {
-        // 读取热键
-        QJsonObject shortcutsObj = rootObj["shortcuts"].toObject();
-        if (shortcutsObj.contains("admin_login") && shortcutsObj["admin_login"].isObject()) {
-            QJsonObject adminLoginObj = shortcutsObj["admin_login"].toObject();
-            if (adminLoginObj.contains("key_sequence") && adminLoginObj["key_sequence"].isArray()) {
-                QJsonArray hotkeyArray = adminLoginObj["key_sequence"].toArray();
-                m_currentAdminLoginHotkeyVkCodes.clear();
-                for (const QJsonValue& val : hotkeyArray) {
-                    if (val.isString() && m_systemInteractionModulePtr) {
-                        DWORD vkCode = m_systemInteractionModulePtr->stringToVkCode(val.toString());
-                        if (vkCode != 0) {
-                            m_currentAdminLoginHotkeyVkCodes.append(vkCode);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    // 配置文件由 ConfigStore 统一解析，缺失的密码、热键、白名单字段已在其中补全并写回
+    const ConfigStore& config = ConfigStore::instance();
+    qDebug() << "管理员模块(AdminModule): 从 ConfigStore 加载配置:" << ConfigStore::configFilePath();
 
-    // 自动补全 whitelist_apps 字段
-    if (!rootObj.contains("whitelist_apps") || !rootObj["whitelist_apps"].isArray()) {
-        rootObj["whitelist_apps"] = QJsonArray();
-        needSaveDefault = true;
-        qDebug() << "管理员模块(AdminModule): 自动补全默认白名单。";
-    }
+    m_adminPasswordHash = config.adminPasswordHash();
+    loadAdminLoginHotkeyFromConfig();
 
-    // 如有需要，写回补全后的配置
-    if (needSaveDefault) {
-        QFile outFile(configPath);
-        if (outFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-            QJsonDocument outDoc(rootObj);
-            outFile.write(outDoc.toJson(QJsonDocument::Indented));
-            outFile.close();
-            qDebug() << "管理员模块(AdminModule): 已写回补全后的默认配置。";
-        } else {
-            qWarning() << "管理员模块(AdminModule): 无法写入补全后的默认配置。";
-        }
-    }
-
-    // 继续后续加载流程（如填充白名单等）
     // Load Whitelisted Apps
-    m_whitelistedApps.clear();
-    if (rootObj.contains("whitelist_apps") && rootObj["whitelist_apps"].isArray()) {
-        QJsonArray appsArray = rootObj["whitelist_apps"].toArray();
-        for (const QJsonValue &appVal : appsArray) {
-            if (appVal.isObject()) {
-                QJsonObject appObj = appVal.toObject();
-                AppInfo appInfo;
-                appInfo.name = appObj.value("name").toString();
-                appInfo.path = appObj.value("path").toString();
-                
-                // 确保正确读取 mainExecutableHint 和 windowFindingHints
-                appInfo.mainExecutableHint = appObj.value("mainExecutableHint").toString();
-                appInfo.windowFindingHints = appObj.value("windowFindingHints").toObject();
-                appInfo.smartTopmost = appObj.value("smartTopmost").toBool(true);
-                appInfo.forceTopmost = appObj.value("forceTopmost").toBool(false);
-
-                // Icon loading (priority: SystemInteractionModule, then direct path, then QIcon(appInfo.path))
-            if (m_systemInteractionModulePtr) {
-                    appInfo.icon = m_systemInteractionModulePtr->getIconForExecutable(appInfo.path);
-                } else if (appObj.contains("icon_path") && appObj["icon_path"].isString()) {
-                    // This is a fallback if SIM is not available, icon_path was a legacy idea
-                    // For consistency, it's better to rely on SIM or QIcon(path)
-                    appInfo.icon = QIcon(appObj["icon_path"].toString()); 
-            }
-                if (appInfo.icon.isNull() && !appInfo.path.isEmpty()) {
-                     appInfo.icon = QIcon(appInfo.path); // Basic fallback if no icon found yet
-                }
-
-                if (!appInfo.name.isEmpty() && !appInfo.path.isEmpty()) {
-                    m_whitelistedApps.append(appInfo);
-                    qDebug() << "管理员模块(AdminModule): 已加载白名单应用:" << appInfo.name
-                             << "Path:" << appInfo.path
-                             << "Hint:" << appInfo.mainExecutableHint; // 确认Hint是否正确打印
-                    if (!appInfo.windowFindingHints.isEmpty()) {
-                         qDebug() << "  with WindowHints:" << QJsonDocument(appInfo.windowFindingHints).toJson(QJsonDocument::Compact);
-                    }
-                }
-            }
+    m_whitelistedApps = config.whitelistApps();
+    for (const AppInfo& appInfo : qAsConst(m_whitelistedApps)) {
+        prefetchAppIcon(appInfo);
+        qDebug() << "管理员模块(AdminModule): 已加载白名单应用:" << appInfo.name
+                 << "Path:" << appInfo.path
+                 << "Hint:" << appInfo.mainExecutableHint;
+        if (!appInfo.windowFindingHints.isEmpty()) {
+             qDebug() << "  with WindowHints:" << QJsonDocument(appInfo.windowFindingHints).toJson(QJsonDocument::Compact);
         }
     }
     qDebug() << "管理员模块(AdminModule): 共加载" << m_whitelistedApps.size() << "个白名单应用。";
@@ -386,20 +267,54 @@ void AdminModule::loadConfig()
     qDebug() << "管理员模块(AdminModule): 配置文件加载完成。";
 }
 
-void AdminModule::saveConfig() 
+void AdminModule::loadAdminLoginHotkeyFromConfig()
+{
+    m_currentAdminLoginHotkeyVkCodes = ConfigStore::instance().adminLoginHotkeyVkCodes();
+}
+
+void AdminModule::prefetchAppIcon(const AppInfo& appInfo)
+{
+    // appInfo.icon 只保留配置中的 icon_path；可执行文件图标由仪表盘列表与 Dock 各自通过
+    // IconRegistry 异步取得（先显示占位图标）。这里提前排队提取，打开仪表盘时多半已就绪。
+    if (appInfo.icon.isNull()) {
+        IconRegistry::instance().acquireAsync(appInfo.path);
+    }
+}
+
+void AdminModule::onConfigReloaded(const ConfigStore::ConfigDiff& diff)
 {
-    QString configPath = AdminModule::getConfigFilePath();
-    qDebug() << "管理员模块(AdminModule): 准备保存完整配置到:" << configPath;
-
-    QJsonObject rootObj;
-    QFile configFile(configPath);
-    if (configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QJsonDocument oldDoc = QJsonDocument::fromJson(configFile.readAll());
-        if (oldDoc.isObject()) {
-            rootObj = oldDoc.object();
+    const ConfigStore& config = ConfigStore::instance();
+    if (diff.adminPasswordChanged) {
+        m_adminPasswordHash = config.adminPasswordHash();
+        qDebug() << "管理员模块(AdminModule): 管理员密码已随配置文件更新。";
+    }
+    if (diff.shortcutsChanged) {
+        loadAdminLoginHotkeyFromConfig();
+    }
+    if (diff.hasAppChanges()) {
+        // 只为新增或修改的应用预取图标，未变化的应用已在注册表中
+        QSet<QString> loadedPaths;
+        for (const AppInfo& appInfo : qAsConst(m_whitelistedApps)) {
+            loadedPaths.insert(appInfo.path);
         }
-        configFile.close();
+        const QList<AppInfo> apps = config.whitelistApps();
+        for (const AppInfo& appInfo : apps) {
+            if (!loadedPaths.contains(appInfo.path) || diff.modifiedApps.contains(appInfo.path)) {
+                prefetchAppIcon(appInfo);
+            }
+        }
+        m_whitelistedApps = apps;
+        qDebug() << "管理员模块(AdminModule): 白名单已随配置文件更新，共" << m_whitelistedApps.size() << "个应用。";
+    }
+    if ((diff.hasAppChanges() || diff.shortcutsChanged) && m_adminDashboardView) {
+        prepareAdminDashboardData();
     }
+}
+
+void AdminModule::saveConfig() 
+{
+    qDebug() << "管理员模块(AdminModule): 准备保存完整配置到 ConfigStore。";
+    ConfigStore& config = ConfigStore::instance();
 
     // Save Admin Password Hash (ensure it's loaded or default set before this)
     if (m_adminPasswordHash.isEmpty()) { 
@@ -408,7 +323,7 @@ void AdminModule::saveConfig()
         hasher.addData("123456"); // 默认密码
         m_adminPasswordHash = QString::fromUtf8(hasher.result().toHex());
     }
-    rootObj["admin_password"] = m_adminPasswordHash;
+    config.setAdminPasswordHash(m_adminPasswordHash);
 
     // Save Admin Login Hotkey (ensure it's loaded or default set)
     if (m_currentAdminLoginHotkeyVkCodes.isEmpty()) {
@@ -418,59 +333,23 @@ void AdminModule::saveConfig()
         m_currentAdminLoginHotkeyVkCodes.append(VK_LSHIFT);
         m_currentAdminLoginHotkeyVkCodes.append(0x41); // A
     }
-    QJsonObject shortcutsObj;
-    QJsonObject adminLoginObj;
-    QJsonArray hotkeyArray;
+    QStringList hotkeyNames;
     if (m_systemInteractionModulePtr) {
         for (DWORD vkCode : m_currentAdminLoginHotkeyVkCodes) {
-            hotkeyArray.append(m_systemInteractionModulePtr->vkCodeToString(vkCode));
+            hotkeyNames.append(m_systemInteractionModulePtr->vkCodeToString(vkCode));
         }
     } else {
         for (DWORD vkCode : m_currentAdminLoginHotkeyVkCodes) {
-            hotkeyArray.append(QString::number(vkCode));
+            hotkeyNames.append(QString::number(vkCode));
         }
         qWarning() << "管理员模块(AdminModule): SIM为空，热键将以数字形式保存。";
     }
-    adminLoginObj["key_sequence"] = hotkeyArray;
-    shortcutsObj["admin_login"] = adminLoginObj;
-    rootObj["shortcuts"] = shortcutsObj;
+    // SystemInteractionModule 监听 shortcutsChanged 自动重新加载热键
+    config.setAdminLoginHotkey(hotkeyNames);
 
     // Save Whitelisted Apps
-    QJsonArray appsArray;
-    for (const AppInfo &app : m_whitelistedApps) {
-        QJsonObject appObj;
-        appObj["name"] = app.name;
-        appObj["path"] = app.path;
-        if (!app.mainExecutableHint.isEmpty()) {
-            appObj["mainExecutableHint"] = app.mainExecutableHint;
-        }
-        if (!app.windowFindingHints.isEmpty()) {
-            appObj["windowFindingHints"] = app.windowFindingHints;
-        }
-        if (app.smartTopmost != true) {
-            appObj["smartTopmost"] = app.smartTopmost;
-        }
-        if (app.forceTopmost != false) {
-            appObj["forceTopmost"] = app.forceTopmost;
-        }
-        appsArray.append(appObj);
-    }
-    rootObj["whitelist_apps"] = appsArray;
-
-    if (!configFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        qWarning() << "管理员模块(AdminModule): 无法打开配置文件进行写入:" << configPath;
-        return;
-    }
-    QJsonDocument newDoc(rootObj);
-    configFile.write(newDoc.toJson(QJsonDocument::Indented));
-    configFile.close();
+    config.setWhitelistApps(m_whitelistedApps);
     qDebug() << "管理员模块(AdminModule): 完整配置已保存。";
-
-    // After saving, SystemInteractionModule might need to reload its part of config (hotkeys)
-    if (m_systemInteractionModulePtr) {
-        qDebug() << "管理员模块(AdminModule): 通知SystemInteractionModule重新加载配置。";
-        m_systemInteractionModulePtr->loadConfiguration(); // Ensure SIM reloads hotkeys
-    }
 }
 
 void AdminModule::initializeDefaultAdminHotkey() {
@@ -486,80 +365,9 @@ void AdminModule::initializeDefaultAdminHotkey() {
 
 bool AdminModule::saveWhitelistToConfig(const QList<AppInfo>& apps)
 {
-    QString configPath = AdminModule::getConfigFilePath();
-    qDebug() << "[AdminModule::saveWhitelistToConfig] Attempting to save" << apps.count() << "apps to:" << configPath;
-
-    QFile configFile(configPath);
-    QJsonObject rootObj;
-
-    // Try to load existing config to preserve other settings
-    QFile configFileRead(configPath);
-    if (configFileRead.exists() && configFileRead.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QByteArray currentConfigData = configFileRead.readAll();
-        configFileRead.close();
-        QJsonDocument currentConfigDoc = QJsonDocument::fromJson(currentConfigData);
-        if (currentConfigDoc.isObject()) {
-            rootObj = currentConfigDoc.object();
-        }
-    } else {
-        qDebug() << "管理员模块(AdminModule): 现有配置文件无法读取或不存在，将创建新的根对象。";
-    }
-
-    QJsonArray appsArray;
-    for (const AppInfo &app : apps) {
-        QJsonObject appObj;
-        appObj["name"] = app.name;
-        appObj["path"] = app.path;
-
-        // Serialize mainExecutableHint if it's not empty
-        if (!app.mainExecutableHint.isEmpty()) {
-            appObj["mainExecutableHint"] = app.mainExecutableHint;
-        }
-
-        // Serialize windowFindingHints if it's not empty
-        if (!app.windowFindingHints.isEmpty()) {
-            appObj["windowFindingHints"] = app.windowFindingHints;
-        }
-
-        // Serialize smartTopmost if it's not default
-        if (app.smartTopmost != true) {
-            appObj["smartTopmost"] = app.smartTopmost;
-        }
-
-        // Serialize forceTopmost if it's not default
-        if (app.forceTopmost != false) {
-            appObj["forceTopmost"] = app.forceTopmost;
-        }
-
-        // Note: Icon is not saved as a path here; it's dynamically loaded.
-        // If a persistent icon_path was desired, it would be saved here.
-        appsArray.append(appObj);
-    }
-    rootObj["whitelist_apps"] = appsArray; 
-    qDebug() << "管理员模块(AdminModule):" << apps.size() << "个应用已序列化到JSON。";
-
-    QFile configFileWrite(configPath);
-    if (!configFileWrite.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        qWarning() << "管理员模块(AdminModule): 无法打开配置文件进行写入:" << configPath;
-        return false;
-    }
-
-    QJsonDocument newDoc(rootObj);
-    configFileWrite.write(newDoc.toJson());
-    configFileWrite.close();
-    qDebug() << "管理员模块(AdminModule): 白名单已成功写入并通过 configFile.close()。";
-
-    // Re-read and verify
-    QFile verifyFile(configPath);
-    if (verifyFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "[AdminModule::saveWhitelistToConfig] Verification: Successfully re-opened config file for reading.";
-        QByteArray content = verifyFile.readAll();
-        qDebug() << "[AdminModule::saveWhitelistToConfig] Verification: Content after save:\n" << content;
-        verifyFile.close();
-    } else {
-        qWarning() << "[AdminModule::saveWhitelistToConfig] Verification: Failed to re-open config file for reading after save:" << verifyFile.errorString();
-    }
-
+    qDebug() << "[AdminModule::saveWhitelistToConfig] Saving" << apps.count() << "apps to ConfigStore.";
+    // 图标不写入配置，由界面按路径动态加载
+    ConfigStore::instance().setWhitelistApps(apps); // 写入在后台合并进行，失败时经 saveFailed 提示
     return true;
 }
 
@@ -580,29 +388,7 @@ bool AdminModule::saveAdminPasswordToConfig(const QString& newPassword) {
         return false;
     }
     m_adminPasswordHash = QString(QCryptographicHash::hash(newPassword.toUtf8(), QCryptographicHash::Sha256).toHex());
-    
-    QString configPath = AdminModule::getConfigFilePath();
-    
-    QFile configFile(configPath);
-    QJsonObject rootObj;
-
-    if (configFile.exists() && configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QJsonDocument existingDoc = QJsonDocument::fromJson(configFile.readAll());
-        if (existingDoc.isObject()) {
-            rootObj = existingDoc.object();
-        }
-        configFile.close();
-    }
-
-    rootObj["admin_password"] = m_adminPasswordHash;
-
-    QJsonDocument newDoc(rootObj);
-    if (!configFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        qWarning() << "管理员模块(AdminModule): 无法打开配置文件写入新密码: " << configFile.errorString();
-        return false;
-    }
-    configFile.write(newDoc.toJson(QJsonDocument::Indented));
-    configFile.close();
+    ConfigStore::instance().setAdminPasswordHash(m_adminPasswordHash);
     qDebug() << "管理员模块(AdminModule): 新的管理员密码哈希已保存到配置文件。";
     return true;
 }
@@ -613,43 +399,9 @@ bool AdminModule::saveAdminLoginHotkeyToConfig(const QStringList& hotkeyVkString
         return false;
     }
 
-    QString configPath = AdminModule::getConfigFilePath();
-
-    QFile configFile(configPath);
-    QJsonObject rootObj;
-
-    if (configFile.exists() && configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QJsonDocument existingDoc = QJsonDocument::fromJson(configFile.readAll());
-        if (existingDoc.isObject()) {
-            rootObj = existingDoc.object();
-        }
-        configFile.close();
-    }
-    
-    QJsonObject shortcutsObj;
-    if (rootObj.contains("shortcuts") && rootObj["shortcuts"].isObject()) {
-        shortcutsObj = rootObj["shortcuts"].toObject();
-    }
-    QJsonObject adminLoginObj;
-    if (shortcutsObj.contains("admin_login") && shortcutsObj["admin_login"].isObject()) {
-        adminLoginObj = shortcutsObj["admin_login"].toObject(); 
-    }
-    adminLoginObj["key_sequence"] = QJsonArray::fromStringList(hotkeyVkStrings);
-    shortcutsObj["admin_login"] = adminLoginObj;
-    rootObj["shortcuts"] = shortcutsObj;
-
-    QJsonDocument newDoc(rootObj);
-    if (!configFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        qWarning() << "管理员模块(AdminModule): 无法打开配置文件写入新热键: " << configFile.errorString();
-        return false;
-    }
-    configFile.write(newDoc.toJson(QJsonDocument::Indented));
-    configFile.close();
+    // SystemInteractionModule 监听 ConfigStore::shortcutsChanged 自动重新加载热键
+    ConfigStore::instance().setAdminLoginHotkey(hotkeyVkStrings);
     qDebug() << "管理员模块(AdminModule): 新的管理员登录热键 (字符串) 已保存到配置文件:" << hotkeyVkStrings.join(" + ");
-    
-    if(m_systemInteractionModulePtr) {
-        m_systemInteractionModulePtr->loadConfiguration(); // Предположим, что SIM имеет loadConfiguration
-    }
     return true;
 }
 
@@ -674,12 +426,3 @@ void AdminModule::prepareAdminDashboardData()
          qWarning() << "管理员模块(AdminModule): 管理员仪表盘视图实例为空，无法准备数据！";
     }
 }
-
-// 静态函数：统一获取配置文件路径，始终使用当前登录用户的USERPROFILE目录，避免管理员/普通用户路径不一致
-QString AdminModule::getConfigFilePath() {
-    // 通过环境变量USERPROFILE获取当前登录用户主目录，确保所有身份下配置一致
-    QString userProfile = qEnvironmentVariable("USERPROFILE");
-    QString configDir = userProfile + "/AppData/Roaming/雪鸮团队/剑鞘系统";
-    QDir().mkpath(configDir); // 确保目录存在
-    return configDir + "/config.json";
-}
\ No newline at end of file
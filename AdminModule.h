@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QList> // Required for QList
 #include "common_types.h" // Include common_types.h for WhitelistedApp
+#include "ConfigStore.h"
 #include <Windows.h> // Added for DWORD
 #include <QStringList>
 
@@ -40,6 +41,7 @@ private slots:
     void onLoginAttempt(const QString& password); // Slot for login attempts
     void onChangePasswordRequested(const QString& currentPassword, const QString& newPassword); // Slot for password change requests
     void onLoginViewHidden(); // Added slot to handle AdminLoginView hidden
+    void onConfigReloaded(const ConfigStore::ConfigDiff& diff); // 配置文件被外部修改
 
 signals:
     void adminViewVisible(bool visible);
@@ -60,6 +62,8 @@ private:
     void loadConfig(); 
     void saveConfig(); // Assuming this will be implemented later or its usage removed if not needed
     void initializeDefaultAdminHotkey(); // Added declaration, needs implementation
+    void loadAdminLoginHotkeyFromConfig(); // 从 ConfigStore 取已解析的热键虚拟键码
+    void prefetchAppIcon(const AppInfo& appInfo); // 在图标工作线程预先提取，不等待结果
 
     // Existing private methods, ensure they are all used or remove if obsolete
     void loadWhitelistFromConfig();
@@ -74,9 +78,6 @@ private:
 public: // Ensure prepareAdminDashboardData is public if called from CoreShell
     void prepareAdminDashboardData(); // MOVED to public
 
-    // 新增：统一获取配置文件路径的静态函数声明
-    static QString getConfigFilePath();
-
 };
 
 #endif // ADMINMODULE_H 
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "AlphaBounds.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define ALPHA_BOUNDS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC 无需额外编译选项即可使用 AVX2 内建函数；GCC/Clang 需按函数启用目标特性
+#if defined(_MSC_VER) && !defined(__clang__)
+#define ALPHA_BOUNDS_TARGET_AVX2
+#else
+#define ALPHA_BOUNDS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace AlphaBounds {
+namespace {
+
+inline const std::uint32_t* rowAt(const std::uint32_t* pixels, std::ptrdiff_t bytesPerLine, int y)
+{
+    return reinterpret_cast<const std::uint32_t*>(reinterpret_cast<const unsigned char*>(pixels) + bytesPerLine * y);
+}
+
+inline bool isOpaque(std::uint32_t pixel, int threshold)
+{
+    return int(pixel >> 24) > threshold;
+}
+
+// 各实现只需提供：[begin, end) 中第一个/最后一个不透明像素的下标，没有则返回 -1
+struct ScalarOps {
+    static int first(const std::uint32_t* row, int begin, int end, int threshold)
+    {
+        for (int x = begin; x < end; ++x) {
+            if (isOpaque(row[x], threshold)) return x;
+        }
+        return -1;
+    }
+    static int last(const std::uint32_t* row, int begin, int end, int threshold)
+    {
+        for (int x = end - 1; x >= begin; --x) {
+            if (isOpaque(row[x], threshold)) return x;
+        }
+        return -1;
+    }
+};
+
+#ifdef ALPHA_BOUNDS_X86
+
+inline int lowestBit(unsigned mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return int(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline int highestBit(unsigned mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return int(index);
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+// 每次比较 4 个像素：右移 24 位取出 alpha，与阈值做 32 位比较，movemask 得到 4 位结果
+struct Sse2Ops {
+    static int first(const std::uint32_t* row, int begin, int end, int threshold)
+    {
+        const __m128i limit = _mm_set1_epi32(threshold);
+        int x = begin;
+        for (; x + 4 <= end; x += 4) {
+            const __m128i alpha = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x)), 24);
+            const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(alpha, limit)));
+            if (mask) return x + lowestBit(unsigned(mask));
+        }
+        return ScalarOps::first(row, x, end, threshold);
+    }
+    static int last(const std::uint32_t* row, int begin, int end, int threshold)
+    {
+        const __m128i limit = _mm_set1_epi32(threshold);
+        int x = end;
+        for (; x - 4 >= begin; x -= 4) {
+            const __m128i alpha = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x - 4)), 24);
+            const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(alpha, limit)));
+            if (mask) return x - 4 + highestBit(unsigned(mask));
+        }
+        return ScalarOps::last(row, begin, x, threshold);
+    }
+};
+
+// 与 SSE2 相同，一次 8 个像素
+struct Avx2Ops {
+    ALPHA_BOUNDS_TARGET_AVX2 static int first(const std::uint32_t* row, int begin, int end, int threshold)
+    {
+        const __m256i limit = _mm256_set1_epi32(threshold);
+        int x = begin;
+        for (; x + 8 <= end; x += 8) {
+            const __m256i alpha = _mm256_srli_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x)), 24);
+            const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(alpha, limit)));
+            if (mask) return x + lowestBit(unsigned(mask));
+        }
+        return ScalarOps::first(row, x, end, threshold);
+    }
+    ALPHA_BOUNDS_TARGET_AVX2 static int last(const std::uint32_t* row, int begin, int end, int threshold)
+    {
+        const __m256i limit = _mm256_set1_epi32(threshold);
+        int x = end;
+        for (; x - 8 >= begin; x -= 8) {
+            const __m256i alpha = _mm256_srli_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x - 8)), 24);
+            const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(alpha, limit)));
+            if (mask) return x - 8 + highestBit(unsigned(mask));
+        }
+        return ScalarOps::last(row, begin, x, threshold);
+    }
+};
+
+bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false; // 系统需保存 YMM 寄存器
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // ALPHA_BOUNDS_X86
+
+template <typename Ops>
+Rect scan(const std::uint32_t* pixels, int width, int height, std::ptrdiff_t bytesPerLine, int threshold)
+{
+    Rect rect;
+    // 上边界：第一个含不透明像素的行，同时得到左右边界初值
+    int top = 0;
+    int left = -1;
+    for (; top < height; ++top) {
+        left = Ops::first(rowAt(pixels, bytesPerLine, top), 0, width, threshold);
+        if (left >= 0) break;
+    }
+    if (top == height) return rect; // 全透明
+    int right = Ops::last(rowAt(pixels, bytesPerLine, top), left, width, threshold);
+
+    // 下边界：自底向上第一个含不透明像素的行
+    int bottom = height - 1;
+    for (; bottom > top; --bottom) {
+        const std::uint32_t* row = rowAt(pixels, bytesPerLine, bottom);
+        const int first = Ops::first(row, 0, width, threshold);
+        if (first < 0) continue;
+        left = std::min(left, first);
+        const int last = Ops::last(row, std::max(right + 1, first), width, threshold);
+        if (last >= 0) right = last;
+        break;
+    }
+
+    // 中间各行只需检查当前左右边界以外的列
+    for (int y = top + 1; y < bottom && (left > 0 || right < width - 1); ++y) {
+        const std::uint32_t* row = rowAt(pixels, bytesPerLine, y);
+        if (left > 0) {
+            const int first = Ops::first(row, 0, left, threshold);
+            if (first >= 0) left = first;
+        }
+        if (right < width - 1) {
+            const int last = Ops::last(row, right + 1, width, threshold);
+            if (last >= 0) right = last;
+        }
+    }
+
+    rect.left = left;
+    rect.top = top;
+    rect.right = right;
+    rect.bottom = bottom;
+    return rect;
+}
+
+Kernel detectKernel()
+{
+#ifdef ALPHA_BOUNDS_X86
+    return cpuSupportsAvx2() ? Kernel::Avx2 : Kernel::Sse2;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+} // namespace
+
+Kernel bestKernel()
+{
+    static const Kernel kernel = detectKernel();
+    return kernel;
+}
+
+const char* kernelName(Kernel kernel)
+{
+    switch (kernel) {
+    case Kernel::Scalar: return "scalar";
+    case Kernel::Sse2: return "sse2";
+    case Kernel::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+Rect opaqueBounds(const std::uint32_t* pixels, int width, int height, std::ptrdiff_t bytesPerLine, int threshold)
+{
+    return opaqueBounds(pixels, width, height, bytesPerLine, threshold, bestKernel());
+}
+
+Rect opaqueBounds(const std::uint32_t* pixels, int width, int height, std::ptrdiff_t bytesPerLine, int threshold,
+                  Kernel kernel)
+{
+    if (!pixels || width <= 0 || height <= 0) {
+        return Rect();
+    }
+#ifdef ALPHA_BOUNDS_X86
+    if (kernel == Kernel::Avx2 && bestKernel() == Kernel::Avx2) {
+        return scan<Avx2Ops>(pixels, width, height, bytesPerLine, threshold);
+    }
+    if (kernel == Kernel::Sse2 || kernel == Kernel::Avx2) {
+        return scan<Sse2Ops>(pixels, width, height, bytesPerLine, threshold);
+    }
+#endif
+    return scan<ScalarOps>(pixels, width, height, bytesPerLine, threshold);
+}
+
+} // namespace AlphaBounds
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// =============================
+// 不透明区域包围盒计算
+// =============================
+// 对 32 位 ARGB 像素（alpha 位于最高字节，ARGB32 / ARGB32_Premultiplied 均适用）
+// 求 alpha > threshold 的像素的最小包围矩形，用于裁剪图标四周的透明边距。
+// 先逐行向内收缩上下边界，再只扫描左右边界以外尚未确认的列，整行透明时可整块跳过。
+// x86 上按运行时 CPU 能力选用 AVX2（8 像素/次）或 SSE2（4 像素/次），其它平台使用标量实现。
+namespace AlphaBounds {
+
+enum class Kernel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// 包围矩形（闭区间），全透明时 isEmpty() 为 true
+struct Rect {
+    int left = 0;
+    int top = 0;
+    int right = -1;
+    int bottom = -1;
+    bool isEmpty() const { return right < left || bottom < top; }
+};
+
+// 当前 CPU 可用的最快实现
+Kernel bestKernel();
+const char* kernelName(Kernel kernel);
+
+/**
+ * @brief 求不透明像素的包围矩形
+ * @param pixels 首行像素
+ * @param width 宽度（像素）
+ * @param height 高度（像素）
+ * @param bytesPerLine 行跨度（字节）
+ * @param threshold alpha 大于该值视为不透明
+ */
+Rect opaqueBounds(const std::uint32_t* pixels, int width, int height, std::ptrdiff_t bytesPerLine, int threshold);
+// 指定实现，供基准测试与结果比对使用；请求的实现在当前 CPU 上不可用时退回较慢的实现
+Rect opaqueBounds(const std::uint32_t* pixels, int width, int height, std::ptrdiff_t bytesPerLine, int threshold,
+                  Kernel kernel);
+
+} // namespace AlphaBounds
@@ -0,0 +1,123 @@
+#include "AnimationDriver.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QtMath>
+
+// 帧间隔跟随主屏幕刷新率，限制在 4ms（240Hz）到 33ms（30Hz）之间
+static int frameIntervalMs()
+{
+    qreal refreshRate = 60.0;
+    if (const QScreen* screen = QGuiApplication::primaryScreen()) {
+        if (screen->refreshRate() > 1.0) {
+            refreshRate = screen->refreshRate();
+        }
+    }
+    return qBound(4, qFloor(1000.0 / refreshRate), 33);
+}
+
+AnimationDriver& AnimationDriver::instance()
+{
+    static AnimationDriver driver;
+    return driver;
+}
+
+AnimationDriver::AnimationDriver()
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &AnimationDriver::onFrame);
+    m_clock.start();
+}
+
+void AnimationDriver::animate(QObject* owner, qreal from, qreal to, int durationMs, const QEasingCurve& easing,
+                              ApplyFunction apply)
+{
+    if (durationMs <= 0) {
+        m_animations.remove(owner);
+        apply(to);
+        return;
+    }
+    watch(owner);
+    m_animations.insert(owner, Animation{m_clock.elapsed(), durationMs, from, to, easing, std::move(apply)});
+    ensureRunning();
+}
+
+void AnimationDriver::stop(QObject* owner)
+{
+    m_animations.remove(owner);
+}
+
+void AnimationDriver::addTicker(QObject* owner, TickFunction tick)
+{
+    watch(owner);
+    m_tickers.insert(owner, Ticker{m_clock.elapsed(), std::move(tick)});
+    ensureRunning();
+}
+
+void AnimationDriver::removeTicker(QObject* owner)
+{
+    m_tickers.remove(owner);
+}
+
+void AnimationDriver::watch(QObject* owner)
+{
+    if (m_watched.contains(owner)) {
+        return;
+    }
+    m_watched.insert(owner);
+    connect(owner, &QObject::destroyed, this, [this, owner]() {
+        m_animations.remove(owner);
+        m_tickers.remove(owner);
+        m_watched.remove(owner);
+    });
+}
+
+void AnimationDriver::ensureRunning()
+{
+    if (!m_timer.isActive()) {
+        m_timer.start(frameIntervalMs());
+        qCTrace(lcUi) << "[AnimationDriver] 定时器启动，间隔" << m_timer.interval() << "ms";
+    }
+}
+
+void AnimationDriver::onFrame()
+{
+    Trace::Span span("ui.animation.frame");
+    const qint64 now = m_clock.elapsed();
+    span.attr("animations", m_animations.size());
+    span.attr("tickers", m_tickers.size());
+
+    // 回调可能停止或替换任意 owner 的条目，因此遍历键的快照并逐个重新查找
+    const QList<QObject*> animated = m_animations.keys();
+    for (QObject* owner : animated) {
+        const auto it = m_animations.constFind(owner);
+        if (it == m_animations.constEnd()) {
+            continue;
+        }
+        const Animation animation = *it;
+        const qreal progress = qMin<qreal>(1.0, qreal(now - animation.startMs) / animation.durationMs);
+        const qreal value = progress >= 1.0
+            ? animation.to
+            : animation.from + (animation.to - animation.from) * animation.easing.valueForProgress(progress);
+        if (progress >= 1.0) {
+            m_animations.remove(owner); // 先移除，回调中可以立即开始下一段动画
+        }
+        animation.apply(value);
+    }
+
+    const QList<QObject*> ticking = m_tickers.keys();
+    for (QObject* owner : ticking) {
+        const auto it = m_tickers.constFind(owner);
+        if (it == m_tickers.constEnd()) {
+            continue;
+        }
+        const Ticker ticker = *it;
+        ticker.tick(now - ticker.startMs);
+    }
+
+    if (m_animations.isEmpty() && m_tickers.isEmpty()) {
+        m_timer.stop();
+        qCTrace(lcUi) << "[AnimationDriver] 无活动动画，定时器停止";
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <QEasingCurve>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <functional>
+
+// =============================
+// 共享动画驱动
+// =============================
+// Dock 卡片与悬停图标的缩放动画、加载指示器的帧切换都由这里的一个定时器统一推进：
+// 每一帧按同一时间戳批量计算所有活动动画的值并回调，避免每张卡片各自持有 QPropertyAnimation 与定时器。
+// 定时器间隔取自主屏幕刷新率（无法直接获得垂直同步信号时的近似），使用 PreciseTimer；
+// 没有任何活动动画或周期回调时定时器停止，空闲时不产生唤醒。
+// 每个 owner 最多一个补间动画和一个周期回调，以 owner 为键；owner 销毁时自动移除。仅在 GUI 线程使用。
+class AnimationDriver : public QObject
+{
+    Q_OBJECT
+public:
+    using ApplyFunction = std::function<void(qreal value)>;
+    using TickFunction = std::function<void(qint64 elapsedMs)>;
+
+    static AnimationDriver& instance();
+
+    /**
+     * @brief 开始（或替换）owner 的补间动画
+     * @param owner 动画所属对象
+     * @param from 起始值
+     * @param to 结束值
+     * @param durationMs 时长（毫秒），<= 0 时立即应用结束值
+     * @param easing 缓动曲线
+     * @param apply 每帧以当前值回调；最后一帧的值恰为 to
+     */
+    void animate(QObject* owner, qreal from, qreal to, int durationMs, const QEasingCurve& easing,
+                 ApplyFunction apply);
+    // 停止 owner 的补间动画，值保持在当前帧
+    void stop(QObject* owner);
+    bool isAnimating(QObject* owner) const { return m_animations.contains(owner); }
+
+    // 注册 owner 的周期回调（每帧一次，参数为注册后经过的毫秒数），已存在时替换并重新计时
+    void addTicker(QObject* owner, TickFunction tick);
+    void removeTicker(QObject* owner);
+
+private:
+    AnimationDriver();
+    Q_DISABLE_COPY(AnimationDriver)
+
+    struct Animation {
+        qint64 startMs;
+        int durationMs;
+        qreal from;
+        qreal to;
+        QEasingCurve easing;
+        ApplyFunction apply;
+    };
+    struct Ticker {
+        qint64 startMs;
+        TickFunction tick;
+    };
+
+    void watch(QObject* owner);
+    void ensureRunning();
+    void onFrame();
+
+    QHash<QObject*, Animation> m_animations;
+    QHash<QObject*, Ticker> m_tickers;
+    QSet<QObject*> m_watched; // 已连接 destroyed 信号的 owner
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+};
@@ -1,13 +1,14 @@
 #include "AppCardWidget.h"
+#include "IconVariantStore.h"
+#include "AnimationDriver.h"
+#include "SpinnerFrames.h"
+#include "Theme.h"
 #include <QWidget>
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QMouseEvent>
 #include <QDebug> // For logging
 #include <QPixmap> // Added for icon display
-#include <QFile>   // For loading QSS
-#include <QMovie>  // For loading animation
-#include <QStyle> // Added for style()->polish/unpolish
 #include <QEasingCurve> // For animation easing
 #include <QResizeEvent> // For resize event handling
 #include <QPainter>
@@ -18,78 +19,85 @@
 #include <QSize>
 #include <Qt>
 
-// 辅助函数：裁剪透明边距
-static QRect tightBoundingRect(const QImage& img) {
-    int left = img.width(), right = 0, top = img.height(), bottom = 0;
-    for (int y = 0; y < img.height(); ++y) {
-        for (int x = 0; x < img.width(); ++x) {
-            if (qAlpha(img.pixel(x, y)) > 10) {
-                if (x < left) left = x;
-                if (x > right) right = x;
-                if (y < top) top = y;
-                if (y > bottom) bottom = y;
-            }
-        }
-    }
-    if (left > right || top > bottom) return QRect(0,0,1,1);
-    return QRect(left, top, right-left+1, bottom-top+1);
-}
-
 // 工具函数：缩放并居中pixmap（仅裁剪和缩放，不画圆底）
+// 仅用于未登记到 IconRegistry 的图标（占位图标、配置中的 icon_path）
 static QPixmap scaledCenteredPixmap(const QIcon& icon, const QSize& targetSize) {
     QPixmap origPixmap = icon.pixmap(QSize(128,128));
     if (origPixmap.isNull()) return QPixmap(targetSize); // 返回空白pixmap
-    QImage img = origPixmap.toImage();
-    QRect contentRect = tightBoundingRect(img);
-    QImage trimmed = img.copy(contentRect);
-    QPixmap scaledPixmap = QPixmap::fromImage(trimmed).scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    QPixmap result(targetSize);
-    result.fill(Qt::transparent);
-    QPainter painter(&result);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
-    int x = (result.width() - scaledPixmap.width())/2;
-    int y = (result.height() - scaledPixmap.height())/2;
-    painter.drawPixmap(x, y, scaledPixmap);
-    return result;
+    return QPixmap::fromImage(IconVariantStore::renderCentered(origPixmap.toImage(), targetSize.width(),
+                                                               IconVariantStore::TrimTransparentBorder));
+}
+
+// 图标尚未解析时显示的灰色占位图标，所有卡片共享
+static const QIcon& placeholderIcon() {
+    static const QIcon icon = [] {
+        QPixmap defaultPixmap(56, 56);
+        defaultPixmap.fill(Qt::gray);
+        return QIcon(defaultPixmap);
+    }();
+    return icon;
 }
 
 AppCardWidget::AppCardWidget(const QString& appName, const QString& appPath, const QIcon& appIcon, QWidget *parent)
     : QWidget{parent}, 
-      m_appName(appName), 
-      m_appPath(appPath), 
-      m_appIcon(appIcon), 
       m_isLoading(false),
-      m_scaleFactor(DEFAULT_SCALE),
-      m_scaleAnimation(nullptr)
+      m_scaleFactor(DEFAULT_SCALE)
 {
     setupUi();
-    setObjectName("appCard"); // ID for QSS
-
-    // Load QSS from resource
-    QFile styleFile(":/styles/AppCardWidget.qss"); 
-    if (styleFile.open(QFile::ReadOnly | QFile::Text)) {
-        QString styleSheet = QLatin1String(styleFile.readAll());
-        this->setStyleSheet(styleSheet);
-        styleFile.close();
-    } else {
-        qWarning() << "AppCardWidget: Could not load QSS file.";
+    setObjectName("appCard"); // ID for QSS：样式来自应用级主题（AppCardWidget.qss），卡片自身不再解析样式表
+    const int baseSize = cardExtent(this->logicalDpiX());
+    setFixedSize(baseSize, baseSize);
+
+    bindApp(appName, appPath, appIcon);
+}
+
+void AppCardWidget::bindApp(const QString& appName, const QString& appPath, const QIcon& appIcon)
+{
+    // 复用卡片时先回到静止状态
+    setLoadingState(false);
+    AnimationDriver::instance().stop(this);
+    m_scaleFactor = DEFAULT_SCALE;
+
+    m_appName = appName;
+    m_appPath = appPath;
+    m_nameLabel->setText(appName);
+    m_iconHandle = InvalidIconHandle;
+    // 图标未预先提供时先显示占位图标，真实图标由 IconRegistry 异步提取后替换
+    const bool iconPending = appIcon.isNull();
+    m_appIcon = iconPending ? placeholderIcon() : appIcon;
+    updateIconPixmaps();
+    update();
+
+    if (iconPending) {
+        requestIcon();
     }
-    // 图标健壮性处理：如icon无效则显示默认图标
-    if (m_appIcon.isNull()) {
-        QPixmap defaultPixmap(56, 56);
-        defaultPixmap.fill(Qt::gray);
-        m_appIcon = QIcon(defaultPixmap);
-        qWarning() << "AppCardWidget: appIcon is null, using default icon.";
+}
+
+void AppCardWidget::requestIcon()
+{
+    QFuture<IconHandle> future = IconRegistry::instance().acquireAsync(m_appPath);
+    if (future.isFinished()) {
+        applyIconHandle(future.result()); // 已解析过，直接使用
+        return;
     }
-    // 创建缩放动画
-    m_scaleAnimation = new QPropertyAnimation(this, "scaleFactor");
-    m_scaleAnimation->setDuration(ANIMATION_DURATION);
-    m_scaleAnimation->setEasingCurve(QEasingCurve::OutCubic);
+    // 以 this 为上下文：回调在 GUI 线程执行，卡片销毁后不再回调；
+    // 卡片在解析期间被复用到其它应用时丢弃旧结果
+    future.then(this, [this, appPath = m_appPath](IconHandle handle) {
+        if (appPath == m_appPath) {
+            applyIconHandle(handle);
+        }
+    });
+}
 
-    qreal dpi = this->logicalDpiX();
-    int baseSize = 128 * (dpi / 96.0); // 96为标准DPI
-    setFixedSize(baseSize, baseSize);
+void AppCardWidget::applyIconHandle(IconHandle handle)
+{
+    if (IconRegistry::instance().sourceImage(handle).isNull()) {
+        qWarning() << "AppCardWidget: icon for" << m_appName << "could not be extracted, keeping placeholder.";
+        return;
+    }
+    m_iconHandle = handle;
+    updateIconPixmaps();
+    update();
 }
 
 void AppCardWidget::setupUi()
@@ -97,16 +105,12 @@ void AppCardWidget::setupUi()
     // 移除使用QVBoxLayout进行垂直居中的方法
     // 改为直接在widget中放置图标并手动控制位置
     
-    m_iconLabel = new QLabel(this);
-    m_iconLabel->setObjectName("iconLabel");
-    m_iconLabel->setPixmap(scaledCenteredPixmap(m_appIcon, QSize(56, 56))); // 放大图标
-    m_iconLabel->setFixedSize(QSize(56, 56));//设置固定大小
-    m_iconLabel->setAlignment(Qt::AlignCenter);//设置对齐方式
+    // 图标不再使用子控件，由 paintEvent 直接绘制，悬停缩放不触发任何几何变化
     
     // 取消使用布局，改为手动设置位置
     m_layout = nullptr;
 
-    m_nameLabel = new QLabel(m_appName, this);
+    m_nameLabel = new QLabel(this);
     m_nameLabel->setObjectName("nameLabel");
     m_nameLabel->setAlignment(Qt::AlignCenter);
     m_nameLabel->setWordWrap(true);//
@@ -117,37 +121,39 @@ void AppCardWidget::setupUi()
     m_loadingIndicatorLabel->setAlignment(Qt::AlignCenter);
     m_loadingIndicatorLabel->setVisible(false); // 初始状态为隐藏
 
-    m_loadingMovie = new QMovie(":/icons/loading_spinner.gif");
-    if (m_loadingMovie->isValid()) {
-        m_loadingIndicatorLabel->setMovie(m_loadingMovie);
-        m_loadingMovie->setScaledSize(QSize(32, 32)); //设置缩放大小
-    } else {
+    // 加载动画帧由所有卡片共享，显示时才从 SpinnerFrames 取帧
+    if (!SpinnerFrames::instance().isValid()) {
         qDebug() << "AppCardWidget: Loading spinner GIF not found or invalid. Falling back to text.";
         m_loadingIndicatorLabel->setText("..."); 
     }
-    
-    // 初始化图标位置
-    updateIconPosition();
 }
 
-void AppCardWidget::updateIconPosition()
+void AppCardWidget::updateIconPixmaps()
 {
-    if (m_iconLabel) {
-        // 计算缩放后图标的目标尺寸，最大为卡片本身尺寸的95%
-        int iconBaseSize = qMin(width(), height()) * 0.70; // 图标更大
-        QSize scaledSize = QSize(iconBaseSize * m_scaleFactor, iconBaseSize * m_scaleFactor);
+    const int iconBaseSize = qMin(width(), height()) * 0.70; // 图标更大
+    const int hoverSize = static_cast<int>(iconBaseSize * HOVER_SCALE);
+    m_iconPixmapDpr = devicePixelRatioF();
+    if (m_iconHandle != InvalidIconHandle) {
+        // 两种尺寸都直接使用共享的预缩放变体
+        m_iconPixmap = IconVariantStore::instance().pixmap(m_iconHandle, iconBaseSize, m_iconPixmapDpr,
+                                                           IconVariantStore::TrimTransparentBorder);
+        m_hoverIconPixmap = IconVariantStore::instance().pixmap(m_iconHandle, hoverSize, m_iconPixmapDpr,
+                                                                IconVariantStore::TrimTransparentBorder);
+    } else {
+        m_iconPixmap = scaledCenteredPixmap(m_appIcon, QSize(iconBaseSize, iconBaseSize));
+        m_hoverIconPixmap = scaledCenteredPixmap(m_appIcon, QSize(hoverSize, hoverSize));
+    }
+}
 
-        // 生成缩放后的pixmap并设置到label
-        m_iconLabel->setPixmap(scaledCenteredPixmap(m_appIcon, scaledSize));
-        m_iconLabel->setFixedSize(scaledSize);
-        m_iconLabel->setAttribute(Qt::WA_TranslucentBackground, true); // 保证背景透明
+QRectF AppCardWidget::iconRect() const
+{
+    // 让图标始终居中于卡片（略微上移）
+    const int iconBaseSize = qMin(width(), height()) * 0.70;
+    return QRectF((width() - iconBaseSize) / 2, (height() - iconBaseSize) / 2 - 6, iconBaseSize, iconBaseSize);
+}
 
-        // 让图标始终居中于卡片
-        int scaledX = (width() - scaledSize.width()) / 2;
-        int scaledY = (height() - scaledSize.height()) / 2 - 6;
-        m_iconLabel->move(scaledX, scaledY);
-    }
-    // 加载指示器同理，始终居中
+void AppCardWidget::centerLoadingIndicator()
+{
     if (m_loadingIndicatorLabel && m_loadingIndicatorLabel->isVisible()) {
         int x = (width() - m_loadingIndicatorLabel->width()) / 2;
         int y = (height() - m_loadingIndicatorLabel->height()) / 2;
@@ -155,37 +161,78 @@ void AppCardWidget::updateIconPosition()
     }
 }
 
+void AppCardWidget::paintEvent(QPaintEvent *event)
+{
+    QWidget::paintEvent(event);
+    if (m_isLoading || m_iconPixmap.isNull()) {
+        return;
+    }
+    if (!qFuzzyCompare(m_iconPixmapDpr, devicePixelRatioF())) {
+        updateIconPixmaps(); // 窗口移到了 DPR 不同的屏幕
+    }
+    // 静止时原样绘制静止尺寸的图标；缩放动画的中间帧将悬停尺寸的图标以中心为原点缩小绘制
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    const QRectF rest = iconRect();
+    const bool atRest = qFuzzyCompare(m_scaleFactor, DEFAULT_SCALE);
+    const QPixmap& pixmap = atRest ? m_iconPixmap : m_hoverIconPixmap;
+    const qreal side = atRest ? rest.width() : rest.width() * HOVER_SCALE;
+    const qreal scale = m_scaleFactor * rest.width() / side;
+    painter.translate(rest.center());
+    painter.scale(scale, scale);
+    painter.drawPixmap(QRectF(-side / 2, -side / 2, side, side), pixmap, QRectF(pixmap.rect()));
+}
+
+void AppCardWidget::animateScaleTo(qreal target)
+{
+    AnimationDriver::instance().animate(this, m_scaleFactor, target, ANIMATION_DURATION, QEasingCurve::OutCubic,
+                                        [this](qreal value) { setScaleFactor(value); });
+}
+
+void AppCardWidget::showSpinnerFrame(int index)
+{
+    if (index == m_spinnerFrame) {
+        return; // 帧未变化，不触发重绘
+    }
+    m_spinnerFrame = index;
+    m_loadingIndicatorLabel->setPixmap(SpinnerFrames::instance().frame(index));
+}
+
 void AppCardWidget::setScaleFactor(qreal factor)
 {
     if (qFuzzyCompare(m_scaleFactor, factor))
         return;
         
     m_scaleFactor = factor;
-    updateIconPosition();
-    update();
+    // 只重绘悬停尺寸覆盖的图标区域，不改变任何几何、不触发布局
+    const QRectF rest = iconRect();
+    const qreal hoverSide = rest.width() * HOVER_SCALE;
+    update(QRectF(rest.center() - QPointF(hoverSide, hoverSide) / 2, QSizeF(hoverSide, hoverSide))
+               .toAlignedRect()
+               .adjusted(-1, -1, 1, 1));
 }
 
 void AppCardWidget::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
-    updateIconPosition();
+    updateIconPixmaps();
+    centerLoadingIndicator();
 }
 
 void AppCardWidget::setLoadingState(bool loading)
 {
     if (m_isLoading == loading) return;
     m_isLoading = loading;
-    setProperty("loading", m_isLoading); 
-    style()->unpolish(this); 
-    style()->polish(this);
+    Theme::setVariant(this, "loading", m_isLoading);
 
     if (m_isLoading) {
-        m_iconLabel->setVisible(false);
         m_nameLabel->setVisible(false); 
         
         // 确保加载指示器在AppCardWidget中居中
-        if (m_loadingIndicatorLabel->movie() == m_loadingMovie && m_loadingMovie && m_loadingMovie->isValid()) {
-             m_loadingIndicatorLabel->setFixedSize(m_loadingMovie->currentPixmap().size());
+        const SpinnerFrames& spinner = SpinnerFrames::instance();
+        if (spinner.isValid()) {
+            m_loadingIndicatorLabel->setFixedSize(spinner.frameSize());
+            showSpinnerFrame(0);
         } else {
             m_loadingIndicatorLabel->adjustSize();
         }
@@ -195,23 +242,20 @@ void AppCardWidget::setLoadingState(bool loading)
         m_loadingIndicatorLabel->setGeometry(x, y, m_loadingIndicatorLabel->width(), m_loadingIndicatorLabel->height());
         m_loadingIndicatorLabel->setVisible(true);
 
-        if (m_loadingMovie && m_loadingMovie->isValid()) {
-            m_loadingMovie->start();
+        if (spinner.isAnimated()) {
+            AnimationDriver::instance().addTicker(this, [this](qint64 elapsedMs) {
+                showSpinnerFrame(SpinnerFrames::instance().frameIndexAt(elapsedMs));
+            });
         }
     } else {
-        if (m_loadingMovie && m_loadingMovie->isValid()) {
-            m_loadingMovie->stop();
-        }
+        AnimationDriver::instance().removeTicker(this);
+        m_spinnerFrame = -1;
         m_loadingIndicatorLabel->setVisible(false);
-        m_iconLabel->setVisible(true);
         m_nameLabel->setVisible(false); 
         
         // 重置缩放因子
-        if (m_scaleAnimation->state() == QAbstractAnimation::Running) {
-            m_scaleAnimation->stop();
-        }
+        AnimationDriver::instance().stop(this);
         m_scaleFactor = DEFAULT_SCALE;
-        updateIconPosition();
     }
     update(); 
 }
@@ -231,11 +275,8 @@ void AppCardWidget::mousePressEvent(QMouseEvent *event)
 void AppCardWidget::enterEvent(QEnterEvent *event)
 {
     // 鼠标进入时启动放大动画
-    if (!m_isLoading && m_scaleAnimation) {
-        m_scaleAnimation->stop();
-        m_scaleAnimation->setStartValue(m_scaleFactor);
-        m_scaleAnimation->setEndValue(HOVER_SCALE);
-        m_scaleAnimation->start();
+    if (!m_isLoading) {
+        animateScaleTo(HOVER_SCALE);
     }
     QWidget::enterEvent(event);
 }
@@ -243,11 +284,8 @@ void AppCardWidget::enterEvent(QEnterEvent *event)
 void AppCardWidget::leaveEvent(QEvent *event)
 {
     // 鼠标离开时启动缩小动画
-    if (!m_isLoading && m_scaleAnimation) {
-        m_scaleAnimation->stop();
-        m_scaleAnimation->setStartValue(m_scaleFactor);
-        m_scaleAnimation->setEndValue(DEFAULT_SCALE);
-        m_scaleAnimation->start();
+    if (!m_isLoading) {
+        animateScaleTo(DEFAULT_SCALE);
     }
     QWidget::leaveEvent(event);
 }
\ No newline at end of file
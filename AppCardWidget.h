@@ -4,16 +4,15 @@
 #include <QWidget>
 #include <QString>
 #include <QIcon>
-#include <QPropertyAnimation>
 #include <QRect>
 #include <QImage>
 #include <QPixmap>
 #include <QSize>
 #include <Qt>
+#include "IconRegistry.h"
 
 class QLabel;
 class QVBoxLayout;
-class QMovie;
 
 class AppCardWidget : public QWidget
 {
@@ -24,6 +23,15 @@ public:
     QString getAppPath() const { return m_appPath; }
     QString getAppName() const { return m_appName; }
 
+    /**
+     * @brief 将卡片（重新）绑定到一个应用，供虚拟化的 Dock 复用卡片
+     * @param appIcon 为空时先显示占位图标，再向 IconRegistry 异步请求
+     * @note 会重置悬停动画与加载状态；调用方按需再设置加载状态
+     */
+    void bindApp(const QString& appName, const QString& appPath, const QIcon& appIcon);
+    // 卡片边长（逻辑像素），随逻辑 DPI 缩放
+    static int cardExtent(qreal logicalDpi) { return static_cast<int>(128 * (logicalDpi / 96.0)); } // 96为标准DPI
+
     qreal scaleFactor() const { return m_scaleFactor; }
     void setScaleFactor(qreal factor);
 
@@ -35,21 +43,33 @@ protected:
     void enterEvent(QEnterEvent *event) override;
     void leaveEvent(QEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
 
 signals:
     void launchAppRequested(const QString& appPath, const QString& appName);
 
 private:
     void setupUi();
-    void updateIconPosition();
+    // 按当前卡片尺寸与 DPR 准备静止/悬停两种尺寸的图标；只在尺寸或图标变化时调用
+    void updateIconPixmaps();
+    void centerLoadingIndicator();
+    // 图标静止时的绘制区域；悬停缩放以其中心为原点在绘制时变换，不改变任何控件几何
+    QRectF iconRect() const;
+    // 向 IconRegistry 异步请求图标，完成后替换占位图标
+    void requestIcon();
+    void applyIconHandle(IconHandle handle);
+    // 通过共享的 AnimationDriver 将缩放因子过渡到 target
+    void animateScaleTo(qreal target);
+    void showSpinnerFrame(int index);
 
-    QLabel *m_iconLabel;
+    QPixmap m_iconPixmap;      // 静止尺寸的图标
+    QPixmap m_hoverIconPixmap; // 悬停尺寸的图标，缩放动画的中间帧由它缩小绘制
+    qreal m_iconPixmapDpr = 0; // 生成上述图标时的 DPR
     QLabel *m_nameLabel;
     QVBoxLayout *m_layout;
     QLabel* m_loadingIndicatorLabel;
-    QMovie* m_loadingMovie;
+    int m_spinnerFrame = -1; // 加载指示器当前显示的帧（SpinnerFrames 序号）
 
-    QPropertyAnimation* m_scaleAnimation;
     qreal m_scaleFactor;
     static constexpr qreal DEFAULT_SCALE = 1.0;
     static constexpr qreal HOVER_SCALE = 1.25;
@@ -58,6 +78,7 @@ private:
     QString m_appName;
     QString m_appPath;
     QIcon m_appIcon;
+    IconHandle m_iconHandle = InvalidIconHandle; // 已解析的图标句柄，有效时从 IconVariantStore 取变体
     bool m_isLoading;
 };
 
@@ -3,6 +3,7 @@
 #include <QIcon>
 #include <QDateTime>
 #include <windows.h>
+#include "IconRegistry.h"
 
 // =============================
 // 应用运行状态枚举
@@ -21,7 +22,7 @@ enum class AppRunStatus {
 struct AppStatus {
     QString appName;      // 应用名称
     QString exePath;      // 可执行文件路径
-    QIcon icon;           // 应用图标
+    IconHandle iconHandle = InvalidIconHandle; // 应用图标句柄（图标本体由 IconRegistry 共享）
     AppRunStatus status;  // 当前运行状态
     DWORD pid;            // 进程ID（0表示未运行）
     HWND hwnd;            // 窗口句柄（nullptr表示无窗口）
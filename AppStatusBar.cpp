@@ -4,10 +4,49 @@
 #include <QMouseEvent>
 #include <QMenu>
 #include <QToolTip>
+#include <QPixmap>
 #include "SystemInteractionModule.h"
+#include "IconVariantStore.h"
+#include "Theme.h"
 #include <QAction>
 #include <QMessageBox>
 
+// 运行状态 -> 中文描述
+static QString statusText(AppRunStatus status) {
+    switch (status) {
+        case AppRunStatus::NotRunning: return QStringLiteral("未启动");
+        case AppRunStatus::Running: return QStringLiteral("运行中");
+        case AppRunStatus::Minimized: return QStringLiteral("最小化");
+        case AppRunStatus::Activated: return QStringLiteral("激活中");
+        case AppRunStatus::Error: return QStringLiteral("异常");
+    }
+    return QStringLiteral("未知");
+}
+
+static const int STATUS_ICON_SIZE = 32;
+
+// 图标尚未解析完成时使用的占位图标（所有卡片共享一份）
+static QIcon placeholderIcon() {
+    static const QIcon icon = []() {
+        QPixmap pixmap(STATUS_ICON_SIZE, STATUS_ICON_SIZE);
+        pixmap.fill(Qt::gray);
+        return QIcon(pixmap);
+    }();
+    return icon;
+}
+
+// 运行状态 -> appState 属性值（对应 UserView.qss 中的样式变体）
+static const char* statusStyleKey(AppRunStatus status) {
+    switch (status) {
+        case AppRunStatus::NotRunning: return "notRunning";
+        case AppRunStatus::Running: return "running";
+        case AppRunStatus::Minimized: return "minimized";
+        case AppRunStatus::Activated: return "activated";
+        case AppRunStatus::Error: return "error";
+    }
+    return "notRunning";
+}
+
 // 构造函数
 AppStatusBar::AppStatusBar(QWidget* parent)
     : QWidget(parent), m_model(nullptr)
@@ -15,6 +54,9 @@ AppStatusBar::AppStatusBar(QWidget* parent)
     m_layout = new QHBoxLayout(this);//创建一个水平布局
     // m_layout->setContentsMargins(8, 4, 8, 4);//布局边距交由QSS控制
     // m_layout->setSpacing(10);//布局间距交由QSS控制
+    // 左右两侧常驻弹性空间，保证卡片居中
+    m_layout->addStretch();
+    m_layout->addStretch();
     setLayout(m_layout);//设置布局
     this->setObjectName("appStatusBar");
 }
@@ -26,115 +68,165 @@ void AppStatusBar::setModel(AppStatusModel* model) {
     }
     m_model = model;//设置模型
     if (m_model) {
-        connect(m_model, &AppStatusModel::statusChanged, this, &AppStatusBar::refreshCards);//连接信号和槽
-        refreshCards();
+        connect(m_model, &QAbstractItemModel::rowsInserted, this, &AppStatusBar::onRowsInserted);
+        connect(m_model, &QAbstractItemModel::rowsRemoved, this, &AppStatusBar::onRowsRemoved);
+        connect(m_model, &QAbstractItemModel::rowsMoved, this, &AppStatusBar::onRowsMoved);
+        connect(m_model, &QAbstractItemModel::dataChanged, this, &AppStatusBar::onDataChanged);
+        connect(m_model, &QAbstractItemModel::modelReset, this, &AppStatusBar::refreshCards);
     }
+    refreshCards();
 }
 
-// 刷新所有卡片UI
+// 与模型整体同步：卡片数量对齐到行数，多退少补，然后逐个全量修补
 void AppStatusBar::refreshCards() {
-    // 彻底清理布局中所有项（包括stretch和widget），防止漂移
-    while (QLayoutItem* item = m_layout->takeAt(0)) {
-        if (item->widget()) item->widget()->deleteLater(); // 删除控件/布局项
-        delete item; // 删除布局项（包括stretch）
-    }
-    m_cardWidgets.clear();
-    if (!m_model) return;
-    int count = m_model->rowCount();
-    // 先加左侧弹性空间，保证居中
-    m_layout->addStretch();
-    for (int i = 0; i < count; ++i) {
-        const AppStatus status = m_model->getStatus(i);
-        QPushButton* btn = new QPushButton(this);
-        btn->setIcon(status.icon);
-        btn->setIconSize(QSize(32,32));
+    const int count = m_model ? m_model->rowCount() : 0;
+    while (m_cardWidgets.size() > count) {
+        removeCard(m_cardWidgets.takeLast());
+    }
+    while (m_cardWidgets.size() < count) {
+        QPushButton* card = createCard();
+        m_layout->insertWidget(m_cardWidgets.size() + 1, card);
+        m_cardWidgets.append(card);
+    }
+    for (int row = 0; row < count; ++row) {
+        updateCard(row);
+    }
+}
+
+// 创建卡片并一次性连接信号；槽内按卡片当前所在行读取模型，行号变化无需重连
+QPushButton* AppStatusBar::createCard() {
+    QPushButton* btn = new QPushButton(this);
+    btn->setIconSize(QSize(STATUS_ICON_SIZE, STATUS_ICON_SIZE));
+    btn->setContextMenuPolicy(Qt::CustomContextMenu);
+    // 点击信号：激活窗口
+    connect(btn, &QPushButton::clicked, this, [this, btn]() {
+        const int row = m_cardWidgets.indexOf(btn);
+        if (row < 0 || !m_model) return;
+        const AppStatus status = m_model->getStatus(row);
+        if (status.hwnd && status.status != AppRunStatus::NotRunning) {
+            extern SystemInteractionModule* systemInteractionModule;
+            if (systemInteractionModule) {
+                systemInteractionModule->activateWindow(status.hwnd);
+            }
+        }
+        emit appCardClicked(row);
+    });
+    // 右键菜单
+    connect(btn, &QPushButton::customContextMenuRequested, this, [this, btn](const QPoint& pos) {
+        showCardContextMenu(btn, pos);
+    });
+    return btn;
+}
+
+void AppStatusBar::removeCard(QPushButton* card) {
+    m_layout->removeWidget(card);
+    card->hide();
+    card->deleteLater(); // 可能正处于该卡片自身的信号处理中，延迟删除
+}
+
+// 按变化的角色修补卡片，未变化的属性不触碰，避免重复 polish 和重绘
+void AppStatusBar::updateCard(int row, const QList<int>& roles) {
+    if (!m_model || row < 0 || row >= m_cardWidgets.size()) return;
+    QPushButton* btn = m_cardWidgets.at(row);
+    const AppStatus status = m_model->getStatus(row);
+    const bool all = roles.isEmpty();
+    auto changed = [&](int role) { return all || roles.contains(role); };
+
+    if (changed(Qt::DisplayRole)) {
         btn->setText(status.appName);
+    }
+    if (changed(AppStatusModel::IconRole)) {
+        // 句柄由 AppStatusMonitor 异步解析，解析完成后会以 IconRole 变化再次到达这里
+        // 使用共享的 32px 预缩放变体，按钮绘制时无需再缩放
+        const QIcon icon = IconVariantStore::instance().icon(status.iconHandle, STATUS_ICON_SIZE, btn->devicePixelRatioF());
+        btn->setIcon(icon.isNull() ? placeholderIcon() : icon);
+    }
+    if (changed(AppStatusModel::StatusRole)) {
+        // 状态高亮：切换共享样式变体，仅在属性值真正变化时重新 polish
+        Theme::setVariant(btn, "appState", QByteArray(statusStyleKey(status.status)));
+    }
+    if (changed(Qt::DisplayRole) || changed(AppStatusModel::StatusRole) || changed(AppStatusModel::PidRole)) {
         btn->setToolTip(QString("%1\n状态：%2\nPID：%3")
             .arg(status.appName)
-            .arg([&]{
-                switch(status.status) {
-                    case AppRunStatus::NotRunning: return QStringLiteral("未启动");
-                    case AppRunStatus::Running: return QStringLiteral("运行中");
-                    case AppRunStatus::Minimized: return QStringLiteral("最小化");
-                    case AppRunStatus::Activated: return QStringLiteral("激活中");
-                    case AppRunStatus::Error: return QStringLiteral("异常");
-                }
-                return QStringLiteral("未知");
-            }())
+            .arg(statusText(status.status))
             .arg(status.pid));
-        // 状态高亮优化
-        if (status.status == AppRunStatus::Activated) {
-            // 激活中：高亮蓝色
-            btn->setStyleSheet("background:#cceeff;border:2px solid #3399cc;border-radius:8px;");
-        } else if (status.status == AppRunStatus::Minimized) {
-            // 最小化：淡黄色高亮
-            btn->setStyleSheet("background:#fff7cc;border:2px solid #e6c200;border-radius:8px;");
-        } else if (status.status == AppRunStatus::Running) {
-            // 运行中：淡蓝色
-            btn->setStyleSheet("background:#e6f2ff;border:1px solid #99c2e6;border-radius:8px;");
-        } else if (status.status == AppRunStatus::Error) {
-            // 异常：红色
-            btn->setStyleSheet("background:#ffe0e0;border:2px solid #cc3333;border-radius:8px;");
-        } else if (status.status == AppRunStatus::NotRunning) {
-            // 未启动：灰色
-            btn->setStyleSheet("background:#f0f0f0;color:#aaa;border:1px solid #ccc;border-radius:8px;");
-        }
-        // 点击信号：激活窗口
-        connect(btn, &QPushButton::clicked, this, [this, i, status]() {
-            if (status.hwnd && status.status != AppRunStatus::NotRunning) {
-                extern SystemInteractionModule* systemInteractionModule;
-                if (systemInteractionModule) {
-                    systemInteractionModule->activateWindow(status.hwnd);
-                }
-            }
-            emit appCardClicked(i);
-        });
-        // 右键菜单
-        btn->setContextMenuPolicy(Qt::CustomContextMenu);
-        connect(btn, &QPushButton::customContextMenuRequested, this, [this, i, status, btn](const QPoint& pos) {
-            QMenu menu;
-            QAction* actActivate = menu.addAction("激活窗口");
-            QAction* actClose = menu.addAction("关闭应用");
-            QAction* actRestart = menu.addAction("重启应用");
-            QAction* actDetail = menu.addAction("查看详情");
-            // 激活窗口
-            actActivate->setEnabled(status.hwnd && status.status != AppRunStatus::NotRunning);
-            // 关闭/重启仅运行中可用
-            actClose->setEnabled(status.pid != 0);
-            actRestart->setEnabled(status.pid != 0);
-            QAction* sel = menu.exec(btn->mapToGlobal(pos));
-            extern SystemInteractionModule* systemInteractionModule;
-            if (sel == actActivate && systemInteractionModule && status.hwnd) {
-                systemInteractionModule->activateWindow(status.hwnd);
-            } else if (sel == actClose && status.pid != 0) {
-                // 关闭进程
-                HANDLE hProc = OpenProcess(PROCESS_TERMINATE, FALSE, status.pid);
-                if (hProc) { TerminateProcess(hProc, 0); CloseHandle(hProc); }
-            } else if (sel == actRestart && status.pid != 0) {
-                // 关闭后重启
-                HANDLE hProc = OpenProcess(PROCESS_TERMINATE, FALSE, status.pid);
-                if (hProc) { TerminateProcess(hProc, 0); CloseHandle(hProc); }
-                QProcess::startDetached(status.exePath);
-            } else if (sel == actDetail) {
-                QString info = QString("应用名称：%1\n路径：%2\nPID：%3\n状态：%4")
-                    .arg(status.appName).arg(status.exePath).arg(status.pid)
-                    .arg([&]{
-                        switch(status.status) {
-                            case AppRunStatus::NotRunning: return QStringLiteral("未启动");
-                            case AppRunStatus::Running: return QStringLiteral("运行中");
-                            case AppRunStatus::Minimized: return QStringLiteral("最小化");
-                            case AppRunStatus::Activated: return QStringLiteral("激活中");
-                            case AppRunStatus::Error: return QStringLiteral("异常");
-                        }
-                        return QStringLiteral("未知");
-                    }());
-                QMessageBox::information(this, "应用详情", info);
-            }
-            emit appCardRightClicked(i, mapToGlobal(pos));
-        });
-        m_layout->addWidget(btn);
-        m_cardWidgets.append(btn);
     }
-    // 再加右侧弹性空间，保证居中
-    m_layout->addStretch();
-} 
\ No newline at end of file
+}
+
+void AppStatusBar::showCardContextMenu(QPushButton* btn, const QPoint& pos) {
+    const int row = m_cardWidgets.indexOf(btn);
+    if (row < 0 || !m_model) return;
+    const AppStatus status = m_model->getStatus(row);
+    QMenu menu;
+    QAction* actActivate = menu.addAction("激活窗口");
+    QAction* actClose = menu.addAction("关闭应用");
+    QAction* actRestart = menu.addAction("重启应用");
+    QAction* actDetail = menu.addAction("查看详情");
+    // 激活窗口
+    actActivate->setEnabled(status.hwnd && status.status != AppRunStatus::NotRunning);
+    // 关闭/重启仅运行中可用
+    actClose->setEnabled(status.pid != 0);
+    actRestart->setEnabled(status.pid != 0);
+    QAction* sel = menu.exec(btn->mapToGlobal(pos));
+    extern SystemInteractionModule* systemInteractionModule;
+    if (sel == actActivate && systemInteractionModule && status.hwnd) {
+        systemInteractionModule->activateWindow(status.hwnd);
+    } else if (sel == actClose && status.pid != 0) {
+        // 关闭进程
+        HANDLE hProc = OpenProcess(PROCESS_TERMINATE, FALSE, status.pid);
+        if (hProc) { TerminateProcess(hProc, 0); CloseHandle(hProc); }
+    } else if (sel == actRestart && status.pid != 0) {
+        // 关闭后重启
+        HANDLE hProc = OpenProcess(PROCESS_TERMINATE, FALSE, status.pid);
+        if (hProc) { TerminateProcess(hProc, 0); CloseHandle(hProc); }
+        QProcess::startDetached(status.exePath);
+    } else if (sel == actDetail) {
+        QString info = QString("应用名称：%1\n路径：%2\nPID：%3\n状态：%4")
+            .arg(status.appName).arg(status.exePath).arg(status.pid)
+            .arg(statusText(status.status));
+        QMessageBox::information(this, "应用详情", info);
+    }
+    emit appCardRightClicked(row, mapToGlobal(pos));
+}
+
+// ========== 模型增量信号 ========== //
+
+void AppStatusBar::onRowsInserted(const QModelIndex& parent, int first, int last) {
+    Q_UNUSED(parent);
+    for (int row = first; row <= last; ++row) {
+        QPushButton* card = createCard();
+        m_cardWidgets.insert(row, card);
+        m_layout->insertWidget(row + 1, card);
+        updateCard(row);
+    }
+}
+
+void AppStatusBar::onRowsRemoved(const QModelIndex& parent, int first, int last) {
+    Q_UNUSED(parent);
+    for (int row = last; row >= first && row < m_cardWidgets.size(); --row) {
+        removeCard(m_cardWidgets.takeAt(row));
+    }
+}
+
+void AppStatusBar::onRowsMoved(const QModelIndex& parent, int start, int end, const QModelIndex& destination, int row) {
+    Q_UNUSED(parent);
+    Q_UNUSED(destination);
+    const int count = end - start + 1;
+    // row 为移动前坐标系下的目标位置，向下移动时需扣除被移走的行数
+    const int target = row > start ? row - count : row;
+    QList<QPushButton*> moved = m_cardWidgets.mid(start, count);
+    m_cardWidgets.remove(start, count);
+    for (QPushButton* card : moved) {
+        m_layout->removeWidget(card);
+    }
+    for (int i = 0; i < moved.size(); ++i) {
+        m_cardWidgets.insert(target + i, moved.at(i));
+        m_layout->insertWidget(target + i + 1, moved.at(i));
+    }
+}
+
+void AppStatusBar::onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles) {
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        updateCard(row, roles);
+    }
+}
@@ -1,11 +1,14 @@
 #pragma once
 #include <QWidget>
 #include <QHBoxLayout>
+#include <QPushButton>
 #include "AppStatusModel.h"
 
 // =============================
 // 应用状态栏控件
 // =============================
+// 每个应用对应一个常驻卡片（QPushButton），随模型的增删/移动/数据变化增量更新，
+// 不再每次刷新时销毁重建；状态配色由 UserView.qss 中按 appState 属性区分的共享样式提供。
 class AppStatusBar : public QWidget {
     Q_OBJECT
 public:
@@ -20,11 +23,26 @@ signals:
     void appCardRightClicked(int index, const QPoint& globalPos);
 
 protected:
-    // 监听模型变化，刷新UI
+    // 与模型整体同步（绑定模型或模型重置时），复用已有卡片
     void refreshCards();
 
 private:
+    QPushButton* createCard();
+    void removeCard(QPushButton* card);
+    /**
+     * @brief 按变化的角色修补单个卡片
+     * @param row 模型行号
+     * @param roles 变化的角色，空列表表示全部刷新
+     */
+    void updateCard(int row, const QList<int>& roles = QList<int>());
+    void showCardContextMenu(QPushButton* card, const QPoint& pos);
+
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
+    void onRowsRemoved(const QModelIndex& parent, int first, int last);
+    void onRowsMoved(const QModelIndex& parent, int start, int end, const QModelIndex& destination, int row);
+    void onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles);
+
     AppStatusModel* m_model;           // 数据模型
-    QHBoxLayout* m_layout;             // 横向布局
-    QList<QWidget*> m_cardWidgets;     // 当前所有卡片控件
-}; 
\ No newline at end of file
+    QHBoxLayout* m_layout;             // 横向布局（首尾各一个弹性空间，卡片位于 row + 1）
+    QList<QPushButton*> m_cardWidgets; // 当前所有卡片控件，顺序与模型行一致
+};
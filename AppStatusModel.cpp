@@ -1,5 +1,30 @@
 #include "AppStatusModel.h"
+#include "LogCategories.h"
+#include "Trace.h"
 #include <QVariant>
+#include <QSet>
+#include <QDebug>
+
+// 每隔多少次刷新输出一次统计日志
+static const quint64 REFRESH_STATS_LOG_INTERVAL = 300;
+
+// 比较同一应用的新旧状态，返回发生变化的角色
+// lastActive 只是轮询时间戳（有窗口时每次刷新都会更新），且没有视图展示它，不单独触发通知；
+static QList<int> changedRoles(const AppStatus& oldStatus, const AppStatus& newStatus)
+{
+    QList<int> roles;
+    if (oldStatus.appName != newStatus.appName)
+        roles << Qt::DisplayRole;
+    if (oldStatus.iconHandle != newStatus.iconHandle)
+        roles << AppStatusModel::IconRole;
+    if (oldStatus.status != newStatus.status)
+        roles << AppStatusModel::StatusRole;
+    if (oldStatus.pid != newStatus.pid)
+        roles << AppStatusModel::PidRole;
+    if (oldStatus.hwnd != newStatus.hwnd)
+        roles << AppStatusModel::HwndRole;
+    return roles;
+}
 
 // 构造函数
 AppStatusModel::AppStatusModel(QObject* parent)
@@ -21,17 +46,17 @@ QVariant AppStatusModel::data(const QModelIndex& index, int role) const {
     switch (role) {
     case Qt::DisplayRole:
         return status.appName;
-    case Qt::UserRole:
+    case ExePathRole:
         return status.exePath;
-    case Qt::UserRole + 1:
-        return QVariant::fromValue(status.icon);
-    case Qt::UserRole + 2:
+    case IconRole:
+        return QVariant::fromValue(IconRegistry::instance().icon(status.iconHandle));
+    case StatusRole:
         return static_cast<int>(status.status);
-    case Qt::UserRole + 3:
+    case PidRole:
         return static_cast<quint32>(status.pid);
-    case Qt::UserRole + 4:
+    case HwndRole:
         return reinterpret_cast<quintptr>(status.hwnd);
-    case Qt::UserRole + 5:
+    case LastActiveRole:
         return status.lastActive;
     default:
         return QVariant();
@@ -42,21 +67,102 @@ QVariant AppStatusModel::data(const QModelIndex& index, int role) const {
 QHash<int, QByteArray> AppStatusModel::roleNames() const {
     QHash<int, QByteArray> roles;
     roles[Qt::DisplayRole] = "appName";
-    roles[Qt::UserRole] = "exePath";
-    roles[Qt::UserRole + 1] = "icon";
-    roles[Qt::UserRole + 2] = "status";
-    roles[Qt::UserRole + 3] = "pid";
-    roles[Qt::UserRole + 4] = "hwnd";
-    roles[Qt::UserRole + 5] = "lastActive";
+    roles[ExePathRole] = "exePath";
+    roles[IconRole] = "icon";
+    roles[StatusRole] = "status";
+    roles[PidRole] = "pid";
+    roles[HwndRole] = "hwnd";
+    roles[LastActiveRole] = "lastActive";
     return roles;
 }
 
 // 批量刷新所有应用状态
 void AppStatusModel::updateStatus(const QList<AppStatus>& statusList) {
-    beginResetModel();
-    m_statusList = statusList;
-    endResetModel();
-    emit statusChanged();
+    Trace::Span span("model.refresh");
+    span.attr("rows", statusList.size());
+    ++m_refreshCount;
+    bool changed = false;
+
+    // 1. 移除新列表中已不存在的应用（白名单删除）
+    QSet<QString> incomingPaths;
+    incomingPaths.reserve(statusList.size());
+    for (const AppStatus& status : statusList) {
+        incomingPaths.insert(status.exePath);
+    }
+    for (int row = m_statusList.size() - 1; row >= 0; --row) {
+        if (!incomingPaths.contains(m_statusList.at(row).exePath)) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_statusList.removeAt(row);
+            endRemoveRows();
+            changed = true;
+        }
+    }
+
+    // 2. 按新顺序逐行对齐：新增行插入、换位行移动、已有行只比较字段
+    for (int row = 0; row < statusList.size(); ++row) {
+        const AppStatus& incoming = statusList.at(row);
+        const int current = indexOfPath(incoming.exePath, row);
+        if (current < 0) {
+            beginInsertRows(QModelIndex(), row, row);
+            m_statusList.insert(row, incoming);
+            endInsertRows();
+            changed = true;
+            continue;
+        }
+        if (current != row) {
+            beginMoveRows(QModelIndex(), current, current, QModelIndex(), row);
+            m_statusList.move(current, row);
+            endMoveRows();
+            changed = true;
+        }
+        const QList<int> roles = changedRoles(m_statusList.at(row), incoming);
+        m_statusList[row] = incoming;
+        if (!roles.isEmpty()) {
+            const QModelIndex idx = index(row);
+            emit dataChanged(idx, idx, roles);
+            changed = true;
+        }
+    }
+
+    // 3. 白名单中存在重复路径时，多余的尾部行在这里清掉
+    if (m_statusList.size() > statusList.size()) {
+        beginRemoveRows(QModelIndex(), statusList.size(), m_statusList.size() - 1);
+        m_statusList.erase(m_statusList.begin() + statusList.size(), m_statusList.end());
+        endRemoveRows();
+        changed = true;
+    }
+
+    span.attr("changed", changed);
+    if (changed) {
+        emit statusChanged();
+    } else {
+        ++m_noopRefreshCount;
+    }
+    if (m_refreshCount % REFRESH_STATS_LOG_INTERVAL == 0) {
+        qCDebug(lcMonitor) << "[AppStatusModel] 状态刷新" << m_refreshCount << "次，其中无变化" << m_noopRefreshCount << "次";
+    }
+}
+
+// 更新单个应用状态
+void AppStatusModel::updateAppStatus(const AppStatus& status) {
+    const int row = indexOfPath(status.exePath, 0);
+    if (row < 0) return;
+    const QList<int> roles = changedRoles(m_statusList.at(row), status);
+    m_statusList[row] = status;
+    if (!roles.isEmpty()) {
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, roles);
+        emit statusChanged();
+    }
+}
+
+// 从 from 行开始查找 exePath 所在行，找不到返回 -1
+int AppStatusModel::indexOfPath(const QString& exePath, int from) const {
+    for (int row = from; row < m_statusList.size(); ++row) {
+        if (m_statusList.at(row).exePath == exePath)
+            return row;
+    }
+    return -1;
 }
 
 // 获取单个应用状态
@@ -75,7 +181,10 @@ QList<AppStatus> AppStatusModel::getAllStatus() const {
 void AppStatusModel::setActiveApp(const QString& appPath)
 {
     bool found = false;
-    for (AppStatus& status : m_statusList) {
+    bool changed = false;
+    for (int row = 0; row < m_statusList.size(); ++row) {
+        AppStatus& status = m_statusList[row];
+        const AppRunStatus previous = status.status;
         if (status.exePath == appPath) {
             status.status = AppRunStatus::Activated;
             found = true;
@@ -94,6 +203,13 @@ void AppStatusModel::setActiveApp(const QString& appPath)
                 }
             }
         }
+        if (status.status != previous) {
+            const QModelIndex idx = index(row);
+            emit dataChanged(idx, idx, {StatusRole});
+            changed = true;
+        }
+    }
+    if (changed) {
+        emit statusChanged();
     }
-    emit statusChanged();
 } 
\ No newline at end of file
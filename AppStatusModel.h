@@ -9,6 +9,16 @@
 class AppStatusModel : public QAbstractListModel {
     Q_OBJECT
 public:
+    // 自定义数据角色（与 roleNames() 一一对应）
+    enum Roles {
+        ExePathRole = Qt::UserRole,
+        IconRole,
+        StatusRole,
+        PidRole,
+        HwndRole,
+        LastActiveRole
+    };
+
     explicit AppStatusModel(QObject* parent = nullptr);
     // 获取行数
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -17,8 +27,17 @@ public:
     // 获取所有支持的角色
     QHash<int, QByteArray> roleNames() const override;
 
-    // 批量刷新所有应用状态
+    /**
+     * @brief 批量刷新所有应用状态
+     * 按 exePath 与当前行逐行比对：新增/移除/换位分别发出 insert/remove/move 信号，
+     * 已有行只对变化的角色发出 dataChanged；全无变化时不发出任何信号。
+     */
     void updateStatus(const QList<AppStatus>& statusList);
+    /**
+     * @brief 更新单个应用的状态（来自 AppStatusMonitor 的推送）
+     * 按 exePath 定位行，只对变化的角色发出 dataChanged；找不到对应行时忽略。
+     */
+    void updateAppStatus(const AppStatus& status);
     // 获取单个应用状态
     AppStatus getStatus(int row) const;
     // 获取全部应用状态
@@ -27,10 +46,18 @@ public:
     // 新增：设置某个应用为激活状态
     void setActiveApp(const QString& appPath);
 
+    // 刷新统计：updateStatus 总调用次数 / 其中无任何变化的次数
+    quint64 refreshCount() const { return m_refreshCount; }
+    quint64 noopRefreshCount() const { return m_noopRefreshCount; }
+
 signals:
     // 状态变更信号，供UI层自动刷新
     void statusChanged();
 
 private:
+    int indexOfPath(const QString& exePath, int from) const;
+
     QList<AppStatus> m_statusList; // 当前所有应用状态
+    quint64 m_refreshCount = 0;
+    quint64 m_noopRefreshCount = 0;
 }; 
\ No newline at end of file
@@ -0,0 +1,451 @@
+#include "AppStatusMonitor.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include "SystemInteractionModule.h"
+#include <QDebug>
+#include <QDateTime>
+#include <QFileInfo>
+#include <TlHelp32.h>
+
+// 兜底全量校准间隔：覆盖无窗口进程启动等收不到窗口事件的情况
+static const int STATUS_RESYNC_INTERVAL_MS = 30000;
+// 发起启动后匹配新进程的时间点（相对上一次）：覆盖 CreateProcess、启动器转交和较慢的冷启动
+static const int PROCESS_START_PROBE_DELAYS_MS[] = { 300, 1000, 3000, 8000 };
+
+AppStatusMonitor* AppStatusMonitor::s_instance = nullptr;
+
+AppStatusMonitor::AppStatusMonitor(QObject* parent)
+    : QObject(parent)
+    , m_resyncTimer(new QTimer(this))
+    , m_probeTimer(new QTimer(this))
+{
+    s_instance = this;
+    installWinEventHooks();
+    m_resyncTimer->setInterval(STATUS_RESYNC_INTERVAL_MS);
+    connect(m_resyncTimer, &QTimer::timeout, this, [this]() { resync(true); });
+    m_resyncTimer->start();
+    m_probeTimer->setSingleShot(true);
+    connect(m_probeTimer, &QTimer::timeout, this, &AppStatusMonitor::probeNewProcesses);
+}
+
+AppStatusMonitor::~AppStatusMonitor()
+{
+    uninstallWinEventHooks();
+    for (WatchedApp& app : m_apps) {
+        detachProcess(app);
+    }
+    clearIgnoredProcesses();
+    if (s_instance == this) {
+        s_instance = nullptr;
+    }
+}
+
+void AppStatusMonitor::setWatchedApps(const QList<AppInfo>& apps)
+{
+    for (WatchedApp& app : m_apps) {
+        detachProcess(app);
+    }
+    m_apps.clear();
+    clearIgnoredProcesses(); // 白名单变化后原先无关的进程可能变为匹配
+    m_apps.reserve(apps.size());
+    for (const AppInfo& info : apps) {
+        WatchedApp app;
+        app.info = info;
+        const QString exePath = !info.exePath.isEmpty() ? info.exePath : info.path;
+        // 优先用mainExecutableHint匹配进程，否则用可执行文件名
+        app.processName = (!info.mainExecutableHint.isEmpty() ? info.mainExecutableHint
+                                                             : QFileInfo(exePath).fileName()).toLower();
+        app.status.appName = info.name;
+        app.status.exePath = exePath;
+        app.status.iconHandle = InvalidIconHandle; // 由 requestIcon 异步填充
+        app.status.status = AppRunStatus::NotRunning;
+        app.status.pid = 0;
+        app.status.hwnd = nullptr;
+        m_apps.append(app);
+    }
+    for (int i = 0; i < m_apps.size(); ++i) {
+        requestIcon(i);
+    }
+    resync(false);
+    qCDebug(lcMonitor) << "[AppStatusMonitor] 监视应用数量:" << m_apps.size();
+    emit statusTableReset(currentStatus());
+}
+
+// 已解析的图标直接填入；否则在提取完成后按路径找回应用并发布变化（期间白名单可能已被替换）
+void AppStatusMonitor::requestIcon(int index)
+{
+    const QString exePath = m_apps[index].status.exePath;
+    QFuture<IconHandle> future = IconRegistry::instance().acquireAsync(exePath);
+    if (future.isFinished()) {
+        m_apps[index].status.iconHandle = future.result();
+        return;
+    }
+    future.then(this, [this, exePath](IconHandle handle) {
+        for (int i = 0; i < m_apps.size(); ++i) {
+            if (m_apps[i].status.exePath == exePath) {
+                m_apps[i].status.iconHandle = handle;
+                evaluate(i, false, true);
+            }
+        }
+    });
+}
+
+QList<AppStatus> AppStatusMonitor::currentStatus() const
+{
+    QList<AppStatus> result;
+    result.reserve(m_apps.size());
+    for (const WatchedApp& app : m_apps) {
+        result.append(app.status);
+    }
+    return result;
+}
+
+void AppStatusMonitor::expectProcessStart()
+{
+    m_probeStep = 0;
+    m_probeTimer->start(PROCESS_START_PROBE_DELAYS_MS[0]);
+}
+
+// ========== 窗口事件 ========== //
+
+void AppStatusMonitor::installWinEventHooks()
+{
+    // 回调在本线程的消息循环中投递（WINEVENT_OUTOFCONTEXT），无需额外线程
+    const DWORD flags = WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS;
+    const DWORD ranges[][3] = {
+        // 本程序回到前台时也要降级之前激活的应用，因此前台切换不跳过本进程
+        { EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, WINEVENT_OUTOFCONTEXT },
+        { EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND, flags },
+        { EVENT_OBJECT_DESTROY, EVENT_OBJECT_HIDE, flags }, // DESTROY / SHOW / HIDE
+    };
+    for (const auto& range : ranges) {
+        HWINEVENTHOOK hook = SetWinEventHook(range[0], range[1], nullptr, WinEventProc, 0, 0, range[2]);
+        if (hook) {
+            m_winEventHooks.append(hook);
+        } else {
+            qCWarning(lcMonitor) << "[AppStatusMonitor] SetWinEventHook 失败，事件范围:" << Qt::hex << range[0] << range[1]
+                       << "错误码:" << Qt::dec << GetLastError();
+        }
+    }
+}
+
+void AppStatusMonitor::uninstallWinEventHooks()
+{
+    for (HWINEVENTHOOK hook : m_winEventHooks) {
+        UnhookWinEvent(hook);
+    }
+    m_winEventHooks.clear();
+}
+
+void CALLBACK AppStatusMonitor::WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                             LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+{
+    Q_UNUSED(hook);
+    Q_UNUSED(eventThread);
+    Q_UNUSED(eventTime);
+    if (!s_instance || !hwnd || idObject != OBJID_WINDOW || idChild != CHILDID_SELF) {
+        return;
+    }
+    s_instance->handleWindowEvent(event, hwnd);
+}
+
+void AppStatusMonitor::handleWindowEvent(DWORD event, HWND hwnd)
+{
+    if (event == EVENT_OBJECT_DESTROY || event == EVENT_OBJECT_HIDE) {
+        // 窗口已销毁时取不到所属进程，只能按已记录的主窗口句柄匹配
+        for (int i = 0; i < m_apps.size(); ++i) {
+            if (m_apps.at(i).status.hwnd == hwnd) {
+                evaluate(i, true, true);
+            }
+        }
+        return;
+    }
+    if (event == EVENT_OBJECT_SHOW && GetAncestor(hwnd, GA_ROOT) != hwnd) {
+        return; // 只关心顶层窗口
+    }
+
+    DWORD pid = 0;
+    GetWindowThreadProcessId(hwnd, &pid);
+    if (pid == GetCurrentProcessId()) {
+        pid = 0; // 本程序的窗口（只有前台切换会收到）：不属于任何应用，只做降级
+    }
+    int index = appIndexForPid(pid);
+    if (index < 0 && event == EVENT_OBJECT_SHOW) {
+        index = matchNewProcess(pid);
+    }
+
+    if (event == EVENT_SYSTEM_FOREGROUND) {
+        // 前台切换：之前处于激活状态的应用需要降级
+        for (int i = 0; i < m_apps.size(); ++i) {
+            if (i != index && m_apps.at(i).status.status == AppRunStatus::Activated) {
+                evaluate(i, false, true);
+            }
+        }
+    }
+    if (index >= 0) {
+        // 枚举窗口（findMainWindowForProcessWithScore）只在主窗口尚未找到或已失效时进行
+        const HWND mainWindow = m_apps.at(index).status.hwnd;
+        const bool mainWindowValid = mainWindow && IsWindow(mainWindow);
+        if (event == EVENT_OBJECT_SHOW && mainWindowValid && hwnd != mainWindow) {
+            return; // 同一进程的提示框、菜单、启动画面等显示：主窗口与状态都不变
+        }
+        evaluate(index, !mainWindowValid, true);
+    }
+}
+
+// ========== 进程跟踪 ========== //
+
+int AppStatusMonitor::appIndexForPid(DWORD pid) const
+{
+    if (pid == 0) return -1;
+    for (int i = 0; i < m_apps.size(); ++i) {
+        if (m_apps.at(i).status.pid == pid) return i;
+    }
+    return -1;
+}
+
+// 未知进程首次出现顶层窗口时，按映像名匹配尚未运行的白名单应用
+int AppStatusMonitor::matchNewProcess(DWORD pid)
+{
+    if (pid == 0 || m_ignoredProcesses.contains(pid)) return -1;
+    const QString name = processNameForPid(pid);
+    if (!name.isEmpty()) {
+        for (int i = 0; i < m_apps.size(); ++i) {
+            WatchedApp& app = m_apps[i];
+            if (app.status.pid == 0 && app.processName == name) {
+                attachProcess(app, pid);
+                return i;
+            }
+        }
+    }
+    ignoreProcess(pid);
+    return -1;
+}
+
+void AppStatusMonitor::ignoreProcess(DWORD pid)
+{
+    IgnoredProcess ignored;
+    ignored.processHandle = OpenProcess(SYNCHRONIZE, FALSE, pid);
+    if (!ignored.processHandle) {
+        return;
+    }
+    if (!RegisterWaitForSingleObject(&ignored.waitHandle, ignored.processHandle, IgnoredProcessExitCallback,
+                                     reinterpret_cast<PVOID>(static_cast<quintptr>(pid)),
+                                     INFINITE, WT_EXECUTEONLYONCE)) {
+        CloseHandle(ignored.processHandle);
+        return;
+    }
+    m_ignoredProcesses.insert(pid, ignored);
+}
+
+void AppStatusMonitor::forgetIgnoredProcess(DWORD pid)
+{
+    const auto it = m_ignoredProcesses.find(pid);
+    if (it == m_ignoredProcesses.end()) return;
+    UnregisterWaitEx(it->waitHandle, INVALID_HANDLE_VALUE);
+    CloseHandle(it->processHandle);
+    m_ignoredProcesses.erase(it);
+}
+
+void AppStatusMonitor::clearIgnoredProcesses()
+{
+    for (const IgnoredProcess& ignored : qAsConst(m_ignoredProcesses)) {
+        UnregisterWaitEx(ignored.waitHandle, INVALID_HANDLE_VALUE);
+        CloseHandle(ignored.processHandle);
+    }
+    m_ignoredProcesses.clear();
+}
+
+void AppStatusMonitor::attachProcess(WatchedApp& app, DWORD pid)
+{
+    detachProcess(app);
+    forgetIgnoredProcess(pid); // 快照匹配到的进程可能在其退出通知送达前被复用了 PID
+    app.status.pid = pid;
+    app.processHandle = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!app.processHandle) {
+        qCWarning(lcMonitor) << "[AppStatusMonitor] OpenProcess 失败，PID:" << pid << "错误码:" << GetLastError()
+                   << "，该进程退出将由定时校准发现。";
+        return;
+    }
+    if (!RegisterWaitForSingleObject(&app.waitHandle, app.processHandle, ProcessExitCallback,
+                                     reinterpret_cast<PVOID>(static_cast<quintptr>(pid)),
+                                     INFINITE, WT_EXECUTEONLYONCE)) {
+        qCWarning(lcMonitor) << "[AppStatusMonitor] RegisterWaitForSingleObject 失败，PID:" << pid << "错误码:" << GetLastError();
+        app.waitHandle = nullptr;
+    }
+}
+
+void AppStatusMonitor::detachProcess(WatchedApp& app)
+{
+    if (app.waitHandle) {
+        // INVALID_HANDLE_VALUE：等待正在执行的回调结束后再返回，保证之后不会再访问本对象
+        UnregisterWaitEx(app.waitHandle, INVALID_HANDLE_VALUE);
+        app.waitHandle = nullptr;
+    }
+    if (app.processHandle) {
+        CloseHandle(app.processHandle);
+        app.processHandle = nullptr;
+    }
+    app.status.pid = 0;
+}
+
+// 线程池回调：只把事件转回监视器所在线程处理
+void CALLBACK AppStatusMonitor::ProcessExitCallback(PVOID context, BOOLEAN timedOut)
+{
+    Q_UNUSED(timedOut);
+    const DWORD pid = static_cast<DWORD>(reinterpret_cast<quintptr>(context));
+    if (AppStatusMonitor* monitor = s_instance) {
+        QMetaObject::invokeMethod(monitor, [monitor, pid]() { monitor->onProcessExited(pid); }, Qt::QueuedConnection);
+    }
+}
+
+void CALLBACK AppStatusMonitor::IgnoredProcessExitCallback(PVOID context, BOOLEAN timedOut)
+{
+    Q_UNUSED(timedOut);
+    const DWORD pid = static_cast<DWORD>(reinterpret_cast<quintptr>(context));
+    if (AppStatusMonitor* monitor = s_instance) {
+        QMetaObject::invokeMethod(monitor, [monitor, pid]() { monitor->forgetIgnoredProcess(pid); }, Qt::QueuedConnection);
+    }
+}
+
+void AppStatusMonitor::onProcessExited(DWORD pid)
+{
+    const int index = appIndexForPid(pid);
+    if (index < 0) return;
+    WatchedApp& app = m_apps[index];
+    detachProcess(app);
+    app.status.hwnd = nullptr;
+    // 同名进程可能还有其它实例在运行
+    const DWORD otherPid = snapshotProcesses().value(app.processName, 0);
+    if (otherPid != 0) {
+        attachProcess(app, otherPid);
+    }
+    evaluate(index, true, true);
+}
+
+void AppStatusMonitor::resync(bool notify)
+{
+    Trace::Span span("monitor.resync");
+    span.attr("apps", m_apps.size());
+    const QHash<QString, DWORD> processes = snapshotProcesses();
+    for (int i = 0; i < m_apps.size(); ++i) {
+        WatchedApp& app = m_apps[i];
+        const DWORD pid = processes.value(app.processName, 0);
+        const bool pidChanged = pid != app.status.pid;
+        if (pidChanged) {
+            if (pid != 0) {
+                attachProcess(app, pid);
+            } else {
+                detachProcess(app);
+            }
+        }
+        // 定时校准时主窗口句柄仍有效就不再枚举窗口
+        evaluate(i, pidChanged || !notify, notify);
+    }
+}
+
+void AppStatusMonitor::probeNewProcesses()
+{
+    QHash<QString, DWORD> processes;
+    bool snapshotTaken = false;
+    bool pending = false;
+    for (int i = 0; i < m_apps.size(); ++i) {
+        WatchedApp& app = m_apps[i];
+        if (app.status.pid != 0) continue;
+        if (!snapshotTaken) {
+            processes = snapshotProcesses(); // 全部应用都在运行时不做快照
+            snapshotTaken = true;
+        }
+        const DWORD pid = processes.value(app.processName, 0);
+        if (pid == 0) {
+            pending = true;
+            continue;
+        }
+        attachProcess(app, pid);
+        evaluate(i, true, true);
+    }
+    const int stepCount = int(sizeof(PROCESS_START_PROBE_DELAYS_MS) / sizeof(PROCESS_START_PROBE_DELAYS_MS[0]));
+    if (pending && ++m_probeStep < stepCount) {
+        m_probeTimer->start(PROCESS_START_PROBE_DELAYS_MS[m_probeStep]);
+    }
+}
+
+void AppStatusMonitor::evaluate(int index, bool refindWindow, bool notify)
+{
+    WatchedApp& app = m_apps[index];
+    AppStatus next = app.status;
+    if (next.pid == 0) {
+        next.hwnd = nullptr;
+        next.status = AppRunStatus::NotRunning;
+    } else {
+        if (refindWindow || !next.hwnd || !IsWindow(next.hwnd)) {
+            next.hwnd = SystemInteractionModule::findMainWindowForProcessWithScore(next.pid, app.info.windowFindingHints).first;
+        }
+        if (next.hwnd) {
+            DWORD foregroundPid = 0;
+            GetWindowThreadProcessId(GetForegroundWindow(), &foregroundPid);
+            // 判断窗口是否最小化、激活
+            if (IsIconic(next.hwnd)) {
+                next.status = AppRunStatus::Minimized;
+            } else if (foregroundPid == next.pid) {
+                next.status = AppRunStatus::Activated;
+            } else {
+                next.status = AppRunStatus::Running;
+            }
+            next.lastActive = QDateTime::currentDateTime();
+        } else {
+            next.status = AppRunStatus::Running; // 无窗口，纯进程
+        }
+    }
+
+    app.status = next;
+    if (!notify) {
+        app.reported = next; // 由调用方整表发布
+        return;
+    }
+    const bool changed = next.status != app.reported.status || next.hwnd != app.reported.hwnd
+                         || next.pid != app.reported.pid || next.iconHandle != app.reported.iconHandle;
+    if (changed) {
+        app.reported = next;
+        emit appStatusChanged(next);
+    }
+}
+
+// 一次快照建立 小写映像名 -> PID 映射
+QHash<QString, DWORD> AppStatusMonitor::snapshotProcesses()
+{
+    Trace::Span span("process.snapshot");
+    QHash<QString, DWORD> result;
+    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (hSnapshot == INVALID_HANDLE_VALUE) {
+        qCWarning(lcMonitor) << "[AppStatusMonitor] CreateToolhelp32Snapshot 失败，错误码:" << GetLastError();
+        return result;
+    }
+    PROCESSENTRY32W pe32;
+    pe32.dwSize = sizeof(PROCESSENTRY32W);
+    if (Process32FirstW(hSnapshot, &pe32)) {
+        do {
+            const QString name = QString::fromWCharArray(pe32.szExeFile).toLower();
+            if (!result.contains(name)) {
+                result.insert(name, pe32.th32ProcessID);
+            }
+        } while (Process32NextW(hSnapshot, &pe32));
+    }
+    CloseHandle(hSnapshot);
+    span.attr("processes", result.size());
+    return result;
+}
+
+QString AppStatusMonitor::processNameForPid(DWORD pid)
+{
+    HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProc) return QString();
+    wchar_t path[MAX_PATH] = {0};
+    DWORD size = MAX_PATH;
+    QString name;
+    if (QueryFullProcessImageNameW(hProc, 0, path, &size)) {
+        name = QFileInfo(QString::fromWCharArray(path, size)).fileName().toLower();
+    }
+    CloseHandle(hProc);
+    return name;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QTimer>
+#include <windows.h>
+#include "AppStatus.h"
+#include "common_types.h"
+
+// =============================
+// 应用状态监视器
+// =============================
+// 以事件驱动的方式维护白名单应用的状态表，取代对所有应用的定时轮询：
+// - 窗口事件（前台切换、最小化/还原、窗口显示/隐藏/销毁）通过 SetWinEventHook 获取；
+//   前台切换也接收本进程的窗口，回到 Dock 时之前激活的应用立即降级；
+// - 进程退出通过 RegisterWaitForSingleObject 等待进程句柄获取；
+// - 新进程在其首个顶层窗口显示时按映像名匹配到白名单应用；
+//   发起启动后（expectProcessStart）再按递增间隔做几次进程快照匹配，覆盖托盘、控制台等没有窗口或窗口出现较晚的程序；
+// - 匹配不上的进程记入忽略表，直到该进程退出，PID 被复用后会重新匹配；
+// - 只有主窗口尚未找到或已失效时才枚举窗口，同一进程的提示框、菜单等窗口显示不会触发枚举。
+// 只有受事件影响的应用会被重新评估，状态真正变化时才发出 appStatusChanged。
+// 另有一个低频全量校准作为兜底（例如在本程序之外启动的无窗口进程）。
+class AppStatusMonitor : public QObject {
+    Q_OBJECT
+public:
+    explicit AppStatusMonitor(QObject* parent = nullptr);
+    ~AppStatusMonitor();
+
+    /**
+     * @brief 设置需要监视的白名单应用，立即全量扫描一次并发出 statusTableReset
+     * @param apps 白名单应用列表
+     */
+    void setWatchedApps(const QList<AppInfo>& apps);
+    // 获取当前状态表（顺序与白名单一致）
+    QList<AppStatus> currentStatus() const;
+    // 即将启动白名单应用：随后数秒内按递增间隔匹配新进程，不必等待其窗口或定时校准
+    void expectProcessStart();
+
+signals:
+    // 单个应用状态发生变化
+    void appStatusChanged(const AppStatus& status);
+    // 白名单变化后整表重建
+    void statusTableReset(const QList<AppStatus>& statusList);
+
+private:
+    struct WatchedApp {
+        AppInfo info;
+        QString processName;             // 小写映像名，用于匹配进程
+        AppStatus status;                // 最新评估结果
+        AppStatus reported;              // 最近一次发布给订阅者的状态
+        HANDLE processHandle = nullptr;  // 被等待的进程句柄
+        HANDLE waitHandle = nullptr;     // RegisterWaitForSingleObject 返回的等待句柄
+    };
+    // 已确认与白名单无关、等待其退出的进程
+    struct IgnoredProcess {
+        HANDLE processHandle = nullptr;
+        HANDLE waitHandle = nullptr;
+    };
+
+    static void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                      LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime);
+    static void CALLBACK ProcessExitCallback(PVOID context, BOOLEAN timedOut);
+    static void CALLBACK IgnoredProcessExitCallback(PVOID context, BOOLEAN timedOut);
+
+    void installWinEventHooks();
+    void uninstallWinEventHooks();
+    void handleWindowEvent(DWORD event, HWND hwnd);
+    void onProcessExited(DWORD pid);
+    // 全量校准：一次进程快照匹配所有应用
+    void resync(bool notify);
+    // 启动后的快照匹配：只处理尚未运行的应用，仍有未匹配的则按下一个间隔再试
+    void probeNewProcesses();
+
+    int appIndexForPid(DWORD pid) const;
+    int matchNewProcess(DWORD pid);
+    void attachProcess(WatchedApp& app, DWORD pid);
+    void detachProcess(WatchedApp& app);
+    // 记入忽略表并等待进程退出；无法打开进程时不记录（下次同样无法查询映像名，代价很低）
+    void ignoreProcess(DWORD pid);
+    void forgetIgnoredProcess(DWORD pid);
+    void clearIgnoredProcesses();
+    // 异步获取应用图标句柄，完成后作为状态变化发布
+    void requestIcon(int index);
+    /**
+     * @brief 重新评估单个应用的状态
+     * @param index 应用下标
+     * @param refindWindow 是否重新查找主窗口（否则沿用仍然有效的窗口句柄）
+     * @param notify 状态变化时是否发出 appStatusChanged
+     */
+    void evaluate(int index, bool refindWindow, bool notify);
+
+    static QHash<QString, DWORD> snapshotProcesses();
+    static QString processNameForPid(DWORD pid);
+
+    static AppStatusMonitor* s_instance; // 供静态回调转发
+    QList<WatchedApp> m_apps;
+    QHash<DWORD, IgnoredProcess> m_ignoredProcesses; // 已确认与白名单无关的进程，退出时移除
+    QList<HWINEVENTHOOK> m_winEventHooks;
+    QTimer* m_resyncTimer;
+    QTimer* m_probeTimer;                 // 单次触发，驱动启动后的快照匹配
+    int m_probeStep = 0;
+};
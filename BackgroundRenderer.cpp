@@ -0,0 +1,126 @@
+#include "BackgroundRenderer.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include <QEvent>
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QPainter>
+#include <QWidget>
+#include <QtConcurrent>
+
+// 同一路径的背景图只解码一次，结果在各视图间共享（仅在 GUI 线程访问）
+static QFuture<QImage> decodedImage(const QString& path)
+{
+    static QHash<QString, QFuture<QImage>> s_decoded;
+    const auto it = s_decoded.constFind(path);
+    if (it != s_decoded.constEnd()) {
+        return *it;
+    }
+    QFuture<QImage> future = QtConcurrent::run([path]() {
+        Trace::Span span("ui.background.decode");
+        const QImage image(path);
+        if (image.isNull()) {
+            qCWarning(lcUi) << "[BackgroundRenderer] 无法加载背景图片:" << path;
+        }
+        return image;
+    });
+    s_decoded.insert(path, future);
+    return future;
+}
+
+// 拉伸铺满 size（设备像素），带透明通道的图片先与底色合成，结果始终不透明
+static QImage scaleBackground(const QImage& source, const QSize& size, const QColor& fillColor)
+{
+    Trace::Span span("ui.background.scale");
+    span.attr("width", size.width());
+    span.attr("height", size.height());
+    if (source.isNull()) {
+        QImage canvas(size, QImage::Format_RGB32);
+        canvas.fill(fillColor);
+        return canvas;
+    }
+    const QImage scaled = source.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    if (!scaled.hasAlphaChannel()) {
+        return scaled.convertToFormat(QImage::Format_RGB32);
+    }
+    QImage canvas(size, QImage::Format_RGB32);
+    canvas.fill(fillColor);
+    QPainter painter(&canvas);
+    painter.drawImage(0, 0, scaled);
+    painter.end();
+    return canvas;
+}
+
+BackgroundRenderer::BackgroundRenderer(QWidget* target, const QColor& fallbackColor)
+    : QObject(target)
+    , m_target(target)
+    , m_fallbackColor(fallbackColor)
+{
+    m_target->setAttribute(Qt::WA_OpaquePaintEvent);
+    m_target->installEventFilter(this);
+}
+
+void BackgroundRenderer::setImage(const QString& imagePath)
+{
+    if (imagePath == m_imagePath) {
+        return;
+    }
+    m_imagePath = imagePath;
+    ++m_generation;
+    m_scaledSize = QSize(); // 旧图保留到新图缩放完成，避免闪成纯色
+    if (m_imagePath.isEmpty()) {
+        m_scaled = QPixmap();
+    }
+    ensureScaled();
+    m_target->update();
+}
+
+bool BackgroundRenderer::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == m_target && event->type() == QEvent::Resize) {
+        ensureScaled();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void BackgroundRenderer::ensureScaled()
+{
+    const QSize size = m_target->size() * m_target->devicePixelRatioF();
+    if (m_imagePath.isEmpty() || size.isEmpty() || size == m_scaledSize || m_scaling) {
+        return; // 缩放进行中时，完成后会按最新尺寸再检查一次
+    }
+    m_scaling = true;
+    const quint64 generation = m_generation;
+    const QColor fillColor = m_fallbackColor;
+    decodedImage(m_imagePath)
+        .then(QtFuture::Launch::Async, [size, fillColor](const QImage& source) {
+            return scaleBackground(source, size, fillColor);
+        })
+        .then(this, [this, generation, size](const QImage& image) {
+            m_scaling = false;
+            if (generation == m_generation) {
+                m_scaled = QPixmap::fromImage(image);
+                m_scaledSize = size;
+                m_target->update();
+            }
+            ensureScaled(); // 缩放期间尺寸、DPR 或图片又发生了变化
+        });
+}
+
+void BackgroundRenderer::paint(QPainter& painter, const QRect& exposed)
+{
+    const qreal dpr = m_target->devicePixelRatioF();
+    if (!m_scaled.isNull() && m_scaledSize == m_target->size() * dpr) {
+        // 缓存与屏幕像素一一对应，只贴出需要重绘的区域
+        const QRectF source(exposed.x() * dpr, exposed.y() * dpr, exposed.width() * dpr, exposed.height() * dpr);
+        painter.drawPixmap(QRectF(exposed), m_scaled, source);
+        return;
+    }
+    if (!m_scaled.isNull()) {
+        painter.drawPixmap(m_target->rect(), m_scaled); // 尺寸刚变化，新缩放完成前先拉伸旧图
+    } else {
+        painter.fillRect(exposed, m_fallbackColor);
+    }
+    ensureScaled(); // DPR 变化（窗口移到另一块屏幕）不会产生 Resize 事件
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <QColor>
+#include <QObject>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+class QPainter;
+class QWidget;
+
+// =============================
+// 背景渲染
+// =============================
+// 为全屏视图绘制拉伸铺满的背景图。图片在后台线程解码一次（同一路径的解码结果进程内共享），
+// 按控件的设备像素尺寸缩放后缓存为 QPixmap；只有尺寸或 DPR 变化时才在后台重新缩放，
+// 平时重绘只是把缓存中对应区域贴到屏幕上。
+// 构造时会为目标控件设置 WA_OpaquePaintEvent（背景覆盖全部像素），Qt 不再先擦除父控件区域。
+// 缩放结果就绪前用纯色（或上一次的缓存）填充。仅在 GUI 线程使用。
+class BackgroundRenderer : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @param target 被绘制背景的控件（同时作为 parent）
+     * @param fallbackColor 无图片或图片尚未就绪时的填充色
+     */
+    BackgroundRenderer(QWidget* target, const QColor& fallbackColor);
+
+    // 设置背景图片，空路径表示只用纯色
+    void setImage(const QString& imagePath);
+    QString imagePath() const { return m_imagePath; }
+
+    // 在 target 的 paintEvent 中调用，绘制 exposed 区域的背景
+    void paint(QPainter& painter, const QRect& exposed);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    // 当前尺寸/DPR 与缓存不一致时安排后台缩放
+    void ensureScaled();
+
+    QWidget* m_target;
+    QColor m_fallbackColor;
+    QString m_imagePath;
+    QPixmap m_scaled;             // 按 m_scaledSize 缩放好的背景（设备像素）
+    QSize m_scaledSize;
+    bool m_scaling = false;       // 后台缩放进行中
+    quint64 m_generation = 0;     // 图片变化时递增，丢弃旧图片的缩放结果
+};
@@ -0,0 +1,678 @@
+#include "ConfigStore.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include "SystemInteractionModule.h"
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QSaveFile>
+#include <QtConcurrent>
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+static const int DEFAULT_DETECTION_WAIT_MS = 10000;
+// 合并窗口：连续切换多个置顶复选框等操作只写一次
+static const int CONFIG_SAVE_DEBOUNCE_MS = 300;
+// 外部修改合并窗口：部署工具或编辑器保存时往往连续触发多次变化通知
+static const int CONFIG_RELOAD_DEBOUNCE_MS = 250;
+
+// 编译缓存格式版本，缓存内容或键码解析规则变化时递增
+static const qint64 COMPILED_CACHE_VERSION = 1;
+
+namespace {
+// 写入线程中重新读取配置文件的结果
+struct ReloadResult {
+    bool changed = false; // 内容与已知内容不同
+    bool ok = false;      // 解析成功
+    QByteArray data;
+    QJsonObject root;
+    QString error;
+};
+} // namespace
+
+static QString defaultAdminPasswordHash()
+{
+    return QString::fromUtf8(QCryptographicHash::hash("123456", QCryptographicHash::Sha256).toHex());
+}
+
+static QStringList defaultAdminLoginHotkey()
+{
+    return QStringList() << "VK_LCONTROL" << "VK_LSHIFT" << "A";
+}
+
+static QCborArray vkArray(const QList<DWORD>& codes)
+{
+    QCborArray array;
+    for (DWORD code : codes) {
+        array.append(qint64(code));
+    }
+    return array;
+}
+
+static QList<DWORD> vkList(const QCborValue& value)
+{
+    QList<DWORD> codes;
+    const QCborArray array = value.toArray();
+    codes.reserve(array.size());
+    for (const QCborValue& item : array) {
+        codes.append(DWORD(item.toInteger()));
+    }
+    return codes;
+}
+
+static QByteArray sourceHash(const QByteArray& jsonData)
+{
+    return QCryptographicHash::hash(jsonData, QCryptographicHash::Sha1);
+}
+
+static QStringList stringList(const QJsonValue& value)
+{
+    QStringList result;
+    const QJsonArray array = value.toArray();
+    for (const QJsonValue& item : array) {
+        if (item.isString()) {
+            result.append(item.toString());
+        }
+    }
+    return result;
+}
+
+ConfigStore& ConfigStore::instance()
+{
+    static ConfigStore store;
+    return store;
+}
+
+ConfigStore::ConfigStore()
+    : QObject(nullptr)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(CONFIG_SAVE_DEBOUNCE_MS);
+    connect(&m_saveTimer, &QTimer::timeout, this, &ConfigStore::startWrite);
+    m_writerPool.setMaxThreadCount(1);
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &ConfigStore::flush);
+    }
+    load();
+
+    m_reloadTimer.setSingleShot(true);
+    m_reloadTimer.setInterval(CONFIG_RELOAD_DEBOUNCE_MS);
+    connect(&m_reloadTimer, &QTimer::timeout, this, &ConfigStore::startReload);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, [this]() { m_reloadTimer.start(); });
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, [this]() { m_reloadTimer.start(); });
+    watchConfigFile();
+}
+
+QString ConfigStore::configFilePath()
+{
+    // 通过环境变量USERPROFILE获取当前登录用户主目录，确保所有身份下配置一致
+    static const QString path = [] {
+        const QString configDir = qEnvironmentVariable("USERPROFILE") + "/AppData/Roaming/雪鸮团队/剑鞘系统";
+        QDir().mkpath(configDir); // 确保目录存在
+        return configDir + "/config.json";
+    }();
+    return path;
+}
+
+QString ConfigStore::compiledCacheFilePath()
+{
+    return QFileInfo(configFilePath()).absolutePath() + "/config.cache";
+}
+
+void ConfigStore::load()
+{
+    Trace::Span span("config.load");
+    const QString path = configFilePath();
+    QFile file(path);
+    bool fromCache = false;
+    if (!file.exists()) {
+        qCWarning(lcConfig) << "[ConfigStore] 配置文件不存在，将创建默认配置:" << path;
+    } else if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(lcConfig) << "[ConfigStore] 无法打开配置文件:" << path << file.errorString();
+    } else {
+        m_knownData = file.readAll();
+        file.close();
+        if (readCompiledCache(m_knownData, &m_root, &m_keys)) {
+            m_loaded = true;
+            fromCache = true;
+            qCDebug(lcConfig) << "[ConfigStore] 已从编译缓存加载配置:" << compiledCacheFilePath();
+        }
+    }
+    if (!fromCache && !m_knownData.isEmpty()) {
+        QJsonParseError parseError;
+        const QJsonDocument doc = QJsonDocument::fromJson(m_knownData, &parseError);
+        if (doc.isObject()) {
+            m_root = doc.object();
+            m_loaded = true;
+            qCDebug(lcConfig) << "[ConfigStore] 已加载配置文件:" << path;
+        } else {
+            qCWarning(lcConfig) << "[ConfigStore] 解析配置文件失败:" << parseError.errorString() << "offset" << parseError.offset;
+        }
+    }
+
+    span.attr("bytes", m_knownData.size());
+    span.attr("from_cache", fromCache);
+    const bool filled = fillDefaults(m_root);
+    if (filled || !fromCache) {
+        m_keys = resolveKeys(m_root);
+    }
+    // 只在文件能正常解析或不存在时补全写回，避免用默认值覆盖用户手工编辑出错的文件
+    if (filled && (m_loaded || !file.exists())) {
+        scheduleSave(); // 写出 JSON 后一并生成编译缓存
+    } else if (m_loaded && !fromCache) {
+        scheduleCompiledCacheWrite();
+    }
+}
+
+bool ConfigStore::fillDefaults(QJsonObject& root)
+{
+    bool changed = false;
+    if (!root.value("admin_password").isString()) {
+        root["admin_password"] = defaultAdminPasswordHash();
+        qCDebug(lcConfig) << "[ConfigStore] 自动补全默认管理员密码。";
+        changed = true;
+    }
+    if (!root.value("shortcuts").isObject()) {
+        QJsonObject adminLoginObj;
+        adminLoginObj["key_sequence"] = QJsonArray::fromStringList(defaultAdminLoginHotkey());
+        QJsonObject shortcutsObj;
+        shortcutsObj["admin_login"] = adminLoginObj;
+        root["shortcuts"] = shortcutsObj;
+        qCDebug(lcConfig) << "[ConfigStore] 自动补全默认管理员热键。";
+        changed = true;
+    }
+    if (!root.value("whitelist_apps").isArray()) {
+        root["whitelist_apps"] = QJsonArray();
+        qCDebug(lcConfig) << "[ConfigStore] 自动补全默认白名单。";
+        changed = true;
+    }
+    return changed;
+}
+
+void ConfigStore::scheduleSave()
+{
+    m_dirty = true;
+    m_saveTimer.start(); // 重新计时，窗口内的后续修改并入同一次写入
+}
+
+void ConfigStore::flush()
+{
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+        startWrite();
+    }
+    m_lastWrite.waitForFinished();
+}
+
+void ConfigStore::startWrite()
+{
+    if (!m_dirty) return;
+    m_dirty = false;
+    // 在 GUI 线程取文档快照并序列化，写入线程只接触字节数据
+    const QByteArray data = QJsonDocument(m_root).toJson(QJsonDocument::Indented);
+    m_knownData = data;
+    ++m_writeGeneration;
+    const QString path = configFilePath();
+    const QJsonObject root = m_root;
+    const ResolvedKeys keys = m_keys;
+    QPointer<ConfigStore> self(this);
+    m_lastWrite = QtConcurrent::run(&m_writerPool, [self, path, data, root, keys]() {
+        QString error;
+        if (writeAtomically(path, data, &error)) {
+            qCDebug(lcConfig) << "[ConfigStore] 配置已保存:" << path << data.size() << "bytes";
+            writeCompiledCache(data, root, keys);
+            return;
+        }
+        qCWarning(lcConfig) << "[ConfigStore] 配置保存失败:" << path << error;
+        QMetaObject::invokeMethod(qApp, [self, error]() {
+            if (!self) return;
+            self->m_dirty = true; // 文件仍是旧内容：不把它当作外部修改载入，下次修改时整体重写
+            emit self->saveFailed(error);
+        });
+    });
+}
+
+bool ConfigStore::writeAtomically(const QString& path, const QByteArray& data, QString* error)
+{
+    Trace::Span span("config.write");
+    span.attr("bytes", data.size());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    if (file.write(data) != data.size() || !file.flush()) {
+        *error = file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+    // 替换前确保临时文件内容已落盘，否则断电后可能得到已改名但内容为空的文件
+#ifdef Q_OS_WIN
+    const bool synced = FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(file.handle()))) != 0;
+#else
+    const bool synced = ::fsync(file.handle()) == 0;
+#endif
+    if (!synced) {
+        *error = QStringLiteral("flush to disk failed");
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) { // 原子替换 config.json
+        *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+// ========== 编译缓存 ========== //
+
+ConfigStore::ResolvedKeys ConfigStore::resolveKeys(const QJsonObject& root)
+{
+    auto resolve = [](const QStringList& names, const char* what) {
+        QList<DWORD> codes;
+        for (const QString& name : names) {
+            const DWORD vkCode = SystemInteractionModule::stringToVkCode(name);
+            if (vkCode != 0) {
+                codes.append(vkCode);
+            } else {
+                qCWarning(lcConfig) << "[ConfigStore] 配置文件中无效的" << what << "键名:" << name;
+            }
+        }
+        return codes;
+    };
+    const QJsonObject userSettingsObj = root.value("user_mode_settings").toObject();
+    ResolvedKeys keys;
+    keys.adminLoginHotkey = resolve(
+        stringList(root.value("shortcuts").toObject().value("admin_login").toObject().value("key_sequence")), "管理员热键");
+    keys.blockedKeys = resolve(stringList(userSettingsObj.value("blocked_keys")), "拦截键");
+    const QJsonArray combosArray = userSettingsObj.value("blocked_key_combinations").toArray();
+    for (const QJsonValue& comboVal : combosArray) {
+        if (!comboVal.isArray()) continue;
+        const QList<DWORD> combo = resolve(stringList(comboVal), "拦截组合键");
+        if (!combo.isEmpty()) {
+            keys.blockedKeyCombinations.append(combo);
+        }
+    }
+    return keys;
+}
+
+bool ConfigStore::readCompiledCache(const QByteArray& jsonData, QJsonObject* root, ResolvedKeys* keys)
+{
+    QFile file(compiledCacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QCborMap cache = QCborValue::fromCbor(file.readAll()).toMap();
+    const QFileInfo source(configFilePath());
+    // 先比较廉价的版本/大小/修改时间，再比较内容哈希
+    if (cache.value(QStringLiteral("version")).toInteger() != COMPILED_CACHE_VERSION
+        || cache.value(QStringLiteral("source_size")).toInteger() != jsonData.size()
+        || cache.value(QStringLiteral("source_mtime")).toInteger() != source.lastModified().toMSecsSinceEpoch()
+        || cache.value(QStringLiteral("source_sha1")).toByteArray() != sourceHash(jsonData)) {
+        qCDebug(lcConfig) << "[ConfigStore] 编译缓存缺失或已失效，将解析 config.json。";
+        return false;
+    }
+    *root = cache.value(QStringLiteral("document")).toMap().toJsonObject();
+    keys->adminLoginHotkey = vkList(cache.value(QStringLiteral("admin_login_vk")));
+    keys->blockedKeys = vkList(cache.value(QStringLiteral("blocked_vk")));
+    keys->blockedKeyCombinations.clear();
+    const QCborArray combos = cache.value(QStringLiteral("blocked_combo_vk")).toArray();
+    for (const QCborValue& combo : combos) {
+        keys->blockedKeyCombinations.append(vkList(combo));
+    }
+    return true;
+}
+
+void ConfigStore::writeCompiledCache(const QByteArray& jsonData, const QJsonObject& root, const ResolvedKeys& keys)
+{
+    const QFileInfo source(configFilePath());
+    if (source.size() != jsonData.size()) {
+        return; // 文件已被再次修改，交给随后的重新载入生成缓存
+    }
+    Trace::Span span("config.cache.write");
+    QCborArray combos;
+    for (const QList<DWORD>& combo : keys.blockedKeyCombinations) {
+        combos.append(vkArray(combo));
+    }
+    QCborMap cache;
+    cache.insert(QStringLiteral("version"), COMPILED_CACHE_VERSION);
+    cache.insert(QStringLiteral("source_size"), source.size());
+    cache.insert(QStringLiteral("source_mtime"), source.lastModified().toMSecsSinceEpoch());
+    cache.insert(QStringLiteral("source_sha1"), sourceHash(jsonData));
+    cache.insert(QStringLiteral("document"), QCborMap::fromJsonObject(root));
+    cache.insert(QStringLiteral("admin_login_vk"), vkArray(keys.adminLoginHotkey));
+    cache.insert(QStringLiteral("blocked_vk"), vkArray(keys.blockedKeys));
+    cache.insert(QStringLiteral("blocked_combo_vk"), combos);
+
+    QSaveFile out(compiledCacheFilePath());
+    if (!out.open(QIODevice::WriteOnly)) {
+        qCWarning(lcConfig) << "[ConfigStore] 无法写入编译缓存:" << out.fileName() << out.errorString();
+        return;
+    }
+    out.write(QCborValue(cache).toCbor());
+    if (!out.commit()) {
+        qCWarning(lcConfig) << "[ConfigStore] 编译缓存写入失败:" << out.errorString();
+    }
+}
+
+void ConfigStore::scheduleCompiledCacheWrite()
+{
+    const QByteArray data = m_knownData;
+    const QJsonObject root = m_root;
+    const ResolvedKeys keys = m_keys;
+    QtConcurrent::run(&m_writerPool, [data, root, keys]() { writeCompiledCache(data, root, keys); });
+}
+
+// ========== 外部修改热重载 ========== //
+
+void ConfigStore::watchConfigFile()
+{
+    // 同时监视目录：原子替换会换掉文件节点，仅监视文件会在第一次替换后失效
+    const QString path = configFilePath();
+    const QString dir = QFileInfo(path).absolutePath();
+    if (!m_watcher.directories().contains(dir)) {
+        m_watcher.addPath(dir);
+    }
+    if (QFileInfo::exists(path) && !m_watcher.files().contains(path)) {
+        m_watcher.addPath(path);
+    }
+}
+
+void ConfigStore::startReload()
+{
+    watchConfigFile();
+    if (m_dirty) {
+        // 本地修改即将写出并覆盖文件，此时不载入外部内容
+        qCDebug(lcConfig) << "[ConfigStore] 本地修改待写入，忽略本次配置文件变化。";
+        return;
+    }
+    const QString path = configFilePath();
+    const QByteArray known = m_knownData;
+    const quint64 generation = m_writeGeneration;
+    // 与写入共用单线程池：排在已提交的写入之后读取，读到的不会是写了一半的文件
+    QtConcurrent::run(&m_writerPool, [path, known]() {
+        Trace::Span span("config.reload.read");
+        ReloadResult result;
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return result; // 文件暂时不存在（替换过程中）或无法读取，保持当前配置
+        }
+        result.data = file.readAll();
+        if (result.data == known) {
+            return result;
+        }
+        result.changed = true;
+        span.attr("bytes", result.data.size());
+        QJsonParseError parseError;
+        const QJsonDocument doc = QJsonDocument::fromJson(result.data, &parseError);
+        if (doc.isObject()) {
+            result.root = doc.object();
+            result.ok = true;
+        } else {
+            result.error = parseError.errorString();
+        }
+        return result;
+    }).then(this, [this, generation](const ReloadResult& result) {
+        if (!result.changed || generation != m_writeGeneration || m_dirty) {
+            return; // 内容未变，或解析期间本地又有修改写出
+        }
+        if (!result.ok) {
+            qCWarning(lcConfig) << "[ConfigStore] 配置文件已被外部修改但无法解析，保留当前配置:" << result.error;
+            return;
+        }
+        m_knownData = result.data;
+        applyReloaded(result.root);
+    });
+}
+
+void ConfigStore::applyReloaded(const QJsonObject& newRoot)
+{
+    QJsonObject root = newRoot;
+    fillDefaults(root); // 缺失字段只在内存中补全，不回写外部下发的文件
+    const ConfigDiff changes = diff(m_root, root);
+    m_root = root;
+    m_keys = resolveKeys(m_root);
+    m_loaded = true;
+    scheduleCompiledCacheWrite();
+    if (changes.isEmpty()) {
+        return;
+    }
+    qCDebug(lcConfig) << "[ConfigStore] 配置文件已被外部修改: 新增应用" << changes.addedApps.size()
+             << "删除" << changes.removedApps.size() << "修改" << changes.modifiedApps.size()
+             << "重排" << changes.appsReordered << "热键" << changes.shortcutsChanged
+             << "拦截键" << changes.userModeSettingsChanged;
+
+    if (changes.hasAppChanges()) emit whitelistChanged();
+    if (changes.adminPasswordChanged) emit adminPasswordChanged();
+    if (changes.shortcutsChanged) emit shortcutsChanged();
+    if (changes.userModeSettingsChanged) emit userModeSettingsChanged();
+    if (changes.detectionWaitMsChanged) emit detectionWaitMsChanged(detectionWaitMs());
+    if (changes.loggingChanged) emit loggingSettingsChanged();
+    if (changes.uiHealthChanged) emit uiHealthSettingsChanged();
+    emit configReloaded(changes);
+}
+
+ConfigStore::ConfigDiff ConfigStore::diff(const QJsonObject& oldRoot, const QJsonObject& newRoot)
+{
+    ConfigDiff changes;
+
+    auto index = [](const QJsonObject& root, QStringList* order) {
+        QHash<QString, QJsonObject> byPath;
+        const QJsonArray appsArray = root.value("whitelist_apps").toArray();
+        for (const QJsonValue& appVal : appsArray) {
+            const QJsonObject appObj = appVal.toObject();
+            const QString path = appObj.value("path").toString();
+            byPath.insert(path, appObj);
+            order->append(path);
+        }
+        return byPath;
+    };
+    QStringList oldOrder;
+    QStringList newOrder;
+    const QHash<QString, QJsonObject> oldApps = index(oldRoot, &oldOrder);
+    const QHash<QString, QJsonObject> newApps = index(newRoot, &newOrder);
+    for (const QString& path : newOrder) {
+        const auto it = oldApps.constFind(path);
+        if (it == oldApps.constEnd()) {
+            changes.addedApps.append(path);
+        } else if (*it != newApps.value(path)) {
+            changes.modifiedApps.append(path);
+        }
+    }
+    for (const QString& path : oldOrder) {
+        if (!newApps.contains(path)) {
+            changes.removedApps.append(path);
+        }
+    }
+    changes.appsReordered = changes.addedApps.isEmpty() && changes.removedApps.isEmpty() && oldOrder != newOrder;
+
+    changes.adminPasswordChanged = oldRoot.value("admin_password") != newRoot.value("admin_password");
+    changes.shortcutsChanged = oldRoot.value("shortcuts") != newRoot.value("shortcuts");
+    changes.userModeSettingsChanged = oldRoot.value("user_mode_settings") != newRoot.value("user_mode_settings");
+    changes.detectionWaitMsChanged = oldRoot.value("detection_wait_ms") != newRoot.value("detection_wait_ms");
+    changes.loggingChanged = oldRoot.value("logging") != newRoot.value("logging")
+                             || oldRoot.value("trace_spans") != newRoot.value("trace_spans");
+    changes.uiHealthChanged = oldRoot.value("ui_health") != newRoot.value("ui_health");
+    return changes;
+}
+
+// ========== 白名单 ========== //
+
+AppInfo ConfigStore::parseApp(const QJsonObject& appObj)
+{
+    AppInfo app;
+    app.name = appObj.value("name").toString();
+    app.path = appObj.value("path").toString();
+    app.mainExecutableHint = appObj.value("mainExecutableHint").toString();
+    app.windowFindingHints = appObj.value("windowFindingHints").toObject();
+    app.smartTopmost = appObj.value("smartTopmost").toBool(true);
+    app.forceTopmost = appObj.value("forceTopmost").toBool(false);
+    if (appObj.value("icon_path").isString()) {
+        app.icon = QIcon(appObj.value("icon_path").toString());
+    }
+    return app;
+}
+
+QJsonObject ConfigStore::serializeApp(const AppInfo& app)
+{
+    QJsonObject appObj;
+    appObj["name"] = app.name;
+    appObj["path"] = app.path;
+    if (!app.mainExecutableHint.isEmpty()) {
+        appObj["mainExecutableHint"] = app.mainExecutableHint;
+    }
+    if (!app.windowFindingHints.isEmpty()) {
+        appObj["windowFindingHints"] = app.windowFindingHints;
+    }
+    // 仅保存与默认值不同的置顶选项
+    if (app.smartTopmost != true) {
+        appObj["smartTopmost"] = app.smartTopmost;
+    }
+    if (app.forceTopmost != false) {
+        appObj["forceTopmost"] = app.forceTopmost;
+    }
+    return appObj;
+}
+
+QList<AppInfo> ConfigStore::whitelistApps() const
+{
+    QList<AppInfo> apps;
+    const QJsonArray appsArray = m_root.value("whitelist_apps").toArray();
+    apps.reserve(appsArray.size());
+    for (const QJsonValue& appVal : appsArray) {
+        if (!appVal.isObject()) continue;
+        const AppInfo app = parseApp(appVal.toObject());
+        if (!app.name.isEmpty() && !app.path.isEmpty()) {
+            apps.append(app);
+        }
+    }
+    return apps;
+}
+
+void ConfigStore::setWhitelistApps(const QList<AppInfo>& apps)
+{
+    QJsonArray appsArray;
+    const QJsonArray oldArray = m_root.value("whitelist_apps").toArray();
+    for (const AppInfo& app : apps) {
+        QJsonObject appObj = serializeApp(app);
+        // 保留界面不编辑的字段（如 icon_path）
+        for (const QJsonValue& oldVal : oldArray) {
+            const QJsonObject oldObj = oldVal.toObject();
+            if (oldObj.value("path").toString() == app.path && oldObj.value("icon_path").isString()) {
+                appObj["icon_path"] = oldObj.value("icon_path");
+                break;
+            }
+        }
+        appsArray.append(appObj);
+    }
+    if (appsArray == oldArray) {
+        return;
+    }
+    m_root["whitelist_apps"] = appsArray;
+    scheduleSave();
+    emit whitelistChanged();
+}
+
+// ========== 管理员 ========== //
+
+QString ConfigStore::adminPasswordHash() const
+{
+    return m_root.value("admin_password").toString();
+}
+
+void ConfigStore::setAdminPasswordHash(const QString& hash)
+{
+    if (hash.isEmpty() || hash == adminPasswordHash()) {
+        return;
+    }
+    m_root["admin_password"] = hash;
+    scheduleSave();
+    emit adminPasswordChanged();
+}
+
+QStringList ConfigStore::adminLoginHotkey() const
+{
+    return stringList(m_root.value("shortcuts").toObject().value("admin_login").toObject().value("key_sequence"));
+}
+
+void ConfigStore::setAdminLoginHotkey(const QStringList& keyNames)
+{
+    if (keyNames.isEmpty() || keyNames == adminLoginHotkey()) {
+        return;
+    }
+    QJsonObject shortcutsObj = m_root.value("shortcuts").toObject();
+    QJsonObject adminLoginObj = shortcutsObj.value("admin_login").toObject();
+    adminLoginObj["key_sequence"] = QJsonArray::fromStringList(keyNames);
+    shortcutsObj["admin_login"] = adminLoginObj;
+    m_root["shortcuts"] = shortcutsObj;
+    m_keys.adminLoginHotkey = resolveKeys(m_root).adminLoginHotkey;
+    scheduleSave();
+    emit shortcutsChanged();
+}
+
+// ========== 用户模式按键拦截 ========== //
+
+QStringList ConfigStore::blockedKeys() const
+{
+    return stringList(m_root.value("user_mode_settings").toObject().value("blocked_keys"));
+}
+
+QList<QStringList> ConfigStore::blockedKeyCombinations() const
+{
+    QList<QStringList> combos;
+    const QJsonArray combosArray = m_root.value("user_mode_settings").toObject().value("blocked_key_combinations").toArray();
+    for (const QJsonValue& comboVal : combosArray) {
+        if (comboVal.isArray()) {
+            combos.append(stringList(comboVal));
+        }
+    }
+    return combos;
+}
+
+// ========== 其它 ========== //
+
+int ConfigStore::detectionWaitMs() const
+{
+    const int ms = m_root.value("detection_wait_ms").toInt(DEFAULT_DETECTION_WAIT_MS);
+    return (ms >= 1000 && ms <= 60000) ? ms : DEFAULT_DETECTION_WAIT_MS;
+}
+
+void ConfigStore::setDetectionWaitMs(int ms)
+{
+    if (m_root.value("detection_wait_ms").toInt(-1) == ms) {
+        return;
+    }
+    m_root["detection_wait_ms"] = ms;
+    scheduleSave();
+    emit detectionWaitMsChanged(ms);
+}
+
+QJsonObject ConfigStore::loggingLevels() const
+{
+    return m_root.value("logging").toObject();
+}
+
+bool ConfigStore::traceSpansEnabled() const
+{
+    return m_root.value("trace_spans").toBool(true);
+}
+
+QJsonObject ConfigStore::uiHealthSettings() const
+{
+    return m_root.value("ui_health").toObject();
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QFuture>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include "common_types.h"
+
+// =============================
+// 配置存储
+// =============================
+// 进程内唯一持有 config.json 解析结果的对象：首次访问时读取并解析一次，
+// 缺失的必要字段（管理员密码、管理员热键、白名单）补全默认值后写回。
+// 各模块通过类型化访问器读取，通过 setter 修改；setter 只改内存中的文档并按分区发出变更信号，
+// 落盘统一经 scheduleSave()：短时间内的多次修改合并为一次写入，在后台线程写临时文件、
+// 刷盘后原子替换 config.json，写入中途崩溃不会留下半个文件。
+// 外部修改（部署工具下发、手工编辑）由文件监视器发现，合并后在写入线程重新解析，
+// 与当前文档比较得到 ConfigDiff，只发出受影响分区的信号，由各模块增量更新。
+// 每次写出或载入 JSON 后，在旁边生成 CBOR 编译缓存（config.cache）：包含文档本身和已解析的虚拟键码，
+// 以 JSON 的大小、修改时间和 SHA-1 校验；启动时缓存有效则一次读入，不再解析 JSON、不再逐个查键名。
+// JSON 始终是唯一的数据源，缓存缺失或失效时按 JSON 重新生成。
+// 仅在 GUI 线程使用。
+class ConfigStore : public QObject
+{
+    Q_OBJECT
+public:
+    // 外部修改前后两份配置的差异，白名单应用以 path 标识
+    struct ConfigDiff {
+        QStringList addedApps;
+        QStringList removedApps;
+        QStringList modifiedApps;
+        bool appsReordered = false;      // 应用集合不变但顺序变化
+        bool adminPasswordChanged = false;
+        bool shortcutsChanged = false;
+        bool userModeSettingsChanged = false;
+        bool detectionWaitMsChanged = false;
+        bool loggingChanged = false;       // "logging" 或 "trace_spans" 变化
+        bool uiHealthChanged = false;      // "ui_health" 变化
+
+        bool hasAppChanges() const
+        {
+            return appsReordered || !addedApps.isEmpty() || !removedApps.isEmpty() || !modifiedApps.isEmpty();
+        }
+        bool isEmpty() const
+        {
+            return !hasAppChanges() && !adminPasswordChanged && !shortcutsChanged
+                   && !userModeSettingsChanged && !detectionWaitMsChanged && !loggingChanged
+                   && !uiHealthChanged;
+        }
+    };
+
+    static ConfigStore& instance();
+
+    // 配置文件路径：始终使用当前登录用户的 USERPROFILE 目录，避免管理员/普通用户路径不一致
+    static QString configFilePath();
+    // 编译缓存路径（与 config.json 同目录）
+    static QString compiledCacheFilePath();
+
+    // 配置文件是否成功读取并解析（不存在或损坏时为 false，此时使用默认值）
+    bool isLoaded() const { return m_loaded; }
+
+    // ---------- 白名单 ----------
+    /**
+     * @brief 白名单应用（不含可执行文件图标，图标由 IconRegistry 按路径异步获取）
+     * @note 配置中带 icon_path 的条目会以该文件构造 AppInfo::icon
+     */
+    QList<AppInfo> whitelistApps() const;
+    void setWhitelistApps(const QList<AppInfo>& apps);
+
+    // ---------- 管理员 ----------
+    QString adminPasswordHash() const;
+    void setAdminPasswordHash(const QString& hash);
+    // 管理员登录热键的键名序列（如 "VK_LCONTROL"、"A"），由 SystemInteractionModule 转换为虚拟键码
+    QStringList adminLoginHotkey() const;
+    void setAdminLoginHotkey(const QStringList& keyNames);
+    // 已解析的管理员热键虚拟键码（无效键名已剔除）
+    QList<DWORD> adminLoginHotkeyVkCodes() const { return m_keys.adminLoginHotkey; }
+
+    // ---------- 用户模式按键拦截 ----------
+    QStringList blockedKeys() const;
+    QList<QStringList> blockedKeyCombinations() const;
+    QList<DWORD> blockedVkCodes() const { return m_keys.blockedKeys; }
+    QList<QList<DWORD>> blockedVkCombinations() const { return m_keys.blockedKeyCombinations; }
+
+    // ---------- 其它 ----------
+    // 窗口探测等待时间（毫秒），缺失或超出 [1000, 60000] 时返回默认 10000
+    int detectionWaitMs() const;
+    void setDetectionWaitMs(int ms);
+    // 日志级别配置（"logging" 节，格式见 LogCategories.h），未配置时为空对象
+    QJsonObject loggingLevels() const;
+    // 是否记录追踪 span（"trace_spans"，默认 true）
+    bool traceSpansEnabled() const;
+    // GUI 线程健康监视设置（"ui_health" 节，格式见 UiHealthMonitor.h），未配置时为空对象
+    QJsonObject uiHealthSettings() const;
+
+    // 在合并窗口结束后将内存中的文档写入配置文件（唯一写入路径）
+    void scheduleSave();
+    // 立即写出尚未落盘的修改并等待写入完成（退出前调用）
+    void flush();
+
+signals:
+    void whitelistChanged();
+    void adminPasswordChanged();
+    void shortcutsChanged();
+    void userModeSettingsChanged();
+    void detectionWaitMsChanged(int ms);
+    void loggingSettingsChanged();
+    void uiHealthSettingsChanged();
+    // 后台写入失败（参数为错误描述），内存中的配置保持不变，下次修改时会重试
+    void saveFailed(const QString& error);
+    // 配置文件被外部修改并已载入（在对应分区信号之后发出），diff 不为空
+    void configReloaded(const ConfigStore::ConfigDiff& diff);
+
+private:
+    // 由键名解析出的虚拟键码
+    struct ResolvedKeys {
+        QList<DWORD> adminLoginHotkey;
+        QList<DWORD> blockedKeys;
+        QList<QList<DWORD>> blockedKeyCombinations;
+    };
+
+    ConfigStore();
+    Q_DISABLE_COPY(ConfigStore)
+
+    void load();
+    // 补全缺失的必要字段，返回是否有改动
+    static bool fillDefaults(QJsonObject& root);
+    static ConfigDiff diff(const QJsonObject& oldRoot, const QJsonObject& newRoot);
+    static ResolvedKeys resolveKeys(const QJsonObject& root);
+    // 读取编译缓存，与 JSON 的大小/修改时间/哈希一致时填充 root 与 keys
+    static bool readCompiledCache(const QByteArray& jsonData, QJsonObject* root, ResolvedKeys* keys);
+    // 按当前磁盘上的 JSON 文件信息写出编译缓存；在写入线程执行
+    static void writeCompiledCache(const QByteArray& jsonData, const QJsonObject& root, const ResolvedKeys& keys);
+    void scheduleCompiledCacheWrite();
+    static QJsonObject serializeApp(const AppInfo& app);
+    static AppInfo parseApp(const QJsonObject& appObj);
+    // 写临时文件 -> 刷盘 -> 原子替换；在写入线程执行
+    static bool writeAtomically(const QString& path, const QByteArray& data, QString* error);
+    void startWrite();
+    void watchConfigFile();
+    void startReload();
+    void applyReloaded(const QJsonObject& newRoot);
+
+    QJsonObject m_root;
+    ResolvedKeys m_keys;
+    bool m_loaded = false;
+    bool m_dirty = false;
+    QTimer m_saveTimer;          // 合并窗口
+    QThreadPool m_writerPool;    // 单线程，保证写入按提交顺序完成
+    QFuture<void> m_lastWrite;
+    QByteArray m_knownData;       // 最近一次读入或写出的文件内容，用于识别未真正改变的文件变化
+    quint64 m_writeGeneration = 0; // 每次提交写入递增，重新解析期间有新写入时丢弃解析结果
+    QFileSystemWatcher m_watcher;
+    QTimer m_reloadTimer;        // 文件变化合并窗口
+};
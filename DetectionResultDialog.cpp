@@ -31,6 +31,7 @@ DetectionResultDialog::DetectionResultDialog(const SuggestedWindowHints& initial
       m_buttonBox(nullptr),
       m_initialHints(initialHints)
 {
+    setObjectName("detectionResultDialog"); // 样式见 Common.qss
     // 自动解析initialHints.candidatesJson为m_candidates
     m_candidates.clear();
     for (const QJsonValue& val : initialHints.candidatesJson) {
@@ -67,7 +68,7 @@ void DetectionResultDialog::setupUi(const struct SuggestedWindowHints& initialHi
     // 新增：探测失败时，顶部显示红色失败原因
     if (!initialHints.isValid && !initialHints.errorString.isEmpty()) {
         QLabel* errorLabel = new QLabel(tr("失败原因：") + initialHints.errorString, this);
-        errorLabel->setStyleSheet("color: #d32f2f; font-weight: bold; font-size: 14px;");
+        errorLabel->setProperty("textRole", "errorTitle"); // 样式见 Common.qss
         mainLayout->addWidget(errorLabel);
     }
 
@@ -118,7 +119,7 @@ void DetectionResultDialog::setupUi(const struct SuggestedWindowHints& initialHi
     // 2. 展示所有候选窗口详细参数（如有）
     if (!m_candidates.isEmpty()) {
         QLabel* allLabel = new QLabel(tr("所有候选窗口详细参数："), this);
-        allLabel->setStyleSheet("color: #1976d2; font-weight: bold;");
+        allLabel->setProperty("textRole", "section");
         detailVLayout->addWidget(allLabel);
         QTableWidget* detailTable = new QTableWidget(m_candidates.size(), 7, this);
         detailTable->setHorizontalHeaderLabels(QStringList()
@@ -143,7 +144,7 @@ void DetectionResultDialog::setupUi(const struct SuggestedWindowHints& initialHi
     // 探测失败时，展示候选窗口列表
     if (!initialHints.isValid && !m_candidates.isEmpty()) {
         QLabel* candidateLabel = new QLabel(tr("未能自动探测到主窗口，请从下方候选窗口中选择："), this);
-        candidateLabel->setStyleSheet("color: #d9534f; font-weight: bold;");
+        candidateLabel->setProperty("textRole", "warning");
         mainLayout->addWidget(candidateLabel);
 
         // 创建表格展示候选窗口
@@ -173,7 +174,7 @@ void DetectionResultDialog::setupUi(const struct SuggestedWindowHints& initialHi
         });
         // 新增：表格下方增加说明
         QLabel* tipLabel = new QLabel(tr("点击表格某一行可自动填充参数，确认无误后点击下方'应用参数'保存。"), this);
-        tipLabel->setStyleSheet("color: #1976d2; font-size: 12px;");
+        tipLabel->setProperty("textRole", "tip");
         mainLayout->addWidget(tipLabel);
         // 选中行时自动填充参数
         connect(table, &QTableWidget::cellClicked, this, [=](int row, int /*col*/){
@@ -217,7 +218,7 @@ void DetectionResultDialog::setupUi(const struct SuggestedWindowHints& initialHi
     // 若m_candidates为空，增加提示
     if (m_candidates.isEmpty()) {
         QLabel* emptyLabel = new QLabel(tr("未采集到任何候选窗口，请检查应用是否正常启动或参数设置是否合理。"), this);
-        emptyLabel->setStyleSheet("color: #d32f2f; font-weight: bold;");
+        emptyLabel->setProperty("textRole", "error");
         mainLayout->addWidget(emptyLabel);
     }
 }
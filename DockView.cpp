@@ -0,0 +1,217 @@
+#include "DockView.h"
+#include "AppCardWidget.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include <QResizeEvent>
+#include <QScrollBar>
+
+// 与原 Dock 横向布局一致的边距与卡片间距
+static constexpr int DOCK_MARGIN = 5;
+static constexpr int DOCK_SPACING = 5;
+// 备用池最多保留的隐藏卡片数，视口缩小后多出的卡片会被销毁
+static constexpr int MAX_SPARE_CARDS = 8;
+
+// 每个新应用插入到当前序列的中间，使卡片从中间向两边扩散排列（与原 Dock 的插入规则相同）
+static void insertCenterOut(QList<AppInfo>& ordered, const AppInfo& appInfo)
+{
+    ordered.insert(ordered.size() / 2, appInfo);
+}
+
+DockView::DockView(QWidget* parent)
+    : QAbstractScrollArea(parent)
+{
+    m_cardExtent = AppCardWidget::cardExtent(logicalDpiX());
+    setFrameShape(QFrame::NoFrame);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    horizontalScrollBar()->setSingleStep(m_cardExtent / 4);
+    viewport()->setObjectName("dockScrollContentWidget"); // 沿用 UserView.qss 中内容区的透明样式
+}
+
+void DockView::setApps(const QList<AppInfo>& apps)
+{
+    Trace::Span span("dock.setApps");
+    span.attr("apps", apps.size());
+    m_apps.clear();
+    m_apps.reserve(apps.size());
+    for (const AppInfo& appInfo : apps) {
+        insertCenterOut(m_apps, appInfo);
+    }
+    rebuildSlotIndex();
+    // 加载状态由启动状态机的结束通知清除，整表重建不代表启动结束；只丢弃已不在列表中的应用
+    m_loadingPaths.removeIf([this](const QString& path) { return !m_slotByPath.contains(path); });
+    // 所有卡片都要重新绑定：已绑定的卡片回到备用池，由布局按新列表取用
+    for (AppCardWidget* card : qAsConst(m_boundCards)) {
+        recycleCard(card);
+    }
+    m_boundCards.clear();
+    m_dirtyPaths.clear();
+    horizontalScrollBar()->setValue(0);
+    updateScrollRange();
+    layoutVisibleCards();
+}
+
+void DockView::applyAppChanges(const QList<AppInfo>& apps, const QSet<QString>& changedPaths)
+{
+    Trace::Span span("dock.applyAppChanges");
+    span.attr("apps", apps.size());
+    span.attr("changed", changedPaths.size());
+    QHash<QString, const AppInfo*> appsByPath;
+    for (const AppInfo& appInfo : apps) {
+        appsByPath.insert(appInfo.path, &appInfo);
+    }
+
+    // 已删除的应用移出序列，其余应用保持原位置并更新属性
+    QList<AppInfo> ordered;
+    ordered.reserve(apps.size());
+    QSet<QString> presentPaths;
+    for (const AppInfo& current : qAsConst(m_apps)) {
+        const AppInfo* appInfo = appsByPath.value(current.path, nullptr);
+        if (!appInfo) {
+            m_loadingPaths.remove(current.path);
+            continue;
+        }
+        ordered.append(*appInfo);
+        presentPaths.insert(current.path);
+    }
+    // 新增的应用按扩散规则插入
+    for (const AppInfo& appInfo : apps) {
+        if (!presentPaths.contains(appInfo.path)) {
+            insertCenterOut(ordered, appInfo);
+            presentPaths.insert(appInfo.path);
+        }
+    }
+    m_apps = ordered;
+    m_dirtyPaths.unite(changedPaths);
+    rebuildSlotIndex();
+    updateScrollRange();
+    layoutVisibleCards();
+}
+
+void DockView::setAppLoading(const QString& appPath, bool loading)
+{
+    if (loading) {
+        m_loadingPaths.insert(appPath);
+    } else {
+        m_loadingPaths.remove(appPath);
+    }
+    if (AppCardWidget* card = m_boundCards.value(appPath, nullptr)) {
+        card->setLoadingState(loading);
+    }
+}
+
+void DockView::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollRange();
+    layoutVisibleCards();
+}
+
+void DockView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    layoutVisibleCards(); // 卡片是视口的子控件，滚动即重新摆放并回收/绑定
+}
+
+void DockView::rebuildSlotIndex()
+{
+    m_slotByPath.clear();
+    m_slotByPath.reserve(m_apps.size());
+    for (int slot = 0; slot < m_apps.size(); ++slot) {
+        m_slotByPath.insert(m_apps.at(slot).path, slot);
+    }
+}
+
+int DockView::contentWidth() const
+{
+    if (m_apps.isEmpty()) {
+        return 0;
+    }
+    return 2 * DOCK_MARGIN + m_apps.size() * m_cardExtent + (m_apps.size() - 1) * DOCK_SPACING;
+}
+
+int DockView::contentOrigin() const
+{
+    const int viewportWidth = viewport()->width();
+    const int width = contentWidth();
+    if (width < viewportWidth) {
+        return (viewportWidth - width) / 2; // 未溢出时居中
+    }
+    return -horizontalScrollBar()->value();
+}
+
+void DockView::updateScrollRange()
+{
+    QScrollBar* bar = horizontalScrollBar();
+    bar->setPageStep(viewport()->width());
+    bar->setRange(0, qMax(0, contentWidth() - viewport()->width()));
+}
+
+AppCardWidget* DockView::acquireCard(const AppInfo& appInfo)
+{
+    if (!m_spareCards.isEmpty()) {
+        AppCardWidget* card = m_spareCards.takeLast();
+        card->bindApp(appInfo.name, appInfo.path, appInfo.icon);
+        return card;
+    }
+    AppCardWidget* card = new AppCardWidget(appInfo.name, appInfo.path, appInfo.icon, viewport());
+    connect(card, &AppCardWidget::launchAppRequested, this, &DockView::launchAppRequested);
+    return card;
+}
+
+void DockView::recycleCard(AppCardWidget* card)
+{
+    card->hide();
+    card->setLoadingState(false);
+    m_spareCards.append(card);
+}
+
+void DockView::layoutVisibleCards()
+{
+    Trace::Span span("dock.layout");
+    const int pitch = m_cardExtent + DOCK_SPACING;
+    const int origin = contentOrigin() + DOCK_MARGIN;
+    const int viewportWidth = viewport()->width();
+    const int y = qMax(0, (viewport()->height() - m_cardExtent) / 2);
+
+    int first = 0;
+    int last = -1;
+    if (!m_apps.isEmpty() && viewportWidth > 0) {
+        first = qBound(0, (-origin) / pitch, m_apps.size() - 1);
+        last = qBound(0, (viewportWidth - origin) / pitch, m_apps.size() - 1);
+    }
+
+    QHash<QString, AppCardWidget*> previous;
+    previous.swap(m_boundCards);
+    int bound = 0;
+    for (int slot = first; slot <= last; ++slot) {
+        const AppInfo& appInfo = m_apps.at(slot);
+        AppCardWidget* card = previous.take(appInfo.path);
+        if (!card || m_dirtyPaths.contains(appInfo.path)) {
+            if (card) {
+                card->bindApp(appInfo.name, appInfo.path, appInfo.icon);
+            } else {
+                card = acquireCard(appInfo);
+            }
+            if (m_loadingPaths.contains(appInfo.path)) {
+                card->setLoadingState(true);
+            }
+            ++bound;
+        }
+        card->move(origin + slot * pitch, y);
+        card->show();
+        m_boundCards.insert(appInfo.path, card);
+    }
+    m_dirtyPaths.clear(); // 不可见的应用在进入视口时总会重新绑定
+
+    for (AppCardWidget* card : qAsConst(previous)) {
+        recycleCard(card);
+    }
+    while (m_spareCards.size() > MAX_SPARE_CARDS) {
+        m_spareCards.takeLast()->deleteLater();
+    }
+    span.attr("visible", m_boundCards.size());
+    span.attr("bound", bound);
+    qCTrace(lcUi) << "[DockView] 可见槽位" << first << "-" << last << "，重新绑定" << bound << "张卡片";
+}
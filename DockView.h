@@ -0,0 +1,70 @@
+#pragma once
+#include <QAbstractScrollArea>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include "common_types.h"
+
+class AppCardWidget;
+
+// =============================
+// 虚拟化 Dock 视图
+// =============================
+// 横向排列的应用卡片栏。应用列表只保存为数据（按原 Dock 的"从中间向两边扩散"顺序排列），
+// 卡片控件只为视口内可见的槽位创建；滚动时移出视口的卡片回收到备用池，再绑定到新进入视口的应用，
+// 因此控件数量与内存只与视口宽度有关，与白名单长度无关。
+// 白名单增量变化时只重新绑定可见且属性变化的卡片，其余卡片原地保留（包括悬停与加载状态）。
+// 内容窄于视口时整体居中。仅在 GUI 线程使用。
+class DockView : public QAbstractScrollArea
+{
+    Q_OBJECT
+public:
+    explicit DockView(QWidget* parent = nullptr);
+
+    // 替换整个应用列表；仍在列表中的应用保留加载状态（启动仍在进行），已移除应用的加载状态清除
+    void setApps(const QList<AppInfo>& apps);
+    /**
+     * @brief 增量更新应用列表：删除已移除的应用，新增应用按扩散顺序插入，属性变化的应用原位重新绑定
+     * @param apps 新的完整应用列表
+     * @param changedPaths 新增或属性变化的应用路径
+     */
+    void applyAppChanges(const QList<AppInfo>& apps, const QSet<QString>& changedPaths);
+    // 设置应用的加载中状态；应用不可见时只记录，滚动到可见时生效
+    void setAppLoading(const QString& appPath, bool loading);
+
+    bool hasApp(const QString& appPath) const { return m_slotByPath.contains(appPath); }
+    int appCount() const { return m_apps.size(); }
+    // 当前已创建的卡片控件数（可见 + 备用），用于基准测试与诊断
+    int cardWidgetCount() const { return m_boundCards.size() + m_spareCards.size(); }
+
+signals:
+    void launchAppRequested(const QString& appPath, const QString& appName);
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    // 重建路径 -> 槽位索引
+    void rebuildSlotIndex();
+    void updateScrollRange();
+    // 为可见槽位绑定并摆放卡片，回收移出视口的卡片
+    void layoutVisibleCards();
+    // 取一张备用卡片绑定到应用，备用池为空时创建新卡片
+    AppCardWidget* acquireCard(const AppInfo& appInfo);
+    // 隐藏卡片并放回备用池（停止其加载动画）
+    void recycleCard(AppCardWidget* card);
+
+    int contentWidth() const;
+    // 内容在视口中的起点（已计入居中与滚动）
+    int contentOrigin() const;
+
+    QList<AppInfo> m_apps;                       // 显示顺序
+    QHash<QString, int> m_slotByPath;            // 应用路径 -> 槽位
+    QHash<QString, AppCardWidget*> m_boundCards; // 可见应用路径 -> 绑定的卡片
+    QList<AppCardWidget*> m_spareCards;          // 隐藏的备用卡片
+    QSet<QString> m_dirtyPaths;                  // 属性变化、下次布局时需要重新绑定的应用
+    QSet<QString> m_loadingPaths;                // 加载中的应用
+    int m_cardExtent;                            // 卡片边长
+};
@@ -1,6 +1,10 @@
 #include "FlowLayout.h"
+#include "LogCategories.h"
 #include <QtWidgets>
 
+// 排布缓存最多保留的宽度数；拖动窗口时 heightForWidth 会被不同宽度反复查询
+static constexpr int MAX_CACHED_WIDTHS = 16;
+
 FlowLayout::FlowLayout(QWidget *parent, int margin, int hSpacing, int vSpacing)
     : QLayout(parent), m_hSpace(hSpacing), m_vSpace(vSpacing)
 {
@@ -9,14 +13,15 @@ FlowLayout::FlowLayout(QWidget *parent, int margin, int hSpacing, int vSpacing)
 
 FlowLayout::~FlowLayout()
 {
-    QLayoutItem *item;
-    while ((item = takeAt(0)))
-        delete item;
+    // 直接删除而不经过 takeAt，避免析构期间 invalidate
+    while (!itemList.isEmpty())
+        delete itemList.takeFirst();
 }
 
 void FlowLayout::addItem(QLayoutItem *item)
 {
     itemList.append(item);
+    invalidate();
 }
 
 int FlowLayout::horizontalSpacing() const
@@ -49,11 +54,23 @@ QLayoutItem *FlowLayout::itemAt(int index) const
 
 QLayoutItem *FlowLayout::takeAt(int index)
 {
-    if (index >= 0 && index < itemList.size())
-        return itemList.takeAt(index);
+    if (index >= 0 && index < itemList.size()) {
+        QLayoutItem *item = itemList.takeAt(index);
+        invalidate();
+        return item;
+    }
     return nullptr;
 }
 
+void FlowLayout::invalidate()
+{
+    m_hintsValid = false;
+    m_itemHints.clear();
+    m_placements.clear();
+    m_appliedRects.clear();
+    QLayout::invalidate();
+}
+
 Qt::Orientations FlowLayout::expandingDirections() const
 {
     return {};
@@ -66,7 +83,7 @@ bool FlowLayout::hasHeightForWidth() const
 
 int FlowLayout::heightForWidth(int width) const
 {
-    return doLayout(QRect(0, 0, width, 0), true);
+    return placementForWidth(width).height;
 }
 
 QSize FlowLayout::sizeHint() const
@@ -76,28 +93,63 @@ QSize FlowLayout::sizeHint() const
 
 QSize FlowLayout::minimumSize() const
 {
+    ensureItemHints();
+    return m_minimumSize;
+}
+
+void FlowLayout::setGeometry(const QRect &rect)
+{
+    QLayout::setGeometry(rect);
+    // 复制一份（隐式共享）：子控件在 setGeometry 中可能触发 invalidate 清空缓存
+    const Placement placement = placementForWidth(rect.width());
+    QList<QRect> applied = m_appliedRects;
+    if (applied.size() != itemList.size()) {
+        applied = QList<QRect>(itemList.size());
+    }
+    // 只给位置或尺寸变化的项设置几何，未变化的控件不会收到 move/resize
+    for (int i = 0; i < itemList.size(); ++i) {
+        const QRect target = placement.rects.at(i).translated(rect.topLeft());
+        if (target != applied.at(i)) {
+            itemList.at(i)->setGeometry(target);
+            applied[i] = target;
+        }
+    }
+    m_appliedRects = applied;
+}
+
+void FlowLayout::ensureItemHints() const
+{
+    if (m_hintsValid)
+        return;
+    m_itemHints.clear();
+    m_itemHints.reserve(itemList.size());
     QSize size;
-    QLayoutItem *item;
-    foreach (item, itemList)
+    for (QLayoutItem *item : itemList) {
+        m_itemHints.append(item->sizeHint());
         size = size.expandedTo(item->minimumSize());
+    }
     int left, top, right, bottom;
     getContentsMargins(&left, &top, &right, &bottom);
-    size += QSize(left + right, top + bottom);
-    return size;
+    m_minimumSize = size + QSize(left + right, top + bottom);
+    m_hintsValid = true;
 }
 
-void FlowLayout::setGeometry(const QRect &rect)
+const FlowLayout::Placement &FlowLayout::placementForWidth(int width) const
 {
-    QLayout::setGeometry(rect);
-    doLayout(rect, false);
+    auto it = m_placements.constFind(width);
+    if (it != m_placements.constEnd())
+        return *it;
+    if (m_placements.size() >= MAX_CACHED_WIDTHS)
+        m_placements.clear();
+    return *m_placements.insert(width, computePlacement(width));
 }
 
-int FlowLayout::doLayout(const QRect &rect, bool testOnly) const
+FlowLayout::Placement FlowLayout::computePlacement(int width) const
 {
-    qDebug() << "FlowLayout::doLayout begin";
+    ensureItemHints();
     int left, top, right, bottom;
     getContentsMargins(&left, &top, &right, &bottom);
-    QRect effectiveRect = rect.adjusted(+left, +top, -right, -bottom);
+    QRect effectiveRect = QRect(0, 0, width, 0).adjusted(+left, +top, -right, -bottom);
     int x = effectiveRect.x();
     int y = effectiveRect.y();
     int lineHeight = 0;
@@ -109,25 +161,23 @@ int FlowLayout::doLayout(const QRect &rect, bool testOnly) const
     if (spaceY == -1)
         spaceY = 24;
 
-    QLayoutItem *item;
-    foreach (item, itemList) {
-        QWidget *wid = item->widget();
-        int space = wid ? wid->style()->layoutSpacing(
-            QSizePolicy::PushButton, QSizePolicy::PushButton, Qt::Horizontal) : spaceX;
-        int nextX = x + item->sizeHint().width() + spaceX;
+    Placement placement;
+    placement.rects.reserve(m_itemHints.size());
+    for (const QSize &hint : qAsConst(m_itemHints)) {
+        int nextX = x + hint.width() + spaceX;
         if (nextX - spaceX > effectiveRect.right() && lineHeight > 0) {
             x = effectiveRect.x();
             y = y + lineHeight + spaceY;
-            nextX = x + item->sizeHint().width() + spaceX;
+            nextX = x + hint.width() + spaceX;
             lineHeight = 0;
         }
-        if (!testOnly)
-            item->setGeometry(QRect(QPoint(x, y), item->sizeHint()));
+        placement.rects.append(QRect(QPoint(x, y), hint));
         x = nextX;
-        lineHeight = qMax(lineHeight, item->sizeHint().height());
+        lineHeight = qMax(lineHeight, hint.height());
     }
-    qDebug() << "FlowLayout::doLayout end";
-    return y + lineHeight - rect.y() + bottom;
+    placement.height = y + lineHeight + bottom;
+    qCTrace(lcUi) << "[FlowLayout] 计算宽度" << width << "下的排布，共" << m_itemHints.size() << "项";
+    return placement;
 }
 
 int FlowLayout::smartSpacing(QStyle::PixelMetric pm) const
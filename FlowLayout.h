@@ -1,6 +1,7 @@
 #ifndef FLOWLAYOUT_H
 #define FLOWLAYOUT_H
 
+#include <QHash>
 #include <QLayout>
 #include <QRect>
 #include <QStyle>
@@ -23,14 +24,32 @@ public:
     void setGeometry(const QRect &rect) override;
     QSize sizeHint() const override;
     QLayoutItem *takeAt(int index) override;
+    // 清空尺寸与换行缓存；子控件 sizeHint 变化（updateGeometry）时 Qt 也会调用
+    void invalidate() override;
 
 private:
-    int doLayout(const QRect &rect, bool testOnly) const;
+    // 某一宽度下的排布结果：各项相对布局矩形左上角的位置与总高度
+    struct Placement {
+        QList<QRect> rects;
+        int height = 0;
+    };
+
+    // 取宽度对应的排布，未缓存时计算
+    const Placement &placementForWidth(int width) const;
+    Placement computePlacement(int width) const;
+    void ensureItemHints() const;
     int smartSpacing(QStyle::PixelMetric pm) const;
 
     QList<QLayoutItem *> itemList;
     int m_hSpace;
     int m_vSpace;
+
+    // ==== 缓存（invalidate / 增删项时清空）====
+    mutable QList<QSize> m_itemHints;               // 各项 sizeHint
+    mutable QSize m_minimumSize;                    // minimumSize() 结果
+    mutable bool m_hintsValid = false;
+    mutable QHash<int, Placement> m_placements;     // 宽度 -> 排布
+    QList<QRect> m_appliedRects;                    // 上次 setGeometry 实际设置给各项的矩形
 };
 
 #endif // FLOWLAYOUT_H
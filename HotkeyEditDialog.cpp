@@ -132,7 +132,7 @@ void HotkeyEditDialog::setupUi()
     m_hotkeyDisplayLabel->setAlignment(Qt::AlignCenter);
     m_hotkeyDisplayLabel->setFrameStyle(QFrame::Panel | QFrame::Sunken);
     m_hotkeyDisplayLabel->setMinimumHeight(30);
-    m_hotkeyDisplayLabel->setStyleSheet("QLabel { font-weight: bold; padding: 5px; }");
+    m_hotkeyDisplayLabel->setObjectName("hotkeyDisplayLabel"); // 样式见 Common.qss
 
     m_okButton = new QPushButton(tr("确定"), this);
     m_cancelButton = new QPushButton(tr("取消"), this);
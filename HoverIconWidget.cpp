@@ -4,6 +4,10 @@
 #include <QEnterEvent> // Required for QEnterEvent
 #include <QMouseEvent> // Required for QMouseEvent
 #include <QPixmap>
+#include <QHash>
+#include <QtMath>
+#include "IconVariantStore.h"
+#include "AnimationDriver.h"
 
 // 工具函数：缩放并居中pixmap
 static QPixmap scaledCenteredPixmap(const QPixmap& pixmap, const QSize& targetSize) {
@@ -11,61 +15,92 @@ static QPixmap scaledCenteredPixmap(const QPixmap& pixmap, const QSize& targetSi
     return pixmap.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 }
 
+// Height of the word-wrapped name at the given width. Cached per (text, font, width) because the
+// same names are measured again whenever the dock is rebuilt; GUI thread only
+static int wrappedTextHeight(const QString& text, const QFont& font, int width) {
+    static QHash<QString, int> s_heights;
+    const QString key = font.key() + QChar(0x1F) + QString::number(width) + QChar(0x1F) + text;
+    const auto it = s_heights.constFind(key);
+    if (it != s_heights.constEnd()) return *it;
+    const int height = QFontMetrics(font).boundingRect(QRect(0, 0, width, 0), Qt::AlignCenter | Qt::TextWordWrap, text).height();
+    s_heights.insert(key, height);
+    return height;
+}
+
 HoverIconWidget::HoverIconWidget(const QPixmap &icon, const QString &appName, const QString &appPath, QWidget *parent)
     : QWidget(parent), 
       m_appName(appName), 
       m_appPath(appPath),
       m_currentScaleFactor(1.0), 
-      m_scaleAnimation(nullptr),
       m_iconSize(64), // Base icon size
       m_padding(8)     // Padding around icon and for text
 {
+    m_slotSize = qCeil(m_iconSize * HOVER_SCALE);
+
     // Ensure icon is not null, provide a default if it is, or handle error
     if (icon.isNull()) {
         m_originalPixmap = QPixmap(m_iconSize, m_iconSize);
-        m_originalPixmap.fill(Qt::gray); // Placeholder for null icons
-        qWarning() << "HoverIconWidget: Received a null icon for" << m_appName;
+        m_originalPixmap.fill(Qt::gray); // Placeholder until the real icon resolves
     } else {
         m_originalPixmap = icon.scaled(m_iconSize, m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
+    m_hoverPixmap = scaledCenteredPixmap(m_originalPixmap, QSize(m_slotSize, m_slotSize));
 
-    m_iconLabel = new QLabel(this);
-    m_iconLabel->setPixmap(m_originalPixmap);
-    m_iconLabel->setAlignment(Qt::AlignCenter);
-
+    // The icon is painted in paintEvent; only the name is a child label, placed once below the icon slot
     m_nameLabel = new QLabel(m_appName, this);
     m_nameLabel->setAlignment(Qt::AlignCenter);
-    m_nameLabel->setStyleSheet("color: white; background-color: transparent;"); 
     m_nameLabel->setWordWrap(true); // Allow name to wrap if too long
+    m_nameLabel->setVisible(!m_appName.isEmpty());
 
-    QVBoxLayout *vLayout = new QVBoxLayout(); // Layout for icon and name
-    vLayout->addWidget(m_iconLabel);
-    vLayout->addWidget(m_nameLabel);
-    vLayout->setContentsMargins(0,0,0,0); // Margins handled by overall widget padding
-    vLayout->setSpacing(2); 
-    
-    // Main layout for the widget to enforce padding
-    QVBoxLayout *mainLayout = new QVBoxLayout(this);
-    mainLayout->addLayout(vLayout);
-    mainLayout->setContentsMargins(m_padding, m_padding, m_padding, m_padding);
-    setLayout(mainLayout);
-
-    // Calculate base size more accurately
-    int textHeight = m_nameLabel->sizeHint().height();
-    if (m_appName.isEmpty()) { // If no name, don't account for its height or spacing
-        textHeight = 0;
-        vLayout->setSpacing(0);
-        m_nameLabel->hide();
-    }
-    
-    m_baseSize = QSize(m_iconSize + 2 * m_padding, 
-                       m_iconSize + textHeight + 2 * m_padding + (m_appName.isEmpty() ? 0 : vLayout->spacing()));
-    setFixedSize(m_baseSize); 
+    updateBaseSize();
 
-    setupAnimation();
     setAttribute(Qt::WA_Hover); 
     setFocusPolicy(Qt::NoFocus); // Usually, these are not focusable
     m_isLaunching = false; // Initialize m_isLaunching
+
+    if (icon.isNull()) {
+        requestIcon();
+    }
+}
+
+void HoverIconWidget::updateBaseSize() {
+    const int textHeight = m_appName.isEmpty() ? 0 : wrappedTextHeight(m_appName, m_nameLabel->font(), m_slotSize);
+    const int spacing = m_appName.isEmpty() ? 0 : NAME_SPACING;
+    m_baseSize = QSize(m_slotSize + 2 * m_padding, m_slotSize + textHeight + 2 * m_padding + spacing);
+    m_nameLabel->setGeometry(m_padding, m_padding + m_slotSize + spacing, m_slotSize, textHeight);
+    setFixedSize(m_baseSize); // Never changes during hover animations
+}
+
+QRect HoverIconWidget::iconSlotRect() const {
+    return QRect(m_padding, m_padding, m_slotSize, m_slotSize);
+}
+
+void HoverIconWidget::requestIcon() {
+    QFuture<IconHandle> future = IconRegistry::instance().acquireAsync(m_appPath);
+    if (future.isFinished()) {
+        applyIconHandle(future.result());
+        return;
+    }
+    // Continuation runs on the GUI thread and is dropped if this widget is destroyed first
+    future.then(this, [this](IconHandle handle) { applyIconHandle(handle); });
+}
+
+void HoverIconWidget::applyIconHandle(IconHandle handle) {
+    if (IconRegistry::instance().sourceImage(handle).isNull()) {
+        qWarning() << "HoverIconWidget: No icon could be extracted for" << m_appName;
+        return;
+    }
+    m_iconHandle = handle;
+    updateIconPixmap();
+}
+
+// Both rest and hover sizes use the shared pre-scaled variants; intermediate animation frames
+// draw the hover-size variant through the painter transform instead of producing new pixmaps
+void HoverIconWidget::updateIconPixmap() {
+    if (m_iconHandle == InvalidIconHandle) return;
+    m_originalPixmap = IconVariantStore::instance().pixmap(m_iconHandle, m_iconSize, devicePixelRatioF());
+    m_hoverPixmap = IconVariantStore::instance().pixmap(m_iconHandle, m_slotSize, devicePixelRatioF());
+    update(iconSlotRect());
 }
 
 HoverIconWidget::~HoverIconWidget() = default;
@@ -76,77 +111,69 @@ void HoverIconWidget::setLaunching(bool isLaunching) {
     if (m_isLaunching) {
         // Optional: Could change icon appearance here, e.g., make it greyscale
         // For now, relying on the overlay in paintEvent and disabling interaction.
-        if (m_scaleAnimation->state() == QAbstractAnimation::Running) {
-            m_scaleAnimation->stop();
-        }
+        AnimationDriver::instance().stop(this);
         setScaleFactor(1.0); // Reset scale if it was animating/hovered
     }
     update(); // Trigger a repaint to show/hide the overlay
 }
 
-void HoverIconWidget::setupAnimation() {
-    m_scaleAnimation = new QPropertyAnimation(this, "scaleFactor");
-    m_scaleAnimation->setDuration(120); 
-    m_scaleAnimation->setEasingCurve(QEasingCurve::OutQuad); // Smoother curve
+void HoverIconWidget::animateScaleTo(qreal target) {
+    AnimationDriver::instance().animate(this, m_currentScaleFactor, target, 120, QEasingCurve::OutQuad,
+                                        [this](qreal value) { setScaleFactor(value); });
 }
 
 qreal HoverIconWidget::scaleFactor() const {
     return m_currentScaleFactor;
 }
 
+// An animation frame only repaints the icon slot; the widget size and the dock layout stay untouched
 void HoverIconWidget::setScaleFactor(qreal factor) {
     if (qFuzzyCompare(m_currentScaleFactor, factor))
         return;
 
     m_currentScaleFactor = factor;
-    int targetIconSize = static_cast<int>(m_iconSize * m_currentScaleFactor);
-    // Scale the pixmap for the label
-    if (!m_originalPixmap.isNull()) {
-        m_iconLabel->setPixmap(scaledCenteredPixmap(m_originalPixmap, QSize(targetIconSize, targetIconSize)));
-    }
-
-    // Recalculate the widget's fixed size based on the new icon size
-    int textHeight = m_appName.isEmpty() ? 0 : m_nameLabel->fontMetrics().boundingRect(m_nameLabel->rect(), Qt::AlignCenter | Qt::TextWordWrap, m_nameLabel->text()).height();
-    if (m_appName.isEmpty()) textHeight = 0; // Ensure it's 0 if no name
-    
-    int spacing = m_appName.isEmpty() ? 0 : static_cast<QVBoxLayout*>(layout()->itemAt(0)->layout())->spacing();
-
-    QSize newSize(targetIconSize + 2 * m_padding,
-                  targetIconSize + textHeight + 2 * m_padding + spacing);
-    
-    setFixedSize(newSize);
-    
-    if (parentWidget() && parentWidget()->layout()) {
-        parentWidget()->layout()->activate();
-    }
-    update(); 
+    update(iconSlotRect());
 }
 
 void HoverIconWidget::enterEvent(QEnterEvent *event) {
     QWidget::enterEvent(event);
     if (m_isLaunching) return; // Do not animate if launching
-    m_scaleAnimation->stop(); // Stop any ongoing animation
-    m_scaleAnimation->setStartValue(m_currentScaleFactor); // Start from current scale
-    m_scaleAnimation->setEndValue(1.35);      // Target scale when hovered
-    m_scaleAnimation->setDirection(QAbstractAnimation::Forward); // Ensure forward direction for scaling up
-    m_scaleAnimation->start();
+    animateScaleTo(HOVER_SCALE); // Replaces any ongoing animation, starting from the current scale
 }
 
 void HoverIconWidget::leaveEvent(QEvent *event) {
     QWidget::leaveEvent(event);
     if (m_isLaunching) return; // Do not animate if launching
-    m_scaleAnimation->stop(); // Stop any ongoing animation
-    m_scaleAnimation->setStartValue(m_currentScaleFactor); // Start from current scale
-    m_scaleAnimation->setEndValue(1.0);       // Target scale when not hovered (original size)
-    // m_scaleAnimation->setDirection(QAbstractAnimation::Backward); // Direction is implicit by start/end values, but can be explicit
-    m_scaleAnimation->start();
+    animateScaleTo(1.0); // Target scale when not hovered (original size)
+}
+
+void HoverIconWidget::changeEvent(QEvent *event) {
+    QWidget::changeEvent(event);
+    if (event->type() == QEvent::FontChange) {
+        updateBaseSize(); // Name metrics depend on the label font
+    }
 }
 
 void HoverIconWidget::paintEvent(QPaintEvent *event) {
-    QWidget::paintEvent(event); // Call base class to paint children (labels)
+    QWidget::paintEvent(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    {
+        // Zoom around the slot centre: the rest size uses its own variant unscaled,
+        // any larger frame draws the hover variant scaled down by the transform
+        const bool atRest = qFuzzyCompare(m_currentScaleFactor, 1.0);
+        const QPixmap& pixmap = atRest ? m_originalPixmap : m_hoverPixmap;
+        const qreal side = atRest ? m_iconSize : m_slotSize;
+        const qreal scale = m_currentScaleFactor * m_iconSize / side;
+        painter.save();
+        painter.translate(QRectF(iconSlotRect()).center());
+        painter.scale(scale, scale);
+        painter.drawPixmap(QRectF(-side / 2, -side / 2, side, side), pixmap, QRectF(pixmap.rect()));
+        painter.restore();
+    }
 
     if (m_isLaunching) {
-        QPainter painter(this);
         painter.setRenderHint(QPainter::Antialiasing);
         // Draw a semi-transparent overlay
         painter.fillRect(rect(), QColor(0, 0, 0, 128)); // Black with 50% opacity
@@ -160,17 +187,11 @@ void HoverIconWidget::paintEvent(QPaintEvent *event) {
 }
 
 QSize HoverIconWidget::sizeHint() const {
-    int currentIconDisplaySize = static_cast<int>(m_iconSize * m_currentScaleFactor);
-    int textHeight = m_appName.isEmpty() ? 0 : m_nameLabel->fontMetrics().boundingRect(m_nameLabel->rect(), Qt::AlignCenter | Qt::TextWordWrap, m_nameLabel->text()).height();
-     if (m_appName.isEmpty()) textHeight = 0;
-    int spacing = m_appName.isEmpty() ? 0 : static_cast<QVBoxLayout*>(layout()->itemAt(0)->layout())->spacing();
-    return QSize(currentIconDisplaySize + 2 * m_padding,
-                 currentIconDisplaySize + textHeight + 2 * m_padding + spacing);
+    return m_baseSize; // Fixed slot; hover zoom happens at paint time
 }
 
 QSize HoverIconWidget::minimumSizeHint() const {
-    // Minimum could be the base size, or a fraction of it. For now, same as sizeHint.
-    return sizeHint();
+    return m_baseSize;
 }
 
 void HoverIconWidget::mousePressEvent(QMouseEvent *event) {
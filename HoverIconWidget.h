@@ -4,9 +4,8 @@
 #include <QWidget>
 #include <QPixmap>
 #include <QString>
-#include <QPropertyAnimation>
 #include <QLabel>
-#include <QVBoxLayout>
+#include "IconRegistry.h"
 
 class HoverIconWidget : public QWidget
 {
@@ -31,24 +30,37 @@ protected:
     void leaveEvent(QEvent *event) override;
     void paintEvent(QPaintEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
+    void changeEvent(QEvent *event) override;
 
 signals:
     void clicked(const QString& appPath);
 
 private:
-    void setupAnimation();
+    // Animates the scale factor through the shared AnimationDriver
+    void animateScaleTo(qreal target);
+    // 图标为空时向 IconRegistry 异步请求，完成后替换占位图标
+    void requestIcon();
+    void applyIconHandle(IconHandle handle);
+    void updateIconPixmap();
+    // Fixes the widget size from the hover-size icon slot and the cached name metrics
+    void updateBaseSize();
+    // Icon slot reserved for the fully hovered icon; the zoom is painted inside it
+    QRect iconSlotRect() const;
 
-    QLabel *m_iconLabel;
     QLabel *m_nameLabel;
     QString m_appName;
     QString m_appPath;
     QPixmap m_originalPixmap;
+    QPixmap m_hoverPixmap; // Hover-size variant, painted scaled down during the zoom animation
+    IconHandle m_iconHandle = InvalidIconHandle; // Resolved icon; pixmaps come from IconVariantStore
+    static constexpr qreal HOVER_SCALE = 1.35;
+    static constexpr int NAME_SPACING = 2;
     
     qreal m_currentScaleFactor;
-    QPropertyAnimation *m_scaleAnimation;
 
     QSize m_baseSize;
     int m_iconSize;
+    int m_slotSize; // Icon slot edge, large enough for the hovered icon
     int m_padding;
 
     bool m_isLaunching = false;
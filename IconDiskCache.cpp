@@ -0,0 +1,311 @@
+#include "IconDiskCache.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cstring>
+
+// ========== 文件格式 ========== //
+// [FileHeader][EntryRecord * entryCount][FrameRecord * frameCount][key 字符串(UTF-16)][像素数据(16 字节对齐)]
+namespace {
+
+const char ICON_CACHE_MAGIC[4] = { 'J', 'Q', 'I', 'C' };
+const quint32 ICON_CACHE_VERSION = 1;
+const qint64 PIXEL_DATA_ALIGNMENT = 16;
+
+struct FileHeader {
+    char magic[4];
+    quint32 version;
+    quint32 entryCount;
+    quint32 frameCount;
+};
+
+struct EntryRecord {
+    quint32 keyOffset;    // key 字符串在文件中的偏移
+    quint32 keyLength;    // UTF-16 码元个数
+    qint64 lastModified;
+    qint64 fileSize;
+    quint32 firstFrame;
+    quint32 frameCount;
+};
+
+struct FrameRecord {
+    quint32 width;
+    quint32 height;
+    quint32 bytesPerLine;
+    quint32 reserved;
+    quint64 dataOffset;
+};
+
+static_assert(sizeof(FileHeader) == 16, "IconDiskCache: FileHeader 布局变化");
+static_assert(sizeof(EntryRecord) == 32, "IconDiskCache: EntryRecord 布局变化");
+static_assert(sizeof(FrameRecord) == 24, "IconDiskCache: FrameRecord 布局变化");
+
+qint64 alignUp(qint64 value, qint64 alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+IconDiskCache::IconDiskCache(const QString& filePath)
+    : m_filePath(filePath)
+{
+}
+
+IconDiskCache::~IconDiskCache()
+{
+    close();
+}
+
+QString IconDiskCache::indexKey(const QString& key, qreal dpr)
+{
+    return key + QLatin1Char('|') + QString::number(qRound(dpr * 100));
+}
+
+void IconDiskCache::close()
+{
+    m_entries.clear(); // 先释放包装映射内存的 QImage
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    m_mappedSize = 0;
+    m_file.close();
+}
+
+bool IconDiskCache::open()
+{
+    Trace::Span span("icon.diskcache.open");
+    close();
+    m_file.setFileName(m_filePath);
+    if (!m_file.exists()) {
+        return false;
+    }
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qCWarning(lcIcon) << "[IconDiskCache] 无法打开图标缓存文件:" << m_filePath << m_file.errorString();
+        return false;
+    }
+    m_mappedSize = m_file.size();
+    if (m_mappedSize < qint64(sizeof(FileHeader))) {
+        close();
+        return false;
+    }
+    m_mapped = m_file.map(0, m_mappedSize);
+    if (!m_mapped) {
+        qCWarning(lcIcon) << "[IconDiskCache] 映射图标缓存文件失败:" << m_file.errorString();
+        close();
+        return false;
+    }
+
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(m_mapped);
+    if (std::memcmp(header->magic, ICON_CACHE_MAGIC, sizeof(ICON_CACHE_MAGIC)) != 0 || header->version != ICON_CACHE_VERSION) {
+        qCWarning(lcIcon) << "[IconDiskCache] 图标缓存文件格式不符，忽略:" << m_filePath;
+        close();
+        return false;
+    }
+    const qint64 tablesEnd = qint64(sizeof(FileHeader)) + qint64(header->entryCount) * qint64(sizeof(EntryRecord))
+                             + qint64(header->frameCount) * qint64(sizeof(FrameRecord));
+    if (tablesEnd > m_mappedSize) {
+        qCWarning(lcIcon) << "[IconDiskCache] 图标缓存文件已损坏（索引越界），忽略。";
+        close();
+        return false;
+    }
+
+    const EntryRecord* entries = reinterpret_cast<const EntryRecord*>(m_mapped + sizeof(FileHeader));
+    const FrameRecord* frames = reinterpret_cast<const FrameRecord*>(entries + header->entryCount);
+    for (quint32 i = 0; i < header->entryCount; ++i) {
+        const EntryRecord& record = entries[i];
+        const qint64 keyEnd = qint64(record.keyOffset) + qint64(record.keyLength) * 2;
+        if (keyEnd > m_mappedSize || qint64(record.firstFrame) + record.frameCount > header->frameCount) {
+            qCWarning(lcIcon) << "[IconDiskCache] 跳过损坏的缓存条目:" << i;
+            continue;
+        }
+        const QString key = QString::fromUtf16(reinterpret_cast<const char16_t*>(m_mapped + record.keyOffset),
+                                               record.keyLength);
+        Entry entry;
+        entry.lastModified = record.lastModified;
+        entry.fileSize = record.fileSize;
+        bool valid = true;
+        for (quint32 f = 0; f < record.frameCount && valid; ++f) {
+            const FrameRecord& frame = frames[record.firstFrame + f];
+            const qint64 dataEnd = qint64(frame.dataOffset) + qint64(frame.bytesPerLine) * frame.height;
+            if (frame.width == 0 || frame.height == 0 || frame.bytesPerLine < frame.width * 4 || dataEnd > m_mappedSize) {
+                valid = false;
+                break;
+            }
+            // 只读包装映射内存，不拷贝
+            entry.frames.append(QImage(static_cast<const uchar*>(m_mapped + frame.dataOffset),
+                                       int(frame.width), int(frame.height), int(frame.bytesPerLine),
+                                       QImage::Format_ARGB32_Premultiplied));
+        }
+        if (valid && !entry.frames.isEmpty()) {
+            m_entries.insert(key, entry);
+        }
+    }
+    qCDebug(lcIcon) << "[IconDiskCache] 已映射图标缓存:" << m_filePath << "条目数:" << m_entries.size()
+             << "大小:" << m_mappedSize << "字节";
+    return true;
+}
+
+QList<QImage> IconDiskCache::lookup(const QString& key, qint64 lastModified, qint64 fileSize, qreal dpr) const
+{
+    const QString k = indexKey(key, dpr);
+    auto matches = [&](const Entry& entry) {
+        return entry.lastModified == lastModified && entry.fileSize == fileSize;
+    };
+    const auto pending = m_pending.constFind(k);
+    if (pending != m_pending.constEnd()) {
+        return matches(*pending) ? pending->frames : QList<QImage>();
+    }
+    const auto it = m_entries.constFind(k);
+    if (it != m_entries.constEnd() && matches(*it)) {
+        return it->frames;
+    }
+    return QList<QImage>();
+}
+
+bool IconDiskCache::isMapped(const QImage& image) const
+{
+    const uchar* bits = image.constBits();
+    return m_mapped && bits >= m_mapped && bits < m_mapped + m_mappedSize;
+}
+
+void IconDiskCache::insert(const QString& key, qint64 lastModified, qint64 fileSize, qreal dpr, const QList<QImage>& frames)
+{
+    Entry entry;
+    entry.lastModified = lastModified;
+    entry.fileSize = fileSize;
+    for (const QImage& frame : frames) {
+        if (!frame.isNull()) {
+            entry.frames.append(frame.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+        }
+    }
+    if (!entry.frames.isEmpty()) {
+        m_pending.insert(indexKey(key, dpr), entry);
+    }
+}
+
+IconDiskCache::SaveJob IconDiskCache::prepareSave() const
+{
+    // 合并：新条目覆盖映射中的同键旧条目
+    SaveJob job;
+    job.entries = m_entries;
+    job.pending = m_pending;
+    for (auto it = m_pending.constBegin(); it != m_pending.constEnd(); ++it) {
+        job.entries.insert(it.key(), it.value());
+    }
+    return job;
+}
+
+bool IconDiskCache::writeSave(SaveJob& job) const
+{
+    Trace::Span span("icon.diskcache.write");
+    const QHash<QString, Entry>& merged = job.entries;
+
+    // 先计算布局
+    const QList<QString> keys = merged.keys();
+    quint32 frameCount = 0;
+    for (const QString& key : keys) {
+        frameCount += quint32(merged.value(key).frames.size());
+    }
+    qint64 offset = qint64(sizeof(FileHeader)) + qint64(keys.size()) * qint64(sizeof(EntryRecord))
+                    + qint64(frameCount) * qint64(sizeof(FrameRecord));
+    QList<EntryRecord> entryRecords;
+    QList<FrameRecord> frameRecords;
+    entryRecords.reserve(keys.size());
+    frameRecords.reserve(frameCount);
+    for (const QString& key : keys) {
+        const Entry& entry = merged[key];
+        EntryRecord record = {};
+        record.keyOffset = quint32(offset);
+        record.keyLength = quint32(key.size());
+        record.lastModified = entry.lastModified;
+        record.fileSize = entry.fileSize;
+        record.firstFrame = quint32(frameRecords.size());
+        record.frameCount = quint32(entry.frames.size());
+        entryRecords.append(record);
+        offset += qint64(key.size()) * 2;
+        for (const QImage& frame : entry.frames) {
+            FrameRecord fr = {};
+            fr.width = quint32(frame.width());
+            fr.height = quint32(frame.height());
+            fr.bytesPerLine = quint32(frame.bytesPerLine());
+            frameRecords.append(fr);
+        }
+    }
+    for (FrameRecord& fr : frameRecords) {
+        offset = alignUp(offset, PIXEL_DATA_ALIGNMENT);
+        fr.dataOffset = quint64(offset);
+        offset += qint64(fr.bytesPerLine) * fr.height;
+    }
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    job.file = std::make_unique<QSaveFile>(m_filePath);
+    QSaveFile& out = *job.file;
+    if (!out.open(QIODevice::WriteOnly)) {
+        qCWarning(lcIcon) << "[IconDiskCache] 无法写入图标缓存:" << m_filePath << out.errorString();
+        job.file.reset();
+        return false;
+    }
+    FileHeader header = {};
+    std::memcpy(header.magic, ICON_CACHE_MAGIC, sizeof(ICON_CACHE_MAGIC));
+    header.version = ICON_CACHE_VERSION;
+    header.entryCount = quint32(entryRecords.size());
+    header.frameCount = frameCount;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entryRecords.constData()), qint64(entryRecords.size()) * qint64(sizeof(EntryRecord)));
+    out.write(reinterpret_cast<const char*>(frameRecords.constData()), qint64(frameRecords.size()) * qint64(sizeof(FrameRecord)));
+    for (const QString& key : keys) {
+        out.write(reinterpret_cast<const char*>(key.utf16()), qint64(key.size()) * 2);
+    }
+    // 像素数据：映射中的旧条目直接从映射内存写出，映射在 commitSave() 之前不会解除
+    int frameIndex = 0;
+    for (const QString& key : keys) {
+        for (const QImage& frame : merged[key].frames) {
+            const FrameRecord& fr = frameRecords.at(frameIndex++);
+            const qint64 padding = qint64(fr.dataOffset) - out.pos();
+            if (padding > 0) {
+                out.write(QByteArray(int(padding), '\0'));
+            }
+            out.write(reinterpret_cast<const char*>(frame.constBits()), qint64(fr.bytesPerLine) * fr.height);
+        }
+    }
+    job.entries.clear(); // 释放指向映射内存的 QImage
+    if (out.error() != QFileDevice::NoError) {
+        qCWarning(lcIcon) << "[IconDiskCache] 写入图标缓存失败:" << out.errorString();
+        job.file.reset();
+        return false;
+    }
+    return true;
+}
+
+bool IconDiskCache::commitSave(SaveJob& job)
+{
+    Trace::Span span("icon.diskcache.commit");
+    if (!job.file) {
+        return false;
+    }
+    // Windows 下无法替换仍被映射的文件，提交前先解除映射
+    close();
+    const bool committed = job.file->commit();
+    job.file.reset();
+    if (!committed) {
+        qCWarning(lcIcon) << "[IconDiskCache] 提交图标缓存失败:" << m_filePath;
+        open();
+        return false;
+    }
+    // 写文件期间可能又插入了新条目，只移除本次已写入的版本
+    for (auto it = job.pending.constBegin(); it != job.pending.constEnd(); ++it) {
+        const auto current = m_pending.constFind(it.key());
+        if (current != m_pending.constEnd() && current->lastModified == it->lastModified
+            && current->fileSize == it->fileSize) {
+            m_pending.erase(current);
+        }
+    }
+    job.pending.clear();
+    open();
+    return true;
+}
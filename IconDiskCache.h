@@ -0,0 +1,72 @@
+#pragma once
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QImage>
+#include <QFile>
+#include <QSaveFile>
+#include <memory>
+
+// =============================
+// 图标磁盘缓存（单文件打包 + 内存映射）
+// =============================
+// 文件中保存预渲染好的 ARGB32_Premultiplied 像素，按 (路径, 修改时间, 大小, DPR) 索引。
+// 启动时整体映射到内存，命中时直接以 QImage 包装映射内存，不拷贝、不解码；
+// 未命中或文件版本变化时由 IconRegistry 提取后 insert()，再分三步重新打包写回：
+// prepareSave() 取快照、writeSave() 写临时文件、commitSave() 替换文件并重新映射。
+// 本类不做加锁：除 writeSave() 外都由 IconRegistry 在自身互斥锁内调用，
+// writeSave() 只读快照，可在锁外的工作线程中进行，写文件期间查询不受影响。
+class IconDiskCache
+{
+public:
+    struct Entry {
+        qint64 lastModified = 0;
+        qint64 fileSize = 0;
+        QList<QImage> frames;
+    };
+    // 一次写回的快照；帧与缓存隐式共享，不拷贝像素
+    struct SaveJob {
+        QHash<QString, Entry> entries;   // 合并后的全部条目（旧条目的帧指向映射内存）
+        QHash<QString, Entry> pending;   // 本次写入的新条目，提交成功后从待写列表移除
+        std::unique_ptr<QSaveFile> file; // writeSave() 写好的临时文件
+    };
+
+    explicit IconDiskCache(const QString& filePath);
+    ~IconDiskCache();
+
+    // 映射缓存文件并建立索引；文件不存在或格式不符时视为空缓存
+    bool open();
+
+    /**
+     * @brief 查找缓存的图标帧
+     * @return 包装映射内存的 QImage 列表（只读、零拷贝），未命中或版本不符返回空列表
+     * @note 返回的 QImage 仅在下一次 commitSave() 之前有效，需跨越提交保留的帧先用 isMapped() 检查并拷贝
+     */
+    QList<QImage> lookup(const QString& key, qint64 lastModified, qint64 fileSize, qreal dpr) const;
+    // 记录新提取的图标帧，等待下一次写回
+    void insert(const QString& key, qint64 lastModified, qint64 fileSize, qreal dpr, const QList<QImage>& frames);
+
+    bool isDirty() const { return !m_pending.isEmpty(); }
+    // 图像是否直接引用当前映射内存
+    bool isMapped(const QImage& image) const;
+    // 合并映射中的有效条目与新条目，得到写回快照（需在锁内调用，只做浅拷贝）
+    SaveJob prepareSave() const;
+    /**
+     * @brief 将快照打包写入临时文件，不替换缓存文件
+     * @note 不访问可变成员，可在锁外调用；快照中的帧指向映射内存，commitSave() 之前映射保持有效
+     */
+    bool writeSave(SaveJob& job) const;
+    // 解除映射、原子替换缓存文件并重新映射（需在锁内调用）
+    bool commitSave(SaveJob& job);
+
+private:
+    static QString indexKey(const QString& key, qreal dpr);
+    void close();
+
+    QString m_filePath;
+    QFile m_file;
+    uchar* m_mapped = nullptr;
+    qint64 m_mappedSize = 0;
+    QHash<QString, Entry> m_entries; // 已映射的条目（帧指向映射内存）
+    QHash<QString, Entry> m_pending; // 尚未写入文件的新条目
+};
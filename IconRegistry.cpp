@@ -0,0 +1,395 @@
+#include "IconRegistry.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include "IconDiskCache.h"
+#include "IconVariantStore.h"
+#include "PeIconExtractor.h"
+#include "ConfigStore.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QImage>
+#include <QPixmap>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QGuiApplication>
+#include <QCoreApplication>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <windows.h>
+#include <shellapi.h>
+#include <commoncontrols.h>
+#include <string>
+
+// 磁盘缓存中预渲染的逻辑尺寸（状态栏 32、悬停 64、卡片 128、以及高分屏备用的 256）
+static const int ICON_CACHE_LOGICAL_SIZES[] = { 32, 64, 128, 256 };
+// 新图标写回磁盘缓存前的合并等待时间
+static const int ICON_CACHE_FLUSH_DELAY_MS = 2000;
+// 图标提取线程数：Shell 调用以 IO 为主，两个线程足以覆盖冷启动
+static const int ICON_WORKER_THREAD_COUNT = 2;
+
+static qreal currentDevicePixelRatio()
+{
+    return qGuiApp ? qGuiApp->devicePixelRatio() : 1.0;
+}
+
+// 每个线程只初始化一次 COM，线程退出时随 thread_local 对象析构释放
+struct ComApartment {
+    ComApartment()
+        : result(CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE))
+    {
+        if (FAILED(result) && result != RPC_E_CHANGED_MODE) {
+            qCWarning(lcIcon) << "[IconRegistry] CoInitializeEx failed with HRESULT:" << QString::number(result, 16);
+        }
+    }
+    ~ComApartment()
+    {
+        if (SUCCEEDED(result)) {
+            CoUninitialize();
+        }
+    }
+    HRESULT result;
+};
+
+static void ensureComInitialized()
+{
+    thread_local ComApartment apartment;
+    Q_UNUSED(apartment);
+}
+
+// 从系统图像列表取图标（SHIL_JUMBO 为 256px，SHIL_EXTRALARGE 为 48px）
+static QImage shellImageListIcon(const QString& executablePath, int imageList)
+{
+    SHFILEINFOW sfi = {};
+    const std::wstring pathW = executablePath.toStdWString();
+    if (!SHGetFileInfoW(pathW.c_str(), 0, &sfi, sizeof(sfi), SHGFI_SYSICONINDEX)) {
+        return QImage();
+    }
+    IImageList* list = nullptr;
+    if (FAILED(SHGetImageList(imageList, IID_PPV_ARGS(&list))) || !list) {
+        return QImage();
+    }
+    HICON hIcon = nullptr;
+    list->GetIcon(sfi.iIcon, ILD_TRANSPARENT, &hIcon);
+    list->Release();
+    if (!hIcon) {
+        return QImage();
+    }
+    QImage image = QImage::fromHICON(hIcon);
+    DestroyIcon(hIcon);
+    return image;
+}
+
+// 读取 ico/svg 文件中最大的一帧
+static QImage imageFromIconFile(const QString& iconPath)
+{
+    QImageReader reader(iconPath);
+    if (QFileInfo(iconPath).suffix().compare("svg", Qt::CaseInsensitive) == 0) {
+        reader.setScaledSize(QSize(128, 128));
+    }
+    QImage best;
+    const int count = qMax(1, reader.imageCount());
+    for (int i = 0; i < count; ++i) {
+        if (i > 0 && !reader.jumpToImage(i)) break;
+        const QImage frame = reader.read();
+        if (frame.width() > best.width()) {
+            best = frame;
+        }
+    }
+    return best;
+}
+
+// 从可执行文件提取尽可能大的图标：PE 资源 -> 系统图像列表 -> SHGetFileInfoW -> 应用目录下的 ico/svg
+// 全程只使用 QImage，可在工作线程中调用；只有走到 Shell 回退时才初始化 COM
+static QImage extractIconImage(const QString& executablePath)
+{
+    qCDebug(lcIcon) << "[IconRegistry] Attempting to get icon for:" << executablePath;
+    if (executablePath.isEmpty() || !QFile::exists(executablePath)) {
+        qCWarning(lcIcon) << "[IconRegistry] Path is empty or file does not exist:" << executablePath;
+        return QImage();
+    }
+    QImage best;
+    auto consider = [&best](const QImage& image) {
+        if (!image.isNull() && image.width() > best.width() && image.height() > best.height()) {
+            best = image;
+        }
+    };
+
+    // --- 优先直接解析 PE 资源中的最大图标帧（含 256px PNG 帧），无需 COM/Shell ---
+    consider(PeIconExtractor::extractLargestIcon(executablePath));
+    if (best.width() >= 64 && best.height() >= 64) {
+        qCDebug(lcIcon) << "[IconRegistry] Got icon from PE resources, size:" << best.size();
+        return best;
+    }
+
+    // --- 非 PE 文件或资源中没有大图标时，尝试系统图像列表 ---
+    ensureComInitialized();
+    consider(shellImageListIcon(executablePath, SHIL_JUMBO));
+    if (best.width() < 128) {
+        consider(shellImageListIcon(executablePath, SHIL_EXTRALARGE));
+    }
+    if (best.width() >= 64 && best.height() >= 64) {
+        qCDebug(lcIcon) << "[IconRegistry] Got large icon from system image list, size:" << best.size();
+        return best;
+    }
+
+    // --- 若系统图像列表获取不到大图标，尝试SHGetFileInfo ---
+    qCDebug(lcIcon) << "[IconRegistry] Attempting SHGetFileInfoW for large icon:" << executablePath;
+    SHFILEINFOW sfi = {0};
+    const std::wstring filePathStdW = executablePath.toStdWString();
+    if (SHGetFileInfoW(filePathStdW.c_str(), 0, &sfi, sizeof(sfi), SHGFI_ICON | SHGFI_LARGEICON) && sfi.hIcon) {
+        consider(QImage::fromHICON(sfi.hIcon));
+        DestroyIcon(sfi.hIcon);
+    }
+    if (best.width() >= 64 && best.height() >= 64) {
+        qCDebug(lcIcon) << "[IconRegistry] Got large icon from SHGetFileInfoW, size:" << best.size();
+        return best;
+    }
+
+    // --- 若仍无大图标，尝试查找应用目录下ico/svg资源 ---
+    QDir exeDir = QFileInfo(executablePath).absoluteDir();
+    QString baseName = QFileInfo(executablePath).completeBaseName();
+    QStringList iconCandidates = exeDir.entryList(QStringList{baseName+".ico", "app.ico", "icon.ico", baseName+".svg", "app.svg", "icon.svg"}, QDir::Files);
+    for (const QString& iconFile : iconCandidates) {
+        const QString iconPath = exeDir.absoluteFilePath(iconFile);
+        const QSize before = best.size();
+        consider(imageFromIconFile(iconPath));
+        if (best.size() != before) {
+            qCDebug(lcIcon) << "[IconRegistry] Got icon from app dir resource:" << iconPath << ", size:" << best.size();
+        }
+    }
+    if (best.isNull()) {
+        qCWarning(lcIcon) << "[IconRegistry] All attempts to get icon FAILED for:" << executablePath;
+    }
+    return best;
+}
+
+// 将源图标按缓存尺寸缩放为帧（只缩小不放大），相同尺寸的帧只保留一份
+static QList<QImage> renderCacheFrames(const QImage& source, qreal dpr)
+{
+    QList<QImage> frames;
+    if (source.isNull()) {
+        return frames;
+    }
+    const QImage premultiplied = source.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QSize lastSize;
+    for (int logicalSize : ICON_CACHE_LOGICAL_SIZES) {
+        const int target = qRound(logicalSize * dpr);
+        const QImage frame = (premultiplied.width() > target || premultiplied.height() > target)
+            ? premultiplied.scaled(target, target, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+            : premultiplied;
+        if (frame.size() == lastSize) continue;
+        lastSize = frame.size();
+        frames.append(frame);
+    }
+    return frames;
+}
+
+IconRegistry::IconRegistry()
+{
+    m_workerPool.setMaxThreadCount(ICON_WORKER_THREAD_COUNT);
+    m_workerPool.setExpiryTimeout(-1); // 线程常驻，COM 只初始化一次
+}
+
+IconRegistry::~IconRegistry() = default;
+
+IconRegistry& IconRegistry::instance()
+{
+    static IconRegistry registry;
+    return registry;
+}
+
+QString IconRegistry::diskCacheFilePath()
+{
+    // 与 config.json 放在同一目录
+    return QFileInfo(ConfigStore::configFilePath()).absolutePath() + "/icon_cache.bin";
+}
+
+IconDiskCache* IconRegistry::diskCache()
+{
+    if (!m_diskCache) {
+        m_diskCache = std::make_unique<IconDiskCache>(diskCacheFilePath());
+        m_diskCache->open();
+    }
+    return m_diskCache.get();
+}
+
+void IconRegistry::scheduleDiskCacheFlush()
+{
+    if (m_flushScheduled || !qApp) return;
+    m_flushScheduled = true;
+    // 定时器需在主线程创建，resolve 在图标工作线程中调用
+    QMetaObject::invokeMethod(qApp, []() {
+        QTimer::singleShot(ICON_CACHE_FLUSH_DELAY_MS, qApp, []() { IconRegistry::instance().flushDiskCache(); });
+    }, Qt::QueuedConnection);
+}
+
+void IconRegistry::flushDiskCache()
+{
+    QMutexLocker locker(&m_mutex);
+    m_flushScheduled = false;
+    if (!m_diskCache || !m_diskCache->isDirty() || m_flushRunning) {
+        return; // 正在写回时不重复启动，写完后会检查期间新增的条目
+    }
+    m_flushRunning = true;
+    // 锁内只取浅拷贝快照；打包写文件在工作线程进行，期间 acquireAsync/lookup 照常进行
+    auto job = std::make_shared<IconDiskCache::SaveJob>(m_diskCache->prepareSave());
+    IconDiskCache* cache = m_diskCache.get();
+    // 提交会解除旧映射，回到 GUI 线程进行：sourceImage() 的调用方都在 GUI 线程，提交时不会有人正在读映射
+    QtConcurrent::run(&m_workerPool, [cache, job]() { return cache->writeSave(*job); })
+        .then(qApp, [this, cache, job](bool written) {
+            QMutexLocker locker(&m_mutex);
+            m_flushRunning = false;
+            if (!written) {
+                return;
+            }
+            detachMappedFrames();
+            if (cache->commitSave(*job) && cache->isDirty()) {
+                scheduleDiskCacheFlush();
+            }
+        });
+}
+
+void IconRegistry::detachMappedFrames()
+{
+    int detached = 0;
+    for (QList<QImage>& frames : m_frames) {
+        for (QImage& frame : frames) {
+            if (m_diskCache->isMapped(frame)) {
+                frame = frame.copy();
+                ++detached;
+            }
+        }
+    }
+    qCDebug(lcIcon) << "[IconRegistry] 重写磁盘缓存前拷贝出仍在使用的映射帧:" << detached;
+}
+
+QString IconRegistry::normalizedKey(const QString& executablePath)
+{
+    return QDir::cleanPath(QFileInfo(executablePath).absoluteFilePath()).toLower();
+}
+
+QFuture<IconHandle> IconRegistry::acquireAsync(const QString& executablePath)
+{
+    const QFileInfo fileInfo(executablePath);
+    if (executablePath.isEmpty() || !fileInfo.exists()) {
+        return QtFuture::makeReadyValueFuture(InvalidIconHandle);
+    }
+    const QString key = normalizedKey(executablePath);
+    const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    const qint64 fileSize = fileInfo.size();
+
+    QMutexLocker locker(&m_mutex);
+    const IconHandle handle = cachedHandle(key, lastModified, fileSize);
+    if (handle != InvalidIconHandle) {
+        return QtFuture::makeReadyValueFuture(handle);
+    }
+    const auto inflight = m_inflight.constFind(key);
+    if (inflight != m_inflight.constEnd()) {
+        return *inflight; // 合并对同一路径的重复请求
+    }
+    const qreal dpr = currentDevicePixelRatio();
+    QFuture<IconHandle> future = QtConcurrent::run(&m_workerPool,
+        [this, executablePath, key, lastModified, fileSize, dpr]() {
+            const IconHandle resolved = resolve(executablePath, key, lastModified, fileSize, dpr);
+            QMutexLocker locker(&m_mutex);
+            m_inflight.remove(key);
+            return resolved;
+        });
+    m_inflight.insert(key, future);
+    return future;
+}
+
+IconHandle IconRegistry::cachedHandle(const QString& key, qint64 lastModified, qint64 fileSize) const
+{
+    const auto it = m_entries.constFind(key);
+    if (it != m_entries.constEnd() && it->lastModified == lastModified && it->fileSize == fileSize) {
+        return it->handle;
+    }
+    return InvalidIconHandle;
+}
+
+IconHandle IconRegistry::resolve(const QString& executablePath, const QString& key,
+                                 qint64 lastModified, qint64 fileSize, qreal dpr)
+{
+    Trace::Span span("icon.resolve");
+    span.attr("file", QFileInfo(executablePath).fileName());
+    {
+        // 磁盘缓存命中则直接登记包装映射内存的帧；查找与登记在同一次持锁内完成，期间映射不会被替换
+        QMutexLocker locker(&m_mutex);
+        const QList<QImage> cached = diskCache()->lookup(key, lastModified, fileSize, dpr);
+        if (!cached.isEmpty()) {
+            span.attr("from_disk_cache", true);
+            return registerFrames(executablePath, key, lastModified, fileSize, cached);
+        }
+    }
+    span.attr("from_disk_cache", false);
+    // 提取过程涉及文件读取与 Shell 调用，不持锁进行
+    const QList<QImage> frames = renderCacheFrames(extractIconImage(executablePath), dpr);
+
+    QMutexLocker locker(&m_mutex);
+    if (!frames.isEmpty()) {
+        diskCache()->insert(key, lastModified, fileSize, dpr, frames);
+        scheduleDiskCacheFlush();
+    }
+    return registerFrames(executablePath, key, lastModified, fileSize, frames);
+}
+
+IconHandle IconRegistry::registerFrames(const QString& executablePath, const QString& key,
+                                        qint64 lastModified, qint64 fileSize, const QList<QImage>& frames)
+{
+    Entry& entry = m_entries[key];
+    if (entry.handle != InvalidIconHandle) {
+        if (entry.lastModified == lastModified && entry.fileSize == fileSize) {
+            return entry.handle; // 其它线程已完成同一版本的提取
+        }
+        qCDebug(lcIcon) << "[IconRegistry] 可执行文件已更新，重新提取图标:" << executablePath;
+        m_frames.remove(entry.handle);
+        m_icons.remove(entry.handle);
+        // 变体存储只在 GUI 线程使用，本函数可能在图标工作线程中调用
+        const IconHandle retired = entry.handle;
+        QMetaObject::invokeMethod(qApp, [retired]() { IconVariantStore::instance().forget(retired); },
+                                  Qt::QueuedConnection);
+    }
+    entry.handle = m_nextHandle++;
+    entry.lastModified = lastModified;
+    entry.fileSize = fileSize;
+    m_frames.insert(entry.handle, frames);
+    return entry.handle;
+}
+
+QIcon IconRegistry::icon(IconHandle handle) const
+{
+    if (handle == InvalidIconHandle) {
+        return QIcon();
+    }
+    QMutexLocker locker(&m_mutex);
+    const auto cached = m_icons.constFind(handle);
+    if (cached != m_icons.constEnd()) {
+        return *cached;
+    }
+    const auto frames = m_frames.constFind(handle);
+    if (frames == m_frames.constEnd()) {
+        return QIcon();
+    }
+    // QPixmap 只能在 GUI 线程创建，因此图标在首次使用时才组装。
+    // 帧可能指向映射内存，先拷贝一次再移交给 QPixmap（同格式时不再转换），QPixmap 从不引用映射
+    QIcon icon;
+    for (const QImage& frame : *frames) {
+        icon.addPixmap(QPixmap::fromImage(frame.copy()));
+    }
+    m_icons.insert(handle, icon);
+    return icon;
+}
+
+QImage IconRegistry::sourceImage(IconHandle handle) const
+{
+    QMutexLocker locker(&m_mutex);
+    const auto frames = m_frames.constFind(handle);
+    if (frames == m_frames.constEnd() || frames->isEmpty()) {
+        return QImage();
+    }
+    return frames->last(); // 帧按尺寸从小到大排列
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QIcon>
+#include <QHash>
+#include <QMutex>
+#include <QImage>
+#include <QFuture>
+#include <QThreadPool>
+#include <memory>
+
+class IconDiskCache;
+
+// 图标句柄：指向 IconRegistry 中一份已解析图标的轻量标识，0 表示无图标
+using IconHandle = quint32;
+constexpr IconHandle InvalidIconHandle = 0;
+
+// =============================
+// 共享图标注册表
+// =============================
+// 每个 (可执行文件路径, 文件版本) 只提取一次图标，之后通过 IconHandle 共享。
+// 文件版本由修改时间和大小确定，可执行文件被替换后会得到新的句柄，
+// 因此句柄不同即代表图标可能不同，状态比较只需比较句柄。
+// 提取结果同时写入磁盘缓存（IconDiskCache），冷启动时直接从映射文件恢复，不再调用 Shell 提取。
+// 磁盘缓存命中的帧直接包装映射内存，不拷贝；QIcon 在 GUI 线程首次 icon() 时组装，每帧只拷贝一次进 QPixmap。
+// 缓存文件重写后的提交在 GUI 线程进行，提交前把仍引用旧映射的帧拷贝出来，
+// 因此 GUI 线程上取得的 sourceImage() 在当前事件处理内始终有效。
+// 提取全程只使用 QImage，可在任意线程进行。
+class IconRegistry
+{
+public:
+    static IconRegistry& instance();
+
+    /**
+     * @brief 异步获取图标句柄，提取在图标工作线程池中进行
+     * @param executablePath 可执行文件路径
+     * @return 已解析时返回立即完成的 future；同一路径正在提取时返回同一个 future（合并重复请求）
+     * @note 界面组件应先显示占位图标，future 完成后再用 icon() 替换
+     */
+    QFuture<IconHandle> acquireAsync(const QString& executablePath);
+    // 根据句柄取图标，句柄无效或提取失败时返回空图标（需在 GUI 线程调用）
+    QIcon icon(IconHandle handle) const;
+    // 句柄对应的最大一帧原始图像（供 IconVariantStore 生成各尺寸变体），无图标时返回空图像
+    // 可能直接引用磁盘缓存映射，只应在 GUI 线程使用且不跨事件保存
+    QImage sourceImage(IconHandle handle) const;
+    // 将新提取的图标写入磁盘缓存（通常由延迟定时器自动调用）；打包写文件在图标工作线程中进行，替换文件回到 GUI 线程
+    void flushDiskCache();
+
+private:
+    IconRegistry();
+    ~IconRegistry();
+    Q_DISABLE_COPY(IconRegistry)
+
+    struct Entry {
+        IconHandle handle = InvalidIconHandle;
+        qint64 lastModified = 0; // 毫秒时间戳
+        qint64 fileSize = 0;
+    };
+
+    static QString normalizedKey(const QString& executablePath);
+    static QString diskCacheFilePath();
+    IconDiskCache* diskCache(); // 需持有 m_mutex
+    void scheduleDiskCacheFlush(); // 需持有 m_mutex
+    // 内存命中则返回句柄，否则返回 InvalidIconHandle（需持有 m_mutex）
+    IconHandle cachedHandle(const QString& key, qint64 lastModified, qint64 fileSize) const;
+    // 查磁盘缓存或提取图标并登记，返回新句柄（不持锁调用）
+    IconHandle resolve(const QString& executablePath, const QString& key,
+                       qint64 lastModified, qint64 fileSize, qreal dpr);
+    // 为路径的当前版本登记帧并返回句柄（需持有 m_mutex）
+    IconHandle registerFrames(const QString& executablePath, const QString& key,
+                              qint64 lastModified, qint64 fileSize, const QList<QImage>& frames);
+    // 把仍引用磁盘缓存映射的帧拷贝出来，之后映射可被解除（需持有 m_mutex）
+    void detachMappedFrames();
+
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;             // 规范化路径 -> 当前版本
+    QHash<IconHandle, QList<QImage>> m_frames;   // 句柄 -> 各尺寸帧
+    mutable QHash<IconHandle, QIcon> m_icons;    // 句柄 -> 按需组装的图标
+    QHash<QString, QFuture<IconHandle>> m_inflight; // 正在提取的路径
+    IconHandle m_nextHandle = 1;
+    std::unique_ptr<IconDiskCache> m_diskCache; // 首次使用时打开
+    bool m_flushScheduled = false;
+    bool m_flushRunning = false; // 工作线程正在写回磁盘缓存
+    QThreadPool m_workerPool; // 图标提取线程（每个线程初始化一次 COM）
+};
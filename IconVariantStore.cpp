@@ -0,0 +1,100 @@
+#include "IconVariantStore.h"
+#include "AlphaBounds.h"
+#include <QDebug>
+#include <QPainter>
+
+// 不透明判定阈值，与原 AppCardWidget 裁剪逻辑一致
+static const int OPAQUE_ALPHA_THRESHOLD = 10;
+
+IconVariantStore& IconVariantStore::instance()
+{
+    static IconVariantStore store;
+    return store;
+}
+
+// 键布局：句柄 32 位 | 逻辑尺寸 16 位 | DPR 百分比 12 位 | 选项 4 位
+quint64 IconVariantStore::variantKey(IconHandle handle, int logicalSize, qreal dpr, Options options)
+{
+    const quint64 dprPercent = quint64(qBound(1, qRound(dpr * 100), 0xFFF));
+    return (quint64(handle) << 32) | (quint64(logicalSize & 0xFFFF) << 16) | (dprPercent << 4)
+           | quint64(options.toInt() & 0xF);
+}
+
+QPixmap IconVariantStore::pixmap(IconHandle handle, int logicalSize, qreal dpr, Options options)
+{
+    if (handle == InvalidIconHandle || logicalSize <= 0) {
+        return QPixmap();
+    }
+    const quint64 key = variantKey(handle, logicalSize, dpr, options);
+    const auto it = m_variants.constFind(key);
+    if (it != m_variants.constEnd()) {
+        return *it;
+    }
+
+    const QImage source = IconRegistry::instance().sourceImage(handle);
+    QPixmap variant;
+    if (!source.isNull()) {
+        // 裁剪矩形按句柄（即图标版本）只计算一次，各尺寸变体共用
+        const QRect content = options.testFlag(TrimTransparentBorder) ? contentRect(handle, source) : source.rect();
+        variant = QPixmap::fromImage(renderCentered(source, qRound(logicalSize * dpr), content));
+        variant.setDevicePixelRatio(dpr);
+    }
+    m_variants.insert(key, variant); // 无图标的句柄也记录，避免重复尝试
+    return variant;
+}
+
+QIcon IconVariantStore::icon(IconHandle handle, int logicalSize, qreal dpr, Options options)
+{
+    const QPixmap variant = pixmap(handle, logicalSize, dpr, options);
+    return variant.isNull() ? QIcon() : QIcon(variant);
+}
+
+void IconVariantStore::forget(IconHandle handle)
+{
+    m_variants.removeIf([handle](const QHash<quint64, QPixmap>::iterator& it) {
+        return IconHandle(it.key() >> 32) == handle; // 见 variantKey 的键布局
+    });
+    m_contentRects.remove(handle);
+}
+
+QRect IconVariantStore::opaqueBounds(const QImage& image)
+{
+    const QImage argb = image.format() == QImage::Format_ARGB32 || image.format() == QImage::Format_ARGB32_Premultiplied
+        ? image : image.convertToFormat(QImage::Format_ARGB32);
+    const AlphaBounds::Rect bounds = AlphaBounds::opaqueBounds(reinterpret_cast<const quint32*>(argb.constBits()),
+                                                               argb.width(), argb.height(), argb.bytesPerLine(),
+                                                               OPAQUE_ALPHA_THRESHOLD);
+    if (bounds.isEmpty()) return QRect(0, 0, 1, 1);
+    return QRect(QPoint(bounds.left, bounds.top), QPoint(bounds.right, bounds.bottom));
+}
+
+QRect IconVariantStore::contentRect(IconHandle handle, const QImage& source)
+{
+    const auto it = m_contentRects.constFind(handle);
+    if (it != m_contentRects.constEnd()) {
+        return *it;
+    }
+    const QRect rect = opaqueBounds(source);
+    m_contentRects.insert(handle, rect);
+    return rect;
+}
+
+QImage IconVariantStore::renderCentered(const QImage& source, int side, Options options)
+{
+    return renderCentered(source, side, options.testFlag(TrimTransparentBorder) ? opaqueBounds(source) : source.rect());
+}
+
+QImage IconVariantStore::renderCentered(const QImage& source, int side, const QRect& contentArea)
+{
+    QImage canvas(side, side, QImage::Format_ARGB32_Premultiplied);
+    canvas.fill(Qt::transparent);
+    if (source.isNull() || side <= 0) {
+        return canvas;
+    }
+    const QImage content = contentArea == source.rect() ? source : source.copy(contentArea);
+    const QImage scaled = content.scaled(side, side, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QPainter painter(&canvas);
+    painter.drawImage((side - scaled.width()) / 2, (side - scaled.height()) / 2, scaled);
+    painter.end();
+    return canvas;
+}
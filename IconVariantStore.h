@@ -0,0 +1,63 @@
+#pragma once
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include "IconRegistry.h"
+
+// =============================
+// 图标变体存储
+// =============================
+// 同一图标按界面实际使用的逻辑尺寸与设备像素比预先缩放成 QPixmap，
+// 以 (句柄, 逻辑尺寸, DPR, 选项) 为键缓存，由 Dock 卡片、悬停图标和状态栏共享。
+// 句柄随可执行文件版本变化，因此变体天然按图标版本生成一次；重建 Dock 时只做查表。
+// 可执行文件更新后旧句柄由 IconRegistry 通过 forget() 释放，长期运行时不会累积旧版本的变体。
+// 仅在 GUI 线程使用（QPixmap 限制）。
+class IconVariantStore
+{
+public:
+    enum Option {
+        Plain = 0x0,
+        TrimTransparentBorder = 0x1 // 先裁掉透明边距再缩放，使不同图标的可见内容大小一致
+    };
+    Q_DECLARE_FLAGS(Options, Option)
+
+    static IconVariantStore& instance();
+
+    /**
+     * @brief 取图标在指定逻辑尺寸下的变体，首次请求时生成
+     * @param handle 图标句柄
+     * @param logicalSize 逻辑像素边长
+     * @param dpr 设备像素比（通常为 widget->devicePixelRatioF()）
+     * @param options 生成选项
+     * @return 透明底、内容居中的正方形 QPixmap（已设置 devicePixelRatio）；句柄无效或无图标时返回空
+     */
+    QPixmap pixmap(IconHandle handle, int logicalSize, qreal dpr, Options options = Plain);
+    // 只含单个变体的 QIcon，供 QAbstractButton::setIcon 使用，绘制时无需再缩放
+    QIcon icon(IconHandle handle, int logicalSize, qreal dpr, Options options = Plain);
+    // 丢弃句柄的全部变体与裁剪矩形（句柄已被新版本取代时调用）
+    void forget(IconHandle handle);
+
+    /**
+     * @brief 计算图像中不透明内容的包围矩形（alpha > 10 视为不透明），使用 AlphaBounds 向量化实现
+     * @return 全透明时返回 QRect(0, 0, 1, 1)
+     */
+    static QRect opaqueBounds(const QImage& image);
+    // 缩放并居中到 side x side 的透明画布（设备像素）
+    static QImage renderCentered(const QImage& source, int side, Options options);
+    static QImage renderCentered(const QImage& source, int side, const QRect& contentArea);
+
+private:
+    IconVariantStore() = default;
+    Q_DISABLE_COPY(IconVariantStore)
+
+    static quint64 variantKey(IconHandle handle, int logicalSize, qreal dpr, Options options);
+    // 句柄对应源图像的不透明内容矩形（缓存）
+    QRect contentRect(IconHandle handle, const QImage& source);
+
+    QHash<quint64, QPixmap> m_variants;
+    QHash<IconHandle, QRect> m_contentRects;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(IconVariantStore::Options)
@@ -4,8 +4,10 @@
 #include "UserModeModule.h"
 #include "UserView.h"
 #include "AdminDashboardView.h"
+#include "UiHealthOverlay.h"
 #include <QStackedWidget>
 #include <QScreen>
+#include <QShortcut>
 #include <QGuiApplication>
 #include <QApplication>
 #include <QDebug>
@@ -21,6 +23,7 @@ JianqiaoCoreShell::JianqiaoCoreShell(QWidget *parent)
     , m_userViewInstance(nullptr)
     , m_adminDashboardInstance(nullptr)
     , m_mainStackedWidget(nullptr)
+    , m_healthOverlay(nullptr)
     , m_currentMode(OperatingMode::UserMode)
 {
     qDebug() << "剑鞘核心(JianqiaoCoreShell): 构造函数开始。";
@@ -42,7 +45,6 @@ void JianqiaoCoreShell::initializeCoreApplication()
     qDebug() << "剑鞘核心(JianqiaoCoreShell): 初始化核心应用设置。";
     this->setWindowFlags(Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint | Qt::Tool);
     this->setAttribute(Qt::WA_TranslucentBackground, false);
-    this->setStyleSheet("QMainWindow { background-color: #222222; }");
 
     m_systemInteractionModule = new SystemInteractionModule(this);
     
@@ -69,6 +71,10 @@ void JianqiaoCoreShell::setupUi()
 
     setCentralWidget(m_mainStackedWidget);
 
+    m_healthOverlay = new UiHealthOverlay(this);
+    QShortcut *healthOverlayShortcut = new QShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_F12), this);
+    connect(healthOverlayShortcut, &QShortcut::activated, this, &JianqiaoCoreShell::toggleHealthOverlay);
+
     qDebug() << "剑鞘核心外壳: UI设置完成 (QStackedWidget), 视图实例已创建。";
 }
 
@@ -111,7 +117,7 @@ void JianqiaoCoreShell::switchToUserModeView()
     } else {
         qWarning() << "JianqiaoCoreShell: AdminModule or UserModeModule is null. UserModeModule may load from its own config.";
         if (m_userModeModule) {
-            m_userModeModule->loadConfiguration(); // Fallback to loading from file if direct sync is not possible
+            m_userModeModule->loadConfiguration(); // Fallback to ConfigStore if direct sync is not possible
         }
     }
 
@@ -266,6 +272,22 @@ void JianqiaoCoreShell::onAdminRequestsExitAdminMode() {
     switchToUserModeView(); // Centralized method to switch to user mode
 }
 
+void JianqiaoCoreShell::toggleHealthOverlay() {
+    if (!m_healthOverlay) {
+        return;
+    }
+    if (m_healthOverlay->isVisible()) {
+        m_healthOverlay->hide();
+        qDebug() << "剑鞘核心(JianqiaoCoreShell): 已关闭健康监视浮层。";
+        return;
+    }
+    if (m_currentMode != OperatingMode::AdminModeActive) {
+        return; // 用户模式下不响应打开请求
+    }
+    m_healthOverlay->show();
+    qDebug() << "剑鞘核心(JianqiaoCoreShell): 已打开健康监视浮层。";
+}
+
 // void JianqiaoCoreShell::onAdminLoginSuccessful() {
 //     // ... 已废弃的槽函数 ...
 // } 
\ No newline at end of file
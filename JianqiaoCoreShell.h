@@ -10,6 +10,7 @@ class AdminModule;             // Forward declaration
 class UserModeModule;          // Forward declaration for UserModeModule
 class UserView;                // Forward declaration for UserView, if UserModeModule's view is managed by CoreShell
 class AdminDashboardView;       // Added Forward declaration
+class UiHealthOverlay;
 
 class JianqiaoCoreShell : public QMainWindow
 {
@@ -60,11 +61,14 @@ protected: // QWidget's event is protected
     AdminDashboardView *m_adminDashboardInstance; // Added
 
     QStackedWidget *m_mainStackedWidget; // Added
+    UiHealthOverlay *m_healthOverlay; // 隐藏的健康监视浮层（Ctrl+Shift+F12）
 
     OperatingMode m_currentMode;
 
 private slots:
     void onAdminRequestsExitAdminMode();
+    // 切换 GUI 线程健康浮层：只能在管理员模式下打开，打开后切回用户模式仍保持显示，任意模式下可关闭
+    void toggleHealthOverlay();
 };
 
 #endif // JIANQIAOCORESHELL_H 
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include "LaunchController.h"
+#include "LogCategories.h"
+#include "SystemInteractionModule.h"
+#include "Trace.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QtConcurrent/QtConcurrentRun>
+
+static constexpr int PREFLIGHT_TIMEOUT_MS = 15000;
+static constexpr int START_TIMEOUT_MS = 10000;
+// 与原界面加载动画的超时一致
+static constexpr int WINDOW_TIMEOUT_MS = 30000;
+static constexpr int TERMINATE_WAIT_MS = 1000;
+static constexpr qint64 PREFLIGHT_READ_BYTES = 4096;
+
+// 在工作线程检查可执行文件，返回错误描述（成功时为空）。
+// 读取文件头会让休眠的磁盘转起来、映像进入文件缓存，随后在 GUI 线程调用的 CreateProcess 不再等待磁盘。
+static QString preflightExecutable(const QString& path)
+{
+    Trace::Span span("launch.preflight");
+    span.attr("file", QFileInfo(path).fileName());
+    QFile file(path);
+    if (!file.exists()) {
+        return QStringLiteral("可执行文件不存在: %1").arg(path);
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QStringLiteral("无法读取可执行文件: %1").arg(file.errorString());
+    }
+    const QByteArray header = file.read(PREFLIGHT_READ_BYTES);
+    if (path.endsWith(QStringLiteral(".exe"), Qt::CaseInsensitive) && !header.startsWith("MZ")) {
+        return QStringLiteral("不是有效的可执行文件: %1").arg(path);
+    }
+    return QString();
+}
+
+// 白名单路径是启动器（主程序名提示指向另一个可执行文件）时，启动器退出不代表启动失败
+static bool isLauncher(const AppInfo& app)
+{
+    return !app.mainExecutableHint.isEmpty()
+           && app.mainExecutableHint.compare(QFileInfo(app.path).fileName(), Qt::CaseInsensitive) != 0;
+}
+
+static QString timeoutMessage(LaunchController::State state)
+{
+    switch (state) {
+    case LaunchController::State::Queued:
+        return QStringLiteral("读取可执行文件超时（磁盘无响应）");
+    case LaunchController::State::Starting:
+        return QStringLiteral("进程启动超时");
+    default:
+        return QStringLiteral("等待应用窗口超时");
+    }
+}
+
+LaunchController::LaunchController(SystemInteractionModule* systemInteraction, QObject* parent)
+    : QObject(parent)
+    , m_systemInteraction(systemInteraction)
+{
+    m_preflightPool.setMaxThreadCount(2);
+    m_deadlineTimer.setSingleShot(true);
+    connect(&m_deadlineTimer, &QTimer::timeout, this, &LaunchController::onDeadlineTimer);
+    if (m_systemInteraction) {
+        connect(m_systemInteraction, &SystemInteractionModule::applicationActivated, this, &LaunchController::onApplicationActivated);
+        connect(m_systemInteraction, &SystemInteractionModule::applicationActivationFailed, this, &LaunchController::onApplicationActivationFailed);
+    }
+}
+
+bool LaunchController::isInFlight(State state)
+{
+    return state == State::Queued || state == State::Starting || state == State::Started || state == State::AwaitingWindow;
+}
+
+LaunchController::State LaunchController::state(const QString& appPath) const
+{
+    const auto it = m_launches.constFind(appPath);
+    return it == m_launches.constEnd() ? State::Idle : it->state;
+}
+
+LaunchController::Launch* LaunchController::findLaunch(const QString& appPath)
+{
+    const auto it = m_launches.find(appPath);
+    return it == m_launches.end() ? nullptr : &*it;
+}
+
+void LaunchController::launch(const AppInfo& app)
+{
+    if (app.path.isEmpty()) {
+        qCWarning(lcMonitor) << "[LaunchController] 应用路径为空，无法启动";
+        return;
+    }
+    const QString appPath = app.path; // app 可能引用调用方的列表，状态信号处理中可能被改动
+    Launch& launch = m_launches[appPath];
+    if (isInFlight(launch.state)) {
+        qCDebug(lcMonitor) << "[LaunchController]" << app.name << "正在启动中（" << launch.state << "），忽略重复请求";
+        return;
+    }
+    launch.app = app;
+    if (launch.process && launch.process->state() == QProcess::Running) {
+        qCInfo(lcMonitor) << "[LaunchController]" << app.name << "进程仍在运行，重新激活其窗口";
+        requestWindow(appPath, 0, true);
+        return;
+    }
+    qCInfo(lcMonitor) << "[LaunchController] 启动" << app.name << "(" << appPath << ")";
+    ++launch.generation;
+    setState(appPath, State::Queued);
+    if (state(appPath) == State::Queued) { // 状态信号处理中可能已被取消
+        startPreflight(appPath);
+    }
+}
+
+void LaunchController::setState(const QString& appPath, State state, const QString& detail)
+{
+    Launch* launch = findLaunch(appPath);
+    if (!launch) {
+        return;
+    }
+    const State previous = launch->state;
+    const quint64 traceId = qHash(appPath);
+    if (!isInFlight(previous) && isInFlight(state)) {
+        Trace::asyncBegin("app.launch", traceId);
+    } else if (isInFlight(previous) && !isInFlight(state)) {
+        Trace::asyncEnd("app.launch", traceId);
+    }
+    launch->state = state;
+    const int timeoutMs = timeoutFor(state);
+    launch->deadline = timeoutMs < 0 ? QDeadlineTimer(QDeadlineTimer::Forever) : QDeadlineTimer(timeoutMs);
+    qCDebug(lcMonitor) << "[LaunchController]" << launch->app.name << previous << "->" << state << detail;
+    rescheduleDeadlines();
+    // 处理者可能增删 m_launches，此后不再引用 launch
+    emit stateChanged(appPath, state, detail);
+}
+
+void LaunchController::fail(const QString& appPath, const QString& error)
+{
+    const Launch* launch = findLaunch(appPath);
+    if (!launch) {
+        return;
+    }
+    qCWarning(lcMonitor) << "[LaunchController] 启动失败:" << launch->app.name << "(" << appPath << ")" << error;
+    if (launch->state == State::AwaitingWindow && m_systemInteraction) {
+        m_systemInteraction->stopMonitoringProcess(appPath);
+    }
+    setState(appPath, State::Failed, error);
+}
+
+// ========== 预检 ========== //
+
+void LaunchController::startPreflight(const QString& appPath)
+{
+    const Launch* launch = findLaunch(appPath);
+    if (!launch) {
+        return;
+    }
+    const quint64 generation = launch->generation;
+    QtConcurrent::run(&m_preflightPool, preflightExecutable, appPath)
+        .then(this, [this, appPath, generation](const QString& error) { onPreflightFinished(appPath, generation, error); });
+}
+
+void LaunchController::onPreflightFinished(const QString& appPath, quint64 generation, const QString& error)
+{
+    auto it = m_launches.find(appPath);
+    if (it == m_launches.end() || it->generation != generation || it->state != State::Queued) {
+        return; // 已超时或已被新的请求取代
+    }
+    if (!error.isEmpty()) {
+        fail(appPath, error);
+        return;
+    }
+    startProcess(appPath);
+}
+
+// ========== 进程 ========== //
+
+void LaunchController::startProcess(const QString& appPath)
+{
+    setState(appPath, State::Starting);
+    Launch* launch = findLaunch(appPath);
+    if (!launch || launch->state != State::Starting) {
+        return; // 状态信号处理中已被取消
+    }
+    QProcess* process = new QProcess(this);
+    launch->process = process;
+    connect(process, &QProcess::started, this, [this, appPath, process]() { onProcessStarted(appPath, process); });
+    connect(process, &QProcess::errorOccurred, this, [this, appPath, process](QProcess::ProcessError error) {
+        onProcessError(appPath, process, error);
+    });
+    connect(process, &QProcess::finished, this, [this, appPath, process](int exitCode, QProcess::ExitStatus exitStatus) {
+        onProcessFinished(appPath, process, exitCode, exitStatus);
+    });
+    process->setProgram(appPath);
+    process->start(); // 结果由 started / errorOccurred 送达（可能在 start 返回前同步发出）
+}
+
+void LaunchController::onProcessStarted(const QString& appPath, QProcess* process)
+{
+    auto it = m_launches.find(appPath);
+    if (it == m_launches.end() || it->process != process || it->state != State::Starting) {
+        return;
+    }
+    const quint32 pid = static_cast<quint32>(process->processId());
+    qCInfo(lcMonitor) << "[LaunchController]" << it->app.name << "进程已创建，PID:" << pid;
+    setState(appPath, State::Started);
+    if (state(appPath) == State::Started) {
+        requestWindow(appPath, pid, false);
+    }
+}
+
+void LaunchController::onProcessError(const QString& appPath, QProcess* process, QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart) {
+        // 运行期错误（崩溃等）随后由 finished 处理
+        qCWarning(lcMonitor) << "[LaunchController] 进程错误:" << appPath << error << process->errorString();
+        return;
+    }
+    process->deleteLater();
+    auto it = m_launches.find(appPath);
+    if (it == m_launches.end() || it->process != process) {
+        return;
+    }
+    it->process = nullptr;
+    if (it->state == State::Starting) {
+        fail(appPath, process->errorString());
+    }
+}
+
+void LaunchController::onProcessFinished(const QString& appPath, QProcess* process, int exitCode, QProcess::ExitStatus exitStatus)
+{
+    process->deleteLater();
+    auto it = m_launches.find(appPath);
+    if (it == m_launches.end() || it->process != process) {
+        return;
+    }
+    it->process = nullptr;
+    qCInfo(lcMonitor) << "[LaunchController]" << it->app.name << "进程已退出，退出码:" << exitCode << "状态:" << exitStatus;
+    switch (it->state) {
+    case State::Starting:
+    case State::Started:
+        fail(appPath, QStringLiteral("进程在创建窗口前已退出（退出码 %1）").arg(exitCode));
+        break;
+    case State::AwaitingWindow:
+        if (isLauncher(it->app)) {
+            qCDebug(lcMonitor) << "[LaunchController] 启动器已退出，继续等待主程序" << it->app.mainExecutableHint << "的窗口";
+        } else {
+            fail(appPath, QStringLiteral("进程在创建窗口前已退出（退出码 %1）").arg(exitCode));
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// ========== 窗口激活 ========== //
+
+void LaunchController::requestWindow(const QString& appPath, quint32 pid, bool reactivateOnly)
+{
+    if (!m_systemInteraction) {
+        fail(appPath, QStringLiteral("系统交互模块不可用，无法激活窗口"));
+        return;
+    }
+    const Launch* launch = findLaunch(appPath);
+    if (!launch) {
+        return;
+    }
+    const AppInfo app = launch->app; // 发出状态信号后不再引用 launch
+    m_systemInteraction->setSmartTopmostEnabled(app.smartTopmost);
+    m_systemInteraction->setForceTopmostEnabled(app.forceTopmost);
+    // 窗口已存在时 monitorAndActivateApplication 可能同步发出激活信号，因此先进入 AwaitingWindow
+    setState(appPath, State::AwaitingWindow);
+    if (state(appPath) != State::AwaitingWindow) {
+        return; // 状态信号处理中已被取消
+    }
+    m_systemInteraction->monitorAndActivateApplication(app.path, pid, app.mainExecutableHint, app.windowFindingHints, reactivateOnly);
+}
+
+void LaunchController::onApplicationActivated(const QString& appPath)
+{
+    auto it = m_launches.find(appPath);
+    if (it != m_launches.end() && it->state == State::AwaitingWindow) {
+        setState(appPath, State::Activated);
+    }
+}
+
+void LaunchController::onApplicationActivationFailed(const QString& appPath, const QString& reason)
+{
+    auto it = m_launches.find(appPath);
+    if (it != m_launches.end() && it->state == State::AwaitingWindow) {
+        fail(appPath, reason);
+    }
+}
+
+// ========== 超时调度 ========== //
+
+int LaunchController::timeoutFor(State state)
+{
+    switch (state) {
+    case State::Queued:
+        return PREFLIGHT_TIMEOUT_MS;
+    case State::Starting:
+        return START_TIMEOUT_MS;
+    case State::Started:        // 同一轮事件中即转入 AwaitingWindow
+    case State::AwaitingWindow:
+        return WINDOW_TIMEOUT_MS;
+    default:
+        return -1;
+    }
+}
+
+void LaunchController::rescheduleDeadlines()
+{
+    qint64 nearestMs = -1;
+    for (const Launch& launch : qAsConst(m_launches)) {
+        if (launch.deadline.isForever()) {
+            continue;
+        }
+        const qint64 remainingMs = launch.deadline.remainingTime();
+        if (nearestMs < 0 || remainingMs < nearestMs) {
+            nearestMs = remainingMs;
+        }
+    }
+    if (nearestMs < 0) {
+        m_deadlineTimer.stop();
+    } else {
+        m_deadlineTimer.start(int(nearestMs));
+    }
+}
+
+void LaunchController::onDeadlineTimer()
+{
+    QStringList expired;
+    for (auto it = m_launches.cbegin(); it != m_launches.cend(); ++it) {
+        if (!it->deadline.isForever() && it->deadline.hasExpired()) {
+            expired.append(it.key());
+        }
+    }
+    for (const QString& appPath : qAsConst(expired)) {
+        // 前一个 fail 的信号处理可能已重新启动或移除该记录，逐个重新确认
+        Launch* launch = findLaunch(appPath);
+        if (!launch || !isInFlight(launch->state) || !launch->deadline.hasExpired()) {
+            continue;
+        }
+        const State expiredState = launch->state;
+        if (expiredState == State::Starting && launch->process) {
+            // 卡在创建阶段的进程直接放弃
+            QProcess* process = launch->process;
+            launch->process = nullptr;
+            process->disconnect(this);
+            process->kill();
+            process->deleteLater();
+        }
+        fail(appPath, timeoutMessage(expiredState));
+    }
+    rescheduleDeadlines();
+}
+
+// ========== 退出 ========== //
+
+void LaunchController::terminateAll()
+{
+    qCInfo(lcMonitor) << "[LaunchController] 终止所有已启动的进程";
+    // fail 发出的信号可能改动 m_launches，不能边遍历边发信号
+    const QStringList appPaths = m_launches.keys();
+    for (const QString& appPath : appPaths) {
+        if (isInFlight(state(appPath))) {
+            fail(appPath, QStringLiteral("启动已取消"));
+        }
+        Launch* launch = findLaunch(appPath);
+        if (!launch) {
+            continue;
+        }
+        QProcess* process = launch->process;
+        launch->process = nullptr;
+        if (!process) {
+            continue;
+        }
+        process->disconnect(this);
+        if (process->state() != QProcess::NotRunning) {
+            process->terminate();
+            if (!process->waitForFinished(TERMINATE_WAIT_MS)) {
+                process->kill();
+                qCInfo(lcMonitor) << "[LaunchController] 已强制结束" << appPath;
+            } else {
+                qCInfo(lcMonitor) << "[LaunchController] 已正常结束" << appPath;
+            }
+        }
+        process->deleteLater();
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include "common_types.h"
+
+class SystemInteractionModule;
+
+// =============================
+// 应用启动状态机
+// =============================
+// 每个应用（以 path 标识）的启动过程依次经过：
+//   Queued         已受理；工作线程预检可执行文件（存在性、读取文件头），顺带唤醒休眠的磁盘、预热文件缓存
+//   Starting       已调用 QProcess::start，等待 started / errorOccurred
+//   Started        进程已创建
+//   AwaitingWindow 已交给 SystemInteractionModule 查找并激活主窗口
+//   Activated      窗口已激活（终态）
+//   Failed         任一阶段出错或超时（终态）
+// 状态只由信号推进（预检结果、QProcess 信号、窗口激活信号），GUI 线程上没有任何等待。
+// 各阶段的超时由同一个调度定时器统一处理：它总是对准最早到期的截止时间，到期的启动转入 Failed。
+// 进程仍在运行时再次请求启动，直接进入 AwaitingWindow 重新激活其窗口。
+// 每次状态变化都发出 stateChanged，界面据此切换加载动画、状态栏与错误提示。
+// stateChanged 的处理者可能重入本控制器（再次启动、退出时 terminateAll），m_launches 随之增删，
+// 因此内部一律以路径传递启动记录，发出信号后重新查找并确认状态，不跨 emit 持有引用。
+// 仅在 GUI 线程使用。
+class LaunchController : public QObject
+{
+    Q_OBJECT
+public:
+    enum class State {
+        Idle,            // 没有启动记录
+        Queued,
+        Starting,
+        Started,
+        AwaitingWindow,
+        Activated,
+        Failed,
+    };
+    Q_ENUM(State)
+
+    explicit LaunchController(SystemInteractionModule* systemInteraction, QObject* parent = nullptr);
+
+    /**
+     * @brief 请求启动应用；应用已在启动流程中时忽略，进程仍在运行时改为重新激活其窗口
+     * @param app 白名单应用（使用 path、mainExecutableHint、windowFindingHints 与置顶策略）
+     */
+    void launch(const AppInfo& app);
+    State state(const QString& appPath) const;
+    // 是否处于 Queued ~ AwaitingWindow 之间
+    static bool isInFlight(State state);
+    /**
+     * @brief 终止所有由本控制器启动且仍在运行的进程，未完成的启动一并取消
+     * @note 仅在退出流程中调用：每个进程最多等待 1 秒正常结束，之后强制结束
+     */
+    void terminateAll();
+
+signals:
+    /**
+     * @brief 启动状态变化
+     * @param appPath 应用路径
+     * @param state 新状态
+     * @param detail 附加说明（Failed 时为错误描述，其余为空）
+     */
+    void stateChanged(const QString& appPath, LaunchController::State state, const QString& detail);
+
+private:
+    struct Launch {
+        AppInfo app;
+        State state = State::Idle;
+        QProcess* process = nullptr;   // 进程结束后置空
+        quint64 generation = 0;        // 每次进入 Queued 递增，丢弃过期的预检结果
+        QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever);
+    };
+
+    // 不存在时返回 nullptr；指针只在下一次 emit 之前有效
+    Launch* findLaunch(const QString& appPath);
+    // 以下 appPath 须为调用方自有的副本，不能引用 m_launches 内的数据
+    void setState(const QString& appPath, State state, const QString& detail = QString());
+    void fail(const QString& appPath, const QString& error);
+    void startPreflight(const QString& appPath);
+    void onPreflightFinished(const QString& appPath, quint64 generation, const QString& error);
+    void startProcess(const QString& appPath);
+    void onProcessStarted(const QString& appPath, QProcess* process);
+    void onProcessError(const QString& appPath, QProcess* process, QProcess::ProcessError error);
+    void onProcessFinished(const QString& appPath, QProcess* process, int exitCode, QProcess::ExitStatus exitStatus);
+    // 把窗口查找交给 SystemInteractionModule；reactivateOnly 为 true 时只激活已有窗口
+    void requestWindow(const QString& appPath, quint32 pid, bool reactivateOnly);
+    void onApplicationActivated(const QString& appPath);
+    void onApplicationActivationFailed(const QString& appPath, const QString& reason);
+
+    // ==== 超时调度 ====
+    // 各状态的超时（毫秒），没有超时的状态返回 -1
+    static int timeoutFor(State state);
+    void rescheduleDeadlines();
+    void onDeadlineTimer();
+
+    SystemInteractionModule* m_systemInteraction;
+    QHash<QString, Launch> m_launches;   // 应用路径 -> 启动记录
+    QThreadPool m_preflightPool;         // 预检线程（磁盘唤醒可能阻塞数秒）
+    QTimer m_deadlineTimer;              // 单次触发，对准最早的截止时间
+};
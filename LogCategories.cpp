@@ -0,0 +1,93 @@
+#include "LogCategories.h"
+#include <QStringList>
+#include <algorithm>
+#include <iterator>
+
+Q_LOGGING_CATEGORY(lcHook, "jianqiao.hook")
+Q_LOGGING_CATEGORY(lcEnum, "jianqiao.enum")
+Q_LOGGING_CATEGORY(lcMonitor, "jianqiao.monitor")
+Q_LOGGING_CATEGORY(lcUi, "jianqiao.ui")
+Q_LOGGING_CATEGORY(lcConfig, "jianqiao.config")
+Q_LOGGING_CATEGORY(lcIcon, "jianqiao.icon")
+
+Q_LOGGING_CATEGORY(lcHookTrace, "jianqiao.hook.trace")
+Q_LOGGING_CATEGORY(lcEnumTrace, "jianqiao.enum.trace")
+Q_LOGGING_CATEGORY(lcMonitorTrace, "jianqiao.monitor.trace")
+Q_LOGGING_CATEGORY(lcUiTrace, "jianqiao.ui.trace")
+Q_LOGGING_CATEGORY(lcConfigTrace, "jianqiao.config.trace")
+Q_LOGGING_CATEGORY(lcIconTrace, "jianqiao.icon.trace")
+
+namespace {
+
+// 级别从低到高，数值越小输出越多
+enum class Level { Trace, Debug, Info, Warning, Critical, Off };
+
+const char* const SUBSYSTEMS[] = {"hook", "enum", "monitor", "ui", "config", "icon"};
+
+bool parseLevel(const QString& text, Level* level)
+{
+    static const struct { const char* name; Level level; } LEVELS[] = {
+        {"trace", Level::Trace}, {"debug", Level::Debug}, {"info", Level::Info},
+        {"warning", Level::Warning}, {"critical", Level::Critical}, {"off", Level::Off},
+    };
+    for (const auto& entry : LEVELS) {
+        if (text.compare(QLatin1String(entry.name), Qt::CaseInsensitive) == 0) {
+            *level = entry.level;
+            return true;
+        }
+    }
+    return false;
+}
+
+QString boolText(bool value)
+{
+    return value ? QStringLiteral("true") : QStringLiteral("false");
+}
+
+// 生成一个分类在指定级别下的过滤规则
+void appendRules(QStringList& rules, const QString& category, Level level)
+{
+    rules << QStringLiteral("%1.debug=%2").arg(category, boolText(level <= Level::Debug))
+          << QStringLiteral("%1.info=%2").arg(category, boolText(level <= Level::Info))
+          << QStringLiteral("%1.warning=%2").arg(category, boolText(level <= Level::Warning))
+          << QStringLiteral("%1.critical=%2").arg(category, boolText(level <= Level::Critical));
+}
+
+} // namespace
+
+namespace LogCategories {
+
+void applyLevels(const QJsonObject& logging)
+{
+    Level defaultLevel = Level::Debug;
+    const QString defaultText = logging.value("default").toString();
+    if (!defaultText.isEmpty() && !parseLevel(defaultText, &defaultLevel)) {
+        qWarning() << "[LogCategories] 未知的默认日志级别:" << defaultText;
+    }
+
+    for (auto it = logging.constBegin(); it != logging.constEnd(); ++it) {
+        if (it.key() == QLatin1String("default")) continue;
+        if (std::find_if(std::begin(SUBSYSTEMS), std::end(SUBSYSTEMS),
+                         [&](const char* name) { return it.key() == QLatin1String(name); }) == std::end(SUBSYSTEMS)) {
+            qWarning() << "[LogCategories] 未知的日志子系统:" << it.key();
+        }
+    }
+
+    QStringList rules;
+    // 裸 qDebug() 使用 "default" 分类；trace 对它没有意义，按 debug 处理
+    appendRules(rules, QStringLiteral("default"), qMax(defaultLevel, Level::Debug));
+    for (const char* subsystem : SUBSYSTEMS) {
+        Level level = defaultLevel;
+        const QString text = logging.value(QLatin1String(subsystem)).toString();
+        if (!text.isEmpty() && !parseLevel(text, &level)) {
+            qWarning() << "[LogCategories] 子系统" << subsystem << "的日志级别无效:" << text;
+            level = defaultLevel;
+        }
+        const QString category = QStringLiteral("jianqiao.%1").arg(QLatin1String(subsystem));
+        appendRules(rules, category, level);
+        appendRules(rules, category + QStringLiteral(".trace"), level == Level::Trace ? Level::Debug : Level::Off);
+    }
+    QLoggingCategory::setFilterRules(rules.join('\n'));
+}
+
+} // namespace LogCategories
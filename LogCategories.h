@@ -0,0 +1,46 @@
+#pragma once
+#include <QJsonObject>
+#include <QLoggingCategory>
+
+// =============================
+// 日志分类
+// =============================
+// 各子系统使用独立的日志分类：qCDebug(lcHook) << ...; 级别由 config.json 的 "logging" 节在运行时控制：
+//   "logging": { "default": "debug", "enum": "trace", "hook": "info" }
+// 可用级别依次为 trace、debug、info、warning、critical、off；"default" 作用于未单独配置的子系统和裸 qDebug()。
+// 分类开关由 QLoggingCategory 维护，输出点只读一个布尔标志，关闭的分类不会格式化消息，
+// 因此可在现场只为一个子系统打开详细日志而不拖慢其它子系统。
+//
+// 热路径（逐个枚举窗口、逐次按键、逐次布局）使用 qCTrace：只有定义了 JIANQIAO_TRACE_ENABLED
+// （Debug 构建，或 CMake 选项 JIANQIAO_ENABLE_TRACE=ON 的诊断构建）时才会编译进程序，
+// 发布构建中整条语句连同参数求值一并消除。编译进来时仍需在配置中将子系统级别设为 trace 才会输出。
+Q_DECLARE_LOGGING_CATEGORY(lcHook)      // 键盘钩子与热键
+Q_DECLARE_LOGGING_CATEGORY(lcEnum)      // 窗口枚举与主窗口查找
+Q_DECLARE_LOGGING_CATEGORY(lcMonitor)   // 进程/窗口监控与应用状态
+Q_DECLARE_LOGGING_CATEGORY(lcUi)        // 界面与布局
+Q_DECLARE_LOGGING_CATEGORY(lcConfig)    // 配置读写
+Q_DECLARE_LOGGING_CATEGORY(lcIcon)      // 图标提取与缓存
+
+// 各子系统的 trace 级别分类（名称为 "<子系统>.trace"），仅由 qCTrace 使用
+Q_DECLARE_LOGGING_CATEGORY(lcHookTrace)
+Q_DECLARE_LOGGING_CATEGORY(lcEnumTrace)
+Q_DECLARE_LOGGING_CATEGORY(lcMonitorTrace)
+Q_DECLARE_LOGGING_CATEGORY(lcUiTrace)
+Q_DECLARE_LOGGING_CATEGORY(lcConfigTrace)
+Q_DECLARE_LOGGING_CATEGORY(lcIconTrace)
+
+#ifdef JIANQIAO_TRACE_ENABLED
+#define qCTrace(category) qCDebug(category##Trace)
+#else
+#define qCTrace(category) while (false) QMessageLogger().noDebug()
+#endif
+
+namespace LogCategories {
+
+/**
+ * @brief 按配置中的 "logging" 节设置各分类的输出级别，可在运行时重复调用
+ * @param logging 形如 {"default": "debug", "hook": "trace"} 的对象；未知的子系统名或级别会被忽略并警告
+ */
+void applyLevels(const QJsonObject& logging);
+
+} // namespace LogCategories
@@ -0,0 +1,292 @@
+#include "LogSink.h"
+#include <QDateTime>
+#include <QThread>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// 每个线程的环形缓冲区大小（字节，必须为 2 的幂）
+static constexpr quint64 BUFFER_CAPACITY = 64 * 1024;
+// 单条消息最多保留的字符数，超出部分截断，保证任何消息都能放进空缓冲区
+static constexpr qsizetype MAX_MESSAGE_CHARS = 4096;
+// 写线程无唤醒时的最长等待时间
+static constexpr unsigned long FLUSH_INTERVAL_MS = 50;
+
+// 当前线程正在日志输出内部（写线程、同步刷新期间）：此时再输出日志直接写 stderr，避免重入死锁
+static thread_local bool t_inSink = false;
+
+namespace {
+// 缓冲区中的记录头，其后紧跟 bytes 字节的 UTF-16 消息，整体按 8 字节对齐
+struct RecordHeader {
+    qint64 timestampMs;
+    quint32 type;
+    quint32 bytes;
+};
+
+inline quint64 recordSize(quint32 bytes)
+{
+    return (sizeof(RecordHeader) + bytes + 7) & ~quint64(7);
+}
+}
+
+struct LogSink::ThreadBuffer {
+    alignas(64) std::atomic<quint64> head{0}; // 生产者写入位置
+    alignas(64) std::atomic<quint64> tail{0}; // 消费者读取位置
+    std::atomic<bool> retired{false};         // 所属线程已退出，取空后可回收
+    char data[BUFFER_CAPACITY];
+
+    void copyIn(quint64 pos, const void* src, size_t len)
+    {
+        const size_t offset = size_t(pos & (BUFFER_CAPACITY - 1));
+        const size_t first = std::min(len, size_t(BUFFER_CAPACITY) - offset);
+        std::memcpy(data + offset, src, first);
+        if (first < len) std::memcpy(data, static_cast<const char*>(src) + first, len - first);
+    }
+    void copyOut(quint64 pos, void* dst, size_t len) const
+    {
+        const size_t offset = size_t(pos & (BUFFER_CAPACITY - 1));
+        const size_t first = std::min(len, size_t(BUFFER_CAPACITY) - offset);
+        std::memcpy(dst, data + offset, first);
+        if (first < len) std::memcpy(static_cast<char*>(dst) + first, data, len - first);
+    }
+};
+
+// 线程退出时标记缓冲区，缓冲区本身由注册表继续持有到被取空
+struct LogSink::ThreadBufferHolder {
+    std::shared_ptr<ThreadBuffer> buffer;
+    ~ThreadBufferHolder()
+    {
+        if (buffer) buffer->retired.store(true, std::memory_order_release);
+    }
+};
+
+struct LogSink::Record {
+    qint64 timestampMs;
+    QtMsgType type;
+    QString message;
+};
+
+LogSink& LogSink::instance()
+{
+    static LogSink sink;
+    return sink;
+}
+
+LogSink::~LogSink()
+{
+    close();
+}
+
+bool LogSink::open(const QString& filePath)
+{
+    QMutexLocker locker(&m_drainMutex);
+    if (m_open.load()) return true;
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        fprintf(stderr, "Failed to open log file: %s\n", qPrintable(filePath));
+        return false;
+    }
+    m_file.write(QStringLiteral("--- Log started at %1 ---\n")
+                     .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")).toUtf8());
+    m_file.flush();
+
+    {
+        QMutexLocker wakeLocker(&m_wakeMutex);
+        m_stopping = false;
+    }
+    m_writer.reset(QThread::create([this] { writerLoop(); }));
+    m_writer->setObjectName(QStringLiteral("LogWriter"));
+    m_writer->start(QThread::LowPriority);
+    m_open.store(true, std::memory_order_release);
+    return true;
+}
+
+void LogSink::close()
+{
+    if (!m_open.exchange(false)) return;
+    {
+        QMutexLocker wakeLocker(&m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.wakeAll();
+    m_writer->wait();
+    m_writer.reset();
+
+    QMutexLocker locker(&m_drainMutex);
+    drainLocked();
+    m_file.write(QStringLiteral("--- Log finished at %1 ---\n")
+                     .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")).toUtf8());
+    m_file.close();
+}
+
+void LogSink::messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+{
+    Q_UNUSED(context);
+    LogSink& sink = instance();
+    if (t_inSink || !sink.m_open.load(std::memory_order_acquire)) {
+        writeToStderr(msg);
+        if (type == QtFatalMsg) abort();
+        return;
+    }
+
+    const bool queued = sink.append(type, msg);
+    if (type == QtDebugMsg || type == QtInfoMsg) {
+        if (!queued) sink.m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // 警告及以上：连同此前所有线程的记录同步写出并刷新
+    t_inSink = true;
+    {
+        QMutexLocker locker(&sink.m_drainMutex);
+        sink.drainLocked();
+        if (!queued && sink.m_file.isOpen()) {
+            QByteArray line;
+            sink.writeLine(line, QDateTime::currentMSecsSinceEpoch(), type, msg);
+            sink.m_file.write(line);
+            sink.m_file.flush();
+        }
+    }
+    t_inSink = false;
+
+    if (type == QtFatalMsg) abort();
+}
+
+LogSink::ThreadBuffer* LogSink::currentThreadBuffer()
+{
+    thread_local ThreadBufferHolder holder;
+    if (!holder.buffer) {
+        holder.buffer = std::make_shared<ThreadBuffer>();
+        QMutexLocker locker(&m_registryMutex);
+        m_buffers.push_back(holder.buffer);
+    }
+    return holder.buffer.get();
+}
+
+bool LogSink::append(QtMsgType type, const QString& msg)
+{
+    ThreadBuffer* buffer = currentThreadBuffer();
+    const qsizetype chars = std::min(msg.size(), MAX_MESSAGE_CHARS);
+    RecordHeader header{QDateTime::currentMSecsSinceEpoch(), quint32(type), quint32(chars * sizeof(QChar))};
+    const quint64 size = recordSize(header.bytes);
+
+    const quint64 head = buffer->head.load(std::memory_order_relaxed);
+    const quint64 used = head - buffer->tail.load(std::memory_order_acquire);
+    if (BUFFER_CAPACITY - used < size) {
+        wakeWriter();
+        return false;
+    }
+    buffer->copyIn(head, &header, sizeof(header));
+    buffer->copyIn(head + sizeof(header), msg.constData(), header.bytes);
+    buffer->head.store(head + size, std::memory_order_release);
+
+    // 缓冲区过半时提前唤醒写线程，避免突发日志被丢弃
+    if (used + size > BUFFER_CAPACITY / 2) wakeWriter();
+    return true;
+}
+
+void LogSink::wakeWriter()
+{
+    // 不持锁唤醒：写线程恰好未进入等待时会错过这次唤醒，最多延迟一个刷新周期
+    if (!m_wakeRequested.exchange(true, std::memory_order_acq_rel)) {
+        m_wakeCondition.wakeOne();
+    }
+}
+
+void LogSink::writerLoop()
+{
+    t_inSink = true;
+    for (;;) {
+        {
+            QMutexLocker wakeLocker(&m_wakeMutex);
+            if (!m_stopping && !m_wakeRequested.load(std::memory_order_acquire)) {
+                m_wakeCondition.wait(&m_wakeMutex, FLUSH_INTERVAL_MS);
+            }
+            m_wakeRequested.store(false, std::memory_order_release);
+            if (m_stopping) break;
+        }
+        QMutexLocker locker(&m_drainMutex);
+        drainLocked();
+    }
+}
+
+void LogSink::drainLocked()
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        QMutexLocker locker(&m_registryMutex);
+        buffers = m_buffers;
+    }
+
+    std::vector<Record> records;
+    for (const auto& buffer : buffers) {
+        quint64 tail = buffer->tail.load(std::memory_order_relaxed);
+        const quint64 head = buffer->head.load(std::memory_order_acquire);
+        while (tail < head) {
+            RecordHeader header;
+            buffer->copyOut(tail, &header, sizeof(header));
+            QString message(qsizetype(header.bytes / sizeof(QChar)), Qt::Uninitialized);
+            buffer->copyOut(tail + sizeof(header), message.data(), header.bytes);
+            records.push_back({header.timestampMs, QtMsgType(header.type), std::move(message)});
+            tail += recordSize(header.bytes);
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+
+    // 各线程的记录分别有序，合并后按时间排序，同一时刻保持线程内顺序
+    std::stable_sort(records.begin(), records.end(),
+                     [](const Record& a, const Record& b) { return a.timestampMs < b.timestampMs; });
+
+    QByteArray batch;
+    const quint64 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        writeLine(batch, QDateTime::currentMSecsSinceEpoch(), QtWarningMsg,
+                  QStringLiteral("[LogSink] 日志缓冲区已满，丢弃了 %1 条消息").arg(dropped));
+    }
+    for (const Record& record : records) {
+        writeLine(batch, record.timestampMs, record.type, record.message);
+    }
+    if (!batch.isEmpty() && m_file.isOpen()) {
+        m_file.write(batch);
+        m_file.flush();
+    }
+
+    // 回收所属线程已退出且已取空的缓冲区
+    QMutexLocker locker(&m_registryMutex);
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                   [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                       return buffer->retired.load(std::memory_order_acquire)
+                                              && buffer->head.load(std::memory_order_acquire)
+                                                     == buffer->tail.load(std::memory_order_relaxed);
+                                   }),
+                    m_buffers.end());
+}
+
+void LogSink::writeLine(QByteArray& batch, qint64 timestampMs, QtMsgType type, const QString& msg)
+{
+    const qint64 second = timestampMs / 1000;
+    if (second != m_cachedSecond) {
+        m_cachedSecond = second;
+        m_cachedSecondText = QDateTime::fromMSecsSinceEpoch(second * 1000).toString("yyyy-MM-dd hh:mm:ss").toUtf8();
+    }
+    const int millis = int(timestampMs % 1000);
+    char millisText[5] = {'.', char('0' + millis / 100), char('0' + millis / 10 % 10), char('0' + millis % 10), ' '};
+
+    batch += m_cachedSecondText;
+    batch.append(millisText, sizeof(millisText));
+    switch (type) {
+    case QtDebugMsg:       batch += "DEBUG:   "; break;
+    case QtInfoMsg:        batch += "INFO:    "; break;
+    case QtWarningMsg:     batch += "WARNING: "; break;
+    case QtCriticalMsg:    batch += "CRITICAL:"; break;
+    case QtFatalMsg:       batch += "FATAL:   "; break;
+    }
+    batch += msg.toUtf8();
+    batch += '\n';
+}
+
+void LogSink::writeToStderr(const QString& msg)
+{
+    fprintf(stderr, "%s\n", qPrintable(msg));
+}
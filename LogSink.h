@@ -0,0 +1,74 @@
+#pragma once
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QThread;
+
+// =============================
+// 异步批量日志输出
+// =============================
+// Qt 消息处理函数的后端。每个线程首次输出日志时分配一块固定大小的单生产者环形缓冲区，
+// 记录只包含时间戳、级别和消息的 UTF-16 原文，写入时不加锁、不格式化，只做一次拷贝。
+// 独立的写线程定期（或缓冲区过半时被唤醒）取走所有线程的记录，按时间排序、格式化后整批写入 log.txt。
+// 每个缓冲区大小固定，写线程跟不上时丢弃新消息并计数，下一批开头输出丢弃条数，内存占用有上限。
+// 警告及以上级别在调用线程同步取走全部记录并刷新文件，保证崩溃前的关键信息不丢失；致命消息写出后终止进程。
+class LogSink
+{
+public:
+    static LogSink& instance();
+
+    /**
+     * @brief 打开（截断）日志文件并启动写线程，应在安装消息处理函数之前调用
+     * @param filePath 日志文件路径
+     * @return 文件打开失败时返回 false，此后日志输出到 stderr
+     */
+    bool open(const QString& filePath);
+    // 停止写线程，写出剩余记录后关闭文件；之后的日志输出到 stderr
+    void close();
+
+    // 通过 qInstallMessageHandler 安装
+    static void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg);
+
+private:
+    struct ThreadBuffer;
+    struct ThreadBufferHolder;
+    struct Record;
+
+    LogSink() = default;
+    ~LogSink();
+    Q_DISABLE_COPY(LogSink)
+
+    ThreadBuffer* currentThreadBuffer();
+    // 写入调用线程的缓冲区，缓冲区已满时返回 false
+    bool append(QtMsgType type, const QString& msg);
+    void wakeWriter();
+    void writerLoop();
+    // 取走所有缓冲区中的记录并写入文件（需持有 m_drainMutex）
+    void drainLocked();
+    void writeLine(QByteArray& batch, qint64 timestampMs, QtMsgType type, const QString& msg);
+    static void writeToStderr(const QString& msg);
+
+    QFile m_file;
+    std::atomic<bool> m_open{false};
+    std::atomic<quint64> m_dropped{0};   // 因缓冲区已满丢弃的消息数
+
+    QMutex m_registryMutex;              // 保护 m_buffers
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+    QMutex m_drainMutex;                 // 持有者即所有缓冲区的唯一消费者，同时保护 m_file
+    qint64 m_cachedSecond = -1;          // 时间戳前缀缓存（同一秒内的消息复用）
+    QByteArray m_cachedSecondText;
+
+    QMutex m_wakeMutex;
+    QWaitCondition m_wakeCondition;
+    std::atomic<bool> m_wakeRequested{false};
+    bool m_stopping = false;             // 受 m_wakeMutex 保护
+    std::unique_ptr<QThread> m_writer;
+};
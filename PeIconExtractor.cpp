@@ -0,0 +1,317 @@
+#include "PeIconExtractor.h"
+#include <QFile>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const quint32 RT_ICON_ID = 3;
+const quint32 RT_GROUP_ICON_ID = 14;
+const int RESOURCE_DATA_DIRECTORY = 2;     // IMAGE_DIRECTORY_ENTRY_RESOURCE
+const int MAX_DIRECTORY_ENTRIES = 4096;    // 防止损坏文件导致超长遍历
+const int MAX_DIB_DIMENSION = 1024;
+const uchar PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+// 带边界检查的小端读取，越界读返回 0
+class ByteView {
+public:
+    ByteView(const uchar* data, qint64 size) : m_data(data), m_size(size) {}
+
+    bool contains(qint64 offset, qint64 length) const
+    {
+        return offset >= 0 && length >= 0 && offset <= m_size && length <= m_size - offset;
+    }
+    quint8 u8(qint64 offset) const { return contains(offset, 1) ? m_data[offset] : 0; }
+    quint16 u16(qint64 offset) const
+    {
+        return contains(offset, 2) ? quint16(m_data[offset] | (m_data[offset + 1] << 8)) : 0;
+    }
+    quint32 u32(qint64 offset) const
+    {
+        return contains(offset, 4) ? quint32(m_data[offset]) | (quint32(m_data[offset + 1]) << 8)
+                                         | (quint32(m_data[offset + 2]) << 16) | (quint32(m_data[offset + 3]) << 24)
+                                   : 0;
+    }
+    const uchar* at(qint64 offset) const { return m_data + offset; }
+
+private:
+    const uchar* m_data;
+    qint64 m_size;
+};
+
+struct Section {
+    quint32 virtualAddress = 0;
+    quint32 virtualSize = 0;
+    quint32 rawOffset = 0;
+    quint32 rawSize = 0;
+};
+
+struct PeLayout {
+    QVarLengthArray<Section, 16> sections;
+    quint32 resourceRva = 0;
+};
+
+// 资源目录项：id 为整数 ID（具名项为 -1），target 为相对资源目录起点的偏移
+struct ResourceEntry {
+    qint64 id = -1;
+    quint32 target = 0;
+    bool isDirectory = false;
+};
+
+// 图标组中的一帧
+struct GroupFrame {
+    int width = 0;
+    int height = 0;
+    int bitCount = 0;
+    quint16 iconId = 0;
+};
+
+// 解析 DOS 头 -> PE 头 -> 可选头中的资源数据目录 -> 节表
+bool parsePeLayout(const ByteView& view, PeLayout* layout)
+{
+    if (view.u16(0) != 0x5A4D) return false; // "MZ"
+    const qint64 peOffset = view.u32(0x3C);
+    if (!view.contains(peOffset, 24) || view.u32(peOffset) != 0x00004550) return false; // "PE\0\0"
+    const qint64 coffHeader = peOffset + 4;
+    const int sectionCount = view.u16(coffHeader + 2);
+    const quint16 optionalHeaderSize = view.u16(coffHeader + 16);
+    const qint64 optionalHeader = coffHeader + 20;
+    if (!view.contains(optionalHeader, optionalHeaderSize)) return false;
+
+    qint64 directoryCountOffset = 0;
+    qint64 directoryOffset = 0;
+    switch (view.u16(optionalHeader)) {
+    case 0x10B: directoryCountOffset = 92; directoryOffset = 96; break;   // PE32
+    case 0x20B: directoryCountOffset = 108; directoryOffset = 112; break; // PE32+
+    default: return false;
+    }
+    const qint64 resourceDirectory = directoryOffset + RESOURCE_DATA_DIRECTORY * 8;
+    if (optionalHeaderSize < resourceDirectory + 8
+        || view.u32(optionalHeader + directoryCountOffset) <= quint32(RESOURCE_DATA_DIRECTORY)) {
+        return false;
+    }
+    layout->resourceRva = view.u32(optionalHeader + resourceDirectory);
+    if (layout->resourceRva == 0) return false;
+
+    const qint64 sectionTable = optionalHeader + optionalHeaderSize;
+    if (!view.contains(sectionTable, qint64(sectionCount) * 40)) return false;
+    for (int i = 0; i < sectionCount; ++i) {
+        const qint64 header = sectionTable + qint64(i) * 40;
+        Section section;
+        section.virtualSize = view.u32(header + 8);
+        section.virtualAddress = view.u32(header + 12);
+        section.rawSize = view.u32(header + 16);
+        section.rawOffset = view.u32(header + 20);
+        layout->sections.append(section);
+    }
+    return true;
+}
+
+// RVA -> 文件偏移，要求 [rva, rva + length) 完全落在某个节的文件数据内，且不超出实际文件长度
+// （文件被截断或节表损坏时 rawOffset + rawSize 可能越过文件末尾）
+qint64 rvaToOffset(const ByteView& view, const PeLayout& layout, quint32 rva, quint32 length)
+{
+    for (const Section& section : layout.sections) {
+        const quint32 extent = qMax(section.virtualSize, section.rawSize);
+        if (rva < section.virtualAddress || rva - section.virtualAddress >= extent) continue;
+        const quint64 delta = rva - section.virtualAddress;
+        if (delta + length > section.rawSize) return -1;
+        const qint64 offset = qint64(section.rawOffset) + qint64(delta);
+        return view.contains(offset, length) ? offset : -1;
+    }
+    return -1;
+}
+
+QVarLengthArray<ResourceEntry, 32> readDirectory(const ByteView& view, qint64 base, quint32 offset)
+{
+    QVarLengthArray<ResourceEntry, 32> entries;
+    const qint64 directory = base + offset;
+    if (!view.contains(directory, 16)) return entries;
+    const int count = view.u16(directory + 12) + view.u16(directory + 14); // 具名项 + ID 项
+    if (count > MAX_DIRECTORY_ENTRIES || !view.contains(directory + 16, qint64(count) * 8)) return entries;
+    for (int i = 0; i < count; ++i) {
+        const qint64 entry = directory + 16 + qint64(i) * 8;
+        const quint32 name = view.u32(entry);
+        const quint32 target = view.u32(entry + 4);
+        ResourceEntry resource;
+        resource.id = (name & 0x80000000u) ? -1 : qint64(name);
+        resource.target = target & 0x7FFFFFFFu;
+        resource.isDirectory = (target & 0x80000000u) != 0;
+        entries.append(resource);
+    }
+    return entries;
+}
+
+// 沿第一个子项向下（名称 -> 语言）直到数据项，返回数据在文件中的位置
+bool resolveDataEntry(const ByteView& view, const PeLayout& layout, qint64 base, ResourceEntry entry,
+                      qint64* dataOffset, quint32* dataSize)
+{
+    for (int depth = 0; entry.isDirectory; ++depth) {
+        if (depth >= 2) return false;
+        const QVarLengthArray<ResourceEntry, 32> children = readDirectory(view, base, entry.target);
+        if (children.isEmpty()) return false;
+        entry = children.first();
+    }
+    const qint64 dataEntry = base + entry.target;
+    if (!view.contains(dataEntry, 16)) return false;
+    *dataSize = view.u32(dataEntry + 4);
+    *dataOffset = rvaToOffset(view, layout, view.u32(dataEntry), *dataSize);
+    return *dataOffset >= 0 && view.contains(*dataOffset, *dataSize);
+}
+
+// 解码 RT_ICON 中的 DIB 帧：BITMAPINFOHEADER + 调色板 + XOR 位图 + AND 掩码（均自底向上存储）
+QImage decodeDib(const uchar* data, quint32 size)
+{
+    const ByteView view(data, size);
+    const quint32 headerSize = view.u32(0);
+    if (headerSize < 40 || !view.contains(0, headerSize)) return QImage();
+    const qint32 width = qint32(view.u32(4));
+    const qint32 height = qint32(view.u32(8)) / 2; // 高度包含 XOR 与 AND 两张位图
+    const int bitCount = view.u16(14);
+    const quint32 compression = view.u32(16);
+    const quint32 colorsUsed = view.u32(32);
+    if (width <= 0 || height <= 0 || width > MAX_DIB_DIMENSION || height > MAX_DIB_DIMENSION || compression != 0) {
+        return QImage();
+    }
+    if (bitCount != 1 && bitCount != 4 && bitCount != 8 && bitCount != 24 && bitCount != 32) return QImage();
+    const qint64 paletteCount = bitCount <= 8 ? (colorsUsed ? qint64(colorsUsed) : (qint64(1) << bitCount)) : 0;
+    if (paletteCount > 256) return QImage();
+
+    const qint64 paletteOffset = headerSize;
+    const qint64 xorStride = ((qint64(width) * bitCount + 31) / 32) * 4;
+    const qint64 andStride = ((qint64(width) + 31) / 32) * 4;
+    const qint64 xorOffset = paletteOffset + paletteCount * 4;
+    const qint64 andOffset = xorOffset + xorStride * height;
+    if (!view.contains(xorOffset, xorStride * height)) return QImage();
+    const bool hasMask = view.contains(andOffset, andStride * height);
+
+    QImage image(width, height, QImage::Format_ARGB32);
+    if (image.isNull()) return QImage();
+    bool hasAlpha = false;
+    for (int y = 0; y < height; ++y) {
+        const uchar* src = view.at(xorOffset + xorStride * (height - 1 - y));
+        QRgb* dst = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            if (bitCount == 32) {
+                const uchar* px = src + x * 4;
+                dst[x] = qRgba(px[2], px[1], px[0], px[3]);
+                hasAlpha = hasAlpha || px[3] != 0;
+            } else if (bitCount == 24) {
+                const uchar* px = src + x * 3;
+                dst[x] = qRgb(px[2], px[1], px[0]);
+            } else {
+                const int bitOffset = x * bitCount;
+                const int index = (src[bitOffset / 8] >> (8 - bitCount - bitOffset % 8)) & ((1 << bitCount) - 1);
+                if (index < paletteCount) {
+                    const uchar* color = view.at(paletteOffset + index * 4);
+                    dst[x] = qRgb(color[2], color[1], color[0]);
+                } else {
+                    dst[x] = 0;
+                }
+            }
+        }
+    }
+
+    // 没有 alpha 通道（含 alpha 全为 0 的旧式 32 位图标）时，由 AND 掩码决定透明像素
+    if (!hasAlpha) {
+        for (int y = 0; y < height; ++y) {
+            const uchar* mask = hasMask ? view.at(andOffset + andStride * (height - 1 - y)) : nullptr;
+            QRgb* dst = reinterpret_cast<QRgb*>(image.scanLine(y));
+            for (int x = 0; x < width; ++x) {
+                const bool transparent = mask && ((mask[x / 8] >> (7 - x % 8)) & 1);
+                dst[x] = transparent ? 0 : (dst[x] | 0xFF000000u);
+            }
+        }
+    }
+    return image;
+}
+
+QImage decodeIconFrame(const uchar* data, quint32 size)
+{
+    if (size >= sizeof(PNG_SIGNATURE) && std::memcmp(data, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0) {
+        // Vista 之后的 256px 帧通常以 PNG 存储
+        const QImage image = QImage::fromData(data, int(size), "PNG");
+        return image.isNull() ? QImage() : image.convertToFormat(QImage::Format_ARGB32);
+    }
+    return decodeDib(data, size);
+}
+
+} // namespace
+
+namespace PeIconExtractor {
+
+QImage extractLargestIcon(const uchar* data, qint64 size)
+{
+    const ByteView view(data, size);
+    PeLayout layout;
+    if (!parsePeLayout(view, &layout)) return QImage();
+    const qint64 base = rvaToOffset(view, layout, layout.resourceRva, 16);
+    if (base < 0) return QImage();
+
+    ResourceEntry groupType;
+    ResourceEntry iconType;
+    for (const ResourceEntry& type : readDirectory(view, base, 0)) {
+        if (!type.isDirectory) continue;
+        if (type.id == RT_GROUP_ICON_ID) groupType = type;
+        if (type.id == RT_ICON_ID) iconType = type;
+    }
+    if (!groupType.isDirectory || !iconType.isDirectory) return QImage();
+
+    // 目录中的第一个图标组即资源管理器显示的应用图标
+    const QVarLengthArray<ResourceEntry, 32> groups = readDirectory(view, base, groupType.target);
+    qint64 group = 0;
+    quint32 groupSize = 0;
+    if (groups.isEmpty() || !resolveDataEntry(view, layout, base, groups.first(), &group, &groupSize)) {
+        return QImage();
+    }
+    // GRPICONDIR: reserved, type(=1), count，随后每帧 14 字节的 GRPICONDIRENTRY
+    const int frameCount = view.u16(group + 4);
+    if (groupSize < 6 || view.u16(group + 2) != 1 || groupSize < 6 + quint32(frameCount) * 14) return QImage();
+    QVarLengthArray<GroupFrame, 16> frames;
+    for (int i = 0; i < frameCount; ++i) {
+        const qint64 entry = group + 6 + qint64(i) * 14;
+        GroupFrame frame;
+        frame.width = view.u8(entry) ? view.u8(entry) : 256; // 0 表示 256
+        frame.height = view.u8(entry + 1) ? view.u8(entry + 1) : 256;
+        frame.bitCount = view.u16(entry + 6);
+        frame.iconId = view.u16(entry + 12);
+        frames.append(frame);
+    }
+    // 尺寸从大到小、同尺寸色深从高到低，依次尝试直到解码成功
+    std::sort(frames.begin(), frames.end(), [](const GroupFrame& a, const GroupFrame& b) {
+        const int areaA = a.width * a.height;
+        const int areaB = b.width * b.height;
+        return areaA != areaB ? areaA > areaB : a.bitCount > b.bitCount;
+    });
+
+    const QVarLengthArray<ResourceEntry, 32> icons = readDirectory(view, base, iconType.target);
+    for (const GroupFrame& frame : frames) {
+        for (const ResourceEntry& icon : icons) {
+            if (icon.id != frame.iconId) continue;
+            qint64 offset = 0;
+            quint32 length = 0;
+            if (!resolveDataEntry(view, layout, base, icon, &offset, &length)) break;
+            const QImage image = decodeIconFrame(view.at(offset), length);
+            if (!image.isNull()) return image;
+            break;
+        }
+    }
+    return QImage();
+}
+
+QImage extractLargestIcon(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return QImage();
+    const qint64 size = file.size();
+    if (size < 64) return QImage();
+    uchar* data = file.map(0, size);
+    if (!data) return QImage();
+    // 解码结果拥有独立的像素缓冲区，解除映射后仍然有效
+    const QImage image = extractLargestIcon(data, size);
+    file.unmap(data);
+    return image;
+}
+
+} // namespace PeIconExtractor
@@ -0,0 +1,27 @@
+#pragma once
+#include <QString>
+#include <QImage>
+
+// =============================
+// PE 资源图标提取
+// =============================
+// 直接解析 PE/COFF 映像中的资源目录：取第一个 RT_GROUP_ICON，从中选出最大的一帧
+// （256px 帧宽高记为 0，多为 PNG 压缩），再按其 ID 取对应的 RT_ICON 数据解码。
+// 不依赖 COM/Shell 与 windows.h，纯函数实现，可在任意线程、任意平台调用。
+namespace PeIconExtractor {
+
+/**
+ * @brief 从可执行文件（exe/dll）中提取最大的图标帧
+ * @param filePath 文件路径，以内存映射方式读取
+ * @return ARGB32 图像；文件不是 PE 映像、没有图标资源或数据损坏时返回空图像
+ */
+QImage extractLargestIcon(const QString& filePath);
+
+/**
+ * @brief 从内存中的 PE 映像提取最大的图标帧
+ * @param data 映像起始地址
+ * @param size 映像字节数
+ */
+QImage extractLargestIcon(const uchar* data, qint64 size);
+
+} // namespace PeIconExtractor
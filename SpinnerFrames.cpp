@@ -0,0 +1,49 @@
+#include "SpinnerFrames.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include <QImageReader>
+#include <algorithm>
+
+static const char* SPINNER_PATH = ":/icons/loading_spinner.gif";
+// GIF 未声明帧时长（或声明为 0）时使用的默认值，与浏览器的处理一致
+static constexpr int DEFAULT_FRAME_DELAY_MS = 100;
+
+SpinnerFrames& SpinnerFrames::instance()
+{
+    static SpinnerFrames frames;
+    return frames;
+}
+
+SpinnerFrames::SpinnerFrames()
+{
+    Trace::Span span("ui.spinner.decode");
+    QImageReader reader(QString::fromLatin1(SPINNER_PATH));
+    reader.setScaledSize(QSize(FRAME_SIZE, FRAME_SIZE));
+    while (true) {
+        const QImage image = reader.read();
+        if (image.isNull()) {
+            break;
+        }
+        const int delay = reader.nextImageDelay();
+        m_loopDurationMs += delay > 0 ? delay : DEFAULT_FRAME_DELAY_MS;
+        m_frames.append(QPixmap::fromImage(image));
+        m_frameEndsMs.append(m_loopDurationMs);
+        if (!reader.canRead()) {
+            break;
+        }
+    }
+    span.attr("frames", m_frames.size());
+    if (m_frames.isEmpty()) {
+        qCWarning(lcUi) << "[SpinnerFrames] 无法解码加载动画:" << SPINNER_PATH << reader.errorString();
+    }
+}
+
+int SpinnerFrames::frameIndexAt(qint64 elapsedMs) const
+{
+    if (!isAnimated()) {
+        return 0;
+    }
+    const qint64 position = elapsedMs % m_loopDurationMs;
+    const auto it = std::upper_bound(m_frameEndsMs.cbegin(), m_frameEndsMs.cend(), position);
+    return int(std::min<qsizetype>(it - m_frameEndsMs.cbegin(), m_frames.size() - 1));
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <QPixmap>
+#include <QSize>
+#include <QVector>
+
+// =============================
+// 加载指示器帧缓存
+// =============================
+// loading_spinner.gif 只解码一次：首次使用时读出全部帧（缩放到 FRAME_SIZE）与各帧时长，
+// 之后所有 Dock 卡片共享这些 QPixmap，按 AnimationDriver 提供的经过时间取当前帧，不再各自持有 QMovie。
+// 仅在 GUI 线程使用（QPixmap 限制）。
+class SpinnerFrames
+{
+public:
+    static constexpr int FRAME_SIZE = 32;
+
+    static SpinnerFrames& instance();
+
+    // 是否成功解码出至少一帧
+    bool isValid() const { return !m_frames.isEmpty(); }
+    // 多于一帧时才需要周期性切换
+    bool isAnimated() const { return m_frames.size() > 1 && m_loopDurationMs > 0; }
+    QSize frameSize() const { return QSize(FRAME_SIZE, FRAME_SIZE); }
+
+    // 动画开始 elapsedMs 毫秒后应显示的帧序号（循环播放）
+    int frameIndexAt(qint64 elapsedMs) const;
+    QPixmap frame(int index) const { return m_frames.value(index); }
+
+private:
+    SpinnerFrames();
+    Q_DISABLE_COPY(SpinnerFrames)
+
+    QVector<QPixmap> m_frames;
+    QVector<qint64> m_frameEndsMs; // 各帧在一个循环内的结束时刻（累计时长）
+    qint64 m_loopDurationMs = 0;
+};
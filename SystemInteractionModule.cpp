@@ -47,8 +47,12 @@
 #include <algorithm>
 // 自定义头文件
 #include "SystemInteractionModule.h"
+#include "VkCodeTable.h"
+#include "ConfigStore.h"
 #include "AppStatus.h"
 #include "common_types.h"
+#include "LogCategories.h"
+#include "Trace.h"
 
 
 // 静态变量定义，必须在所有用到它的函数之前
@@ -67,7 +71,6 @@ struct HintedEnumWindowsCallbackArg {
 // Initialize static members
 HHOOK SystemInteractionModule::keyboardHook_ = NULL;
 SystemInteractionModule* SystemInteractionModule::instance_ = nullptr;
-const QMap<QString, DWORD> SystemInteractionModule::VK_CODE_MAP = SystemInteractionModule::initializeVkCodeMap();
 
 // Define constants for short activation
 const int SHORT_ACTIVATION_ATTEMPTS = 5; // Max attempts
@@ -76,125 +79,19 @@ const int SHORT_ACTIVATION_INTERVAL_MS = 300; // Interval between attempts
 // Define constants if not already defined elsewhere (e.g., at the top of the .cpp file)
 // const int HINT_DETECTION_DELAY_MS = 5000; // Example, ensure this matches what's used
 
-// 将HINT_DETECTION_DELAY_MS默认值提升到10000ms，并支持从配置读取
-int getHintDetectionDelayMsFromConfig(const QString& configPath) {
-    QFile configFile(configPath);
-    if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return 10000; // 默认10秒
-    }
-    QJsonParseError err;
-    QJsonDocument doc = QJsonDocument::fromJson(configFile.readAll(), &err);
-    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
-        return 10000;
+DWORD SystemInteractionModule::stringToVkCode(const QString& keyString) {
+    // 名称表只含大写 ASCII，先就地转大写再查编译期哈希表，避免 toUpper() 分配
+    const qsizetype len = keyString.size();
+    if (len == 0 || len > static_cast<qsizetype>(VkCodeTable::kMaxNameLength)) {
+        return 0;
     }
-    QJsonObject obj = doc.object();
-    if (obj.contains("detection_wait_ms") && obj["detection_wait_ms"].isDouble()) {
-        int val = obj["detection_wait_ms"].toInt();
-        if (val >= 1000 && val <= 60000) return val; // 合理范围
+    char buf[VkCodeTable::kMaxNameLength];
+    for (qsizetype i = 0; i < len; ++i) {
+        const char16_t ch = keyString.at(i).unicode();
+        if (ch > 0x7F) return 0;
+        buf[i] = (ch >= u'a' && ch <= u'z') ? static_cast<char>(ch - u'a' + 'A') : static_cast<char>(ch);
     }
-    return 10000;
-}
-
-QMap<QString, DWORD> SystemInteractionModule::initializeVkCodeMap() {
-    QMap<QString, DWORD> map;
-    // Modifiers
-    map.insert("VK_LCONTROL", VK_LCONTROL);   // 0xA2
-    map.insert("VK_RCONTROL", VK_RCONTROL);   // 0xA3
-    map.insert("VK_LSHIFT", VK_LSHIFT);     // 0xA0
-    map.insert("VK_RSHIFT", VK_RSHIFT);     // 0xA1
-    map.insert("VK_LMENU", VK_LMENU);       // 0xA4 (Left Alt)
-    map.insert("VK_RMENU", VK_RMENU);       // 0xA5 (Right Alt)
-    map.insert("VK_CONTROL", VK_CONTROL);   // Generic Control
-    map.insert("VK_SHIFT", VK_SHIFT);       // Generic Shift
-    map.insert("VK_MENU", VK_MENU);         // Generic Alt (Menu)
-    // Letters
-    for (char c = 'A'; c <= 'Z'; ++c) {
-        map.insert(QString(c), c);
-    }
-    // Numbers
-    for (char c = '0'; c <= '9'; ++c) {
-        map.insert(QString(c), c);
-    }
-    // Function keys
-    for (int i = 1; i <= 24; ++i) {
-        map.insert(QString("F%1").arg(i), VK_F1 + (i - 1));
-    }
-    // 编辑/导航键
-    map.insert("VK_DELETE", VK_DELETE);
-    map.insert("VK_INSERT", VK_INSERT);
-    map.insert("VK_HOME", VK_HOME);
-    map.insert("VK_END", VK_END);
-    map.insert("VK_PRIOR", VK_PRIOR);   // Page Up
-    map.insert("VK_NEXT", VK_NEXT);     // Page Down
-    map.insert("VK_BACK", VK_BACK);     // Backspace
-    map.insert("VK_ESCAPE", VK_ESCAPE); // Esc
-    map.insert("VK_RETURN", VK_RETURN); // Enter
-    map.insert("VK_TAB", VK_TAB);       // Tab
-    map.insert("VK_SPACE", VK_SPACE);   // Space
-    // 方向键
-    map.insert("VK_LEFT", VK_LEFT);
-    map.insert("VK_UP", VK_UP);
-    map.insert("VK_RIGHT", VK_RIGHT);
-    map.insert("VK_DOWN", VK_DOWN);
-    // 锁定键
-    map.insert("VK_CAPITAL", VK_CAPITAL);   // Caps Lock
-    map.insert("VK_NUMLOCK", VK_NUMLOCK);   // Num Lock
-    map.insert("VK_SCROLL", VK_SCROLL);     // Scroll Lock
-    // 小键盘
-    map.insert("VK_NUMPAD0", VK_NUMPAD0);
-    map.insert("VK_NUMPAD1", VK_NUMPAD1);
-    map.insert("VK_NUMPAD2", VK_NUMPAD2);
-    map.insert("VK_NUMPAD3", VK_NUMPAD3);
-    map.insert("VK_NUMPAD4", VK_NUMPAD4);
-    map.insert("VK_NUMPAD5", VK_NUMPAD5);
-    map.insert("VK_NUMPAD6", VK_NUMPAD6);
-    map.insert("VK_NUMPAD7", VK_NUMPAD7);
-    map.insert("VK_NUMPAD8", VK_NUMPAD8);
-    map.insert("VK_NUMPAD9", VK_NUMPAD9);
-    map.insert("VK_MULTIPLY", VK_MULTIPLY);
-    map.insert("VK_ADD", VK_ADD);
-    map.insert("VK_SEPARATOR", VK_SEPARATOR);
-    map.insert("VK_SUBTRACT", VK_SUBTRACT);
-    map.insert("VK_DECIMAL", VK_DECIMAL);
-    map.insert("VK_DIVIDE", VK_DIVIDE);
-    // OEM 键（常见符号键）
-    map.insert("VK_OEM_1", VK_OEM_1);
-    map.insert("VK_OEM_PLUS", VK_OEM_PLUS);
-    map.insert("VK_OEM_COMMA", VK_OEM_COMMA);
-    map.insert("VK_OEM_MINUS", VK_OEM_MINUS);
-    map.insert("VK_OEM_PERIOD", VK_OEM_PERIOD);
-    map.insert("VK_OEM_2", VK_OEM_2);
-    map.insert("VK_OEM_3", VK_OEM_3);
-    map.insert("VK_OEM_4", VK_OEM_4);
-    map.insert("VK_OEM_5", VK_OEM_5);
-    map.insert("VK_OEM_6", VK_OEM_6);
-    map.insert("VK_OEM_7", VK_OEM_7);
-    // 其它常用
-    map.insert("VK_PAUSE", VK_PAUSE);
-    map.insert("VK_SNAPSHOT", VK_SNAPSHOT); // PrintScreen
-    map.insert("VK_APPS", VK_APPS);         // 菜单键
-    map.insert("VK_SLEEP", VK_SLEEP);
-    // Windows specific keys from config
-    map.insert("VK_LWIN", VK_LWIN);         // Left Windows key
-    // Add other common keys as needed
-    map.insert("VK_RETURN", VK_RETURN);     // Enter
-    map.insert("VK_ESCAPE", VK_ESCAPE);   // Esc
-    map.insert("VK_TAB", VK_TAB);         // Tab
-    map.insert("VK_SPACE", VK_SPACE);       // Space
-    
-    // Windows specific keys from config
-    map.insert("VK_LWIN", VK_LWIN);         // Left Windows key
-    map.insert("VK_RWIN", VK_RWIN);         // Right Windows key
-    map.insert("VK_APPS", VK_APPS);         // Application key (menu key)
-    map.insert("VK_SNAPSHOT", VK_SNAPSHOT); // Print Screen key
-    map.insert("VK_SLEEP", VK_SLEEP);       // Sleep key
-
-    // ... etc.
-    return map;
-}
-
-DWORD SystemInteractionModule::stringToVkCode(const QString& keyString) {
-    return VK_CODE_MAP.value(keyString.toUpper(), 0); // Return 0 if not found
+    return VkCodeTable::nameToCode(buf, static_cast<std::size_t>(len)); // Return 0 if not found
 }
 
 // 新增：辅助函数，将VK Code列表转换为字符串，用于日志
@@ -220,21 +117,21 @@ SystemInteractionModule::SystemInteractionModule(QObject *parent)
     // Determine config path - consistent with AdminModule
     QString configDir = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
     if (configDir.isEmpty()) {
-        qWarning() << "SystemInteractionModule: Could not get AppConfigLocation, falling back to applicationDirPath for config.";
+        qCWarning(lcConfig) << "SystemInteractionModule: Could not get AppConfigLocation, falling back to applicationDirPath for config.";
         configDir = QCoreApplication::applicationDirPath();
     }
     QDir dir(configDir);
     if (!dir.exists()) {
         if (!dir.mkpath(".")) {
-            qWarning() << "SystemInteractionModule: Could not create config directory:" << configDir << "Using application dir as last resort.";
+            qCWarning(lcConfig) << "SystemInteractionModule: Could not create config directory:" << configDir << "Using application dir as last resort.";
             configDir = QCoreApplication::applicationDirPath(); // Fallback if creation fails
         }
     }
-    m_configPath = SystemInteractionModule::getConfigFilePath(); // Store for potential future use, though loadConfiguration also calculates it
-    qDebug() << "SystemInteractionModule: Config path set to:" << m_configPath;
+    m_configPath = ConfigStore::configFilePath();
+    qCDebug(lcConfig) << "SystemInteractionModule: Config path set to:" << m_configPath;
 
     if (!loadConfiguration()) {
-        qWarning() << "系统交互模块(SystemInteractionModule): 配置文件加载失败，部分功能可能使用默认设置。";
+        qCWarning(lcConfig) << "系统交互模块(SystemInteractionModule): 配置文件加载失败，部分功能可能使用默认设置。";
         // Admin hotkey will be defaulted in loadConfiguration if needed
         // Blocked keys will be empty if not loaded, which is acceptable (no keys blocked by default)
     }
@@ -242,8 +139,18 @@ SystemInteractionModule::SystemInteractionModule(QObject *parent)
     qDebug() << "系统交互模块(SystemInteractionModule): 已创建。";
 
     // 加载等待时间
-    HINT_DETECTION_DELAY_MS = getHintDetectionDelayMsFromConfig(m_configPath);
-    qDebug() << "[SystemInteractionModule] 探测等待时间(ms):" << HINT_DETECTION_DELAY_MS;
+    HINT_DETECTION_DELAY_MS = ConfigStore::instance().detectionWaitMs();
+    qCDebug(lcConfig) << "[SystemInteractionModule] 探测等待时间(ms):" << HINT_DETECTION_DELAY_MS;
+
+    // 热键与拦截键随 ConfigStore 对应分区的变更重新转换，无需再由写入方手动通知
+    ConfigStore& config = ConfigStore::instance();
+    // 外部修改热重载时只重建变化的部分：热键匹配序列或拦截键表
+    connect(&config, &ConfigStore::shortcutsChanged, this, &SystemInteractionModule::loadAdminLoginHotkey);
+    connect(&config, &ConfigStore::userModeSettingsChanged, this, &SystemInteractionModule::loadBlockedKeys);
+    connect(&config, &ConfigStore::detectionWaitMsChanged, this, [this](int ms) {
+        HINT_DETECTION_DELAY_MS = ms;
+        qCDebug(lcConfig) << "[SystemInteractionModule] 探测等待时间已更新(ms):" << HINT_DETECTION_DELAY_MS;
+    });
 }
 
 SystemInteractionModule::~SystemInteractionModule()
@@ -272,146 +179,49 @@ SystemInteractionModule::~SystemInteractionModule()
 }
 
 bool SystemInteractionModule::loadConfiguration() {
-    m_adminLoginHotkey.clear(); // Clear previous hotkey before loading
-    m_userModeBlockedVkCodes.clear(); // Clear previous blocked keys
-    bool hotkeyLoaded = false;
-    bool blockedKeysLoaded = false;
-
-    // 统一使用英文目录，避免中文路径
-    QString configPath = SystemInteractionModule::getConfigFilePath();
-    qDebug() << "SystemInteractionModule (loadConfiguration): Attempting to load config from:" << configPath;
-
-    QFile configFile(configPath);
-
-    if (!configFile.exists()) {
-        qWarning() << "配置文件未找到:" << configPath << "将使用默认热键 (LCtrl+LShift+LAlt+L) 且不拦截用户模式按键。";
-        m_adminLoginHotkey << VK_LCONTROL << VK_LSHIFT << VK_LMENU << 0x4C; // Default hotkey
-        return false; // Indicate partial or failed load
-    }
-
-    if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) { // QIODevice::Text is fine with QTextStream
-        qWarning() << "无法打开配置文件:" << configPath << "将使用默认热键且不拦截用户模式按键。";
-        m_adminLoginHotkey << VK_LCONTROL << VK_LSHIFT << VK_LMENU << 0x4C; // Default hotkey
-        return false; // Indicate partial or failed load
+    // 配置由 ConfigStore 统一解析，这里只把键名转换为虚拟键码
+    if (!ConfigStore::instance().isLoaded()) {
+        qCWarning(lcConfig) << "配置文件未能加载:" << ConfigStore::configFilePath() << "将使用默认热键且不拦截用户模式按键。";
     }
+    const bool hotkeyLoaded = loadAdminLoginHotkey();
+    loadBlockedKeys();
+    return hotkeyLoaded; // Return true if the admin hotkey was loaded from config.
+                         // Blocked keys being empty is not a critical failure for loadConfiguration success status.
+}
 
-    QString configString;
-    QTextStream in(&configFile);
-    in.setEncoding(QStringConverter::Utf8); // Explicitly set UTF-8 encoding
-    configString = in.readAll();
-    configFile.close();
-
-    if (configString.isEmpty()) {
-        qWarning() << "配置文件为空或读取失败:" << configPath;
-        m_adminLoginHotkey << VK_LCONTROL << VK_LSHIFT << VK_LMENU << 0x4C; // Default hotkey
-        return false;
-    }
-    
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(configString.toUtf8(), &parseError); // Convert QString to UTF-8 QByteArray
-
-    if (doc.isNull() || doc.isEmpty() || !doc.isObject()) {
-        qWarning() << "解析配置文件失败:" << parseError.errorString() << "。错误详情: offset" << parseError.offset << "。将使用默认热键且不拦截用户模式按键。";
-        m_adminLoginHotkey << VK_LCONTROL << VK_LSHIFT << VK_LMENU << 0x4C; // Default hotkey
-        return false; // Indicate partial or failed load
-    }
-
-    QJsonObject rootObj = doc.object();
-    // Load admin login hotkey
-    if (rootObj.contains("shortcuts") && rootObj["shortcuts"].isObject()) {
-        QJsonObject shortcutsObj = rootObj["shortcuts"].toObject();
-        if (shortcutsObj.contains("admin_login") && shortcutsObj["admin_login"].isObject()) {
-            QJsonObject adminLoginObj = shortcutsObj["admin_login"].toObject();
-            if (adminLoginObj.contains("key_sequence") && adminLoginObj["key_sequence"].isArray()) {
-                QJsonArray keySeqArray = adminLoginObj["key_sequence"].toArray();
-                for (const QJsonValue& val : keySeqArray) {
-                    if (val.isString()) {
-                        DWORD vkCode = stringToVkCode(val.toString());
-                        if (vkCode != 0) {
-                            m_adminLoginHotkey.append(vkCode);
-                        } else {
-                            qWarning() << "配置文件中无效的管理员热键名:" << val.toString();
-                        }
-                    }
-                }
-            }
-        }
-    }
+bool SystemInteractionModule::loadAdminLoginHotkey() {
+    // 键名已由 ConfigStore 解析为虚拟键码（启动时直接来自编译缓存），无效键名已在解析时报告
+    m_adminLoginHotkey = ConfigStore::instance().adminLoginHotkeyVkCodes();
+    bool hotkeyLoaded = false;
 
     if (!m_adminLoginHotkey.isEmpty()) {
         QStringList keyNames;
-        for(DWORD code : m_adminLoginHotkey) { keyNames << VK_CODE_MAP.key(code, QString("0x%1").arg(code, 0, 16)); }
-        qDebug() << "管理员登录热键已从配置文件加载:" << keyNames.join(" + ");
+        for(DWORD code : m_adminLoginHotkey) { keyNames << vkCodeToString(code); }
+        qCDebug(lcConfig) << "管理员登录热键已从配置文件加载:" << keyNames.join(" + ");
         hotkeyLoaded = true;
     } else {
-        qWarning() << "未能在配置文件中找到有效的管理员登录热键配置，将使用默认热键。";
+        qCWarning(lcConfig) << "未能在配置文件中找到有效的管理员登录热键配置，将使用默认热键。";
         m_adminLoginHotkey << VK_LCONTROL << VK_LSHIFT << VK_LMENU << 0x4C; // Default hotkey
     }
+    return hotkeyLoaded;
+}
 
-    // Load user mode blocked keys
-    if (rootObj.contains("user_mode_settings") && rootObj["user_mode_settings"].isObject()) {
-        QJsonObject userSettingsObj = rootObj["user_mode_settings"].toObject();
-        if (userSettingsObj.contains("blocked_keys") && userSettingsObj["blocked_keys"].isArray()) {
-            QJsonArray blockedKeysArray = userSettingsObj["blocked_keys"].toArray();
-            for (const QJsonValue& val : blockedKeysArray) {
-                if (val.isString()) {
-                    DWORD vkCode = stringToVkCode(val.toString());
-                    if (vkCode != 0) {
-                        m_userModeBlockedVkCodes.insert(vkCode);
-                    } else {
-                        qWarning() << "配置文件中无效的用户模式拦截键名:" << val.toString();
-                    }
-                }
-            }
-            if (!m_userModeBlockedVkCodes.isEmpty()) {
-                QStringList blockedKeyNames;
-                for(DWORD code : m_userModeBlockedVkCodes) { blockedKeyNames << vkCodeToString(code); }
-                qDebug() << "用户模式下需拦截的独立按键已从配置文件加载:" << blockedKeyNames.join(", ");
-                blockedKeysLoaded = true;
-            }
-        } else {
-            qDebug() << "配置文件中未找到 'user_mode_settings.blocked_keys' 或格式不正确。不拦截用户模式按键。";
-        }
-
-        // 新增：加载用户模式下拦截的组合键
-        if (userSettingsObj.contains("blocked_key_combinations") && userSettingsObj["blocked_key_combinations"].isArray()) {
-            QJsonArray blockedCombosArray = userSettingsObj["blocked_key_combinations"].toArray();
-            m_userModeBlockedKeyCombinations.clear(); // 清空旧的组合键配置
-            for (const QJsonValue& comboVal : blockedCombosArray) {
-                if (comboVal.isArray()) {
-                    QJsonArray comboArray = comboVal.toArray();
-                    QList<DWORD> currentComboVkCodes;
-                    QStringList currentComboNames; // 用于日志
-                    for (const QJsonValue& keyVal : comboArray) {
-                        if (keyVal.isString()) {
-                            DWORD vkCode = stringToVkCode(keyVal.toString());
-                            if (vkCode != 0) {
-                                currentComboVkCodes.append(vkCode);
-                                currentComboNames.append(keyVal.toString());
-                            } else {
-                                qWarning() << "配置文件中无效的拦截组合键中的键名:" << keyVal.toString();
-                            }
-                        }
-                    }
-                    if (!currentComboVkCodes.isEmpty()) {
-                        m_userModeBlockedKeyCombinations.append(currentComboVkCodes);
-                        qDebug() << "用户模式下需拦截的组合键已加载:" << currentComboNames.join(" + ");
-                    }
-                }
-            }
-            if (!m_userModeBlockedKeyCombinations.isEmpty()) {
-                // blockedKeysLoaded = true; // 可以考虑组合键是否也影响此标记，或者有单独的标记
-            }
-        } else {
-            qDebug() << "配置文件中未找到 'user_mode_settings.blocked_key_combinations' 或格式不正确。不拦截组合键。";
-        }
-
+void SystemInteractionModule::loadBlockedKeys() {
+    const ConfigStore& config = ConfigStore::instance();
+    const QList<DWORD> blockedKeys = config.blockedVkCodes();
+    m_userModeBlockedVkCodes = QSet<DWORD>(blockedKeys.cbegin(), blockedKeys.cend());
+    m_userModeBlockedKeyCombinations = config.blockedVkCombinations();
+    if (!m_userModeBlockedVkCodes.isEmpty()) {
+        QStringList blockedKeyNames;
+        for(DWORD code : m_userModeBlockedVkCodes) { blockedKeyNames << vkCodeToString(code); }
+        qCDebug(lcConfig) << "用户模式下需拦截的独立按键已从配置文件加载:" << blockedKeyNames.join(", ");
     } else {
-        qDebug() << "配置文件中未找到 'user_mode_settings'。不拦截用户模式按键或组合键。";
+        qCDebug(lcConfig) << "配置文件中未配置 'user_mode_settings.blocked_keys'。不拦截用户模式按键。";
     }
 
-    return hotkeyLoaded; // Return true if at least admin hotkey was loaded successfully or defaulted.
-                         // Blocked keys being empty is not a critical failure for loadConfiguration success status.
+    for (const QList<DWORD>& combo : qAsConst(m_userModeBlockedKeyCombinations)) {
+        qCDebug(lcConfig) << "用户模式下需拦截的组合键已加载:" << vkCodesToString(combo);
+    }
 }
 
 LRESULT CALLBACK SystemInteractionModule::LowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam)
@@ -491,7 +301,7 @@ LRESULT CALLBACK SystemInteractionModule::LowLevelKeyboardProc(int nCode, WPARAM
                     }
 
                     if (allRequiredDown && instance_->m_pressedKeys.size() == instance_->m_adminLoginHotkey.size()) {
-                        qDebug() << "系统交互模块(LowLevelKeyboardProc): 管理员登录热键组合被按下。";
+                        qCDebug(lcHook) << "系统交互模块(LowLevelKeyboardProc): 管理员登录热键组合被按下。";
                         QMetaObject::invokeMethod(instance_, "adminLoginRequested", Qt::QueuedConnection);
                         return 1; // Eat the key press that triggered the combo
                     }
@@ -500,14 +310,14 @@ LRESULT CALLBACK SystemInteractionModule::LowLevelKeyboardProc(int nCode, WPARAM
             
             // User mode key blocking logic (only if user mode is active)
             if (instance_->m_userModeActive && isKeyDown) {
-                qDebug() << QString("用户模式下按键: %1 (VK: 0x%2), m_userModeActive: %3")
+                qCTrace(lcHook) << QString("用户模式下按键: %1 (VK: 0x%2), m_userModeActive: %3")
                             .arg(instance_->vkCodeToString(vkCode))
                             .arg(vkCode, 2, 16, QChar('0'))
                             .arg(instance_->m_userModeActive);
 
                 // 1. Block individual keys
                 if (instance_->m_userModeBlockedVkCodes.contains(vkCode)) {
-                    qDebug() << QString("用户模式下拦截单个按键: %1 (VK: 0x%2)")
+                    qCDebug(lcHook) << QString("用户模式下拦截单个按键: %1 (VK: 0x%2)")
                                 .arg(instance_->vkCodeToString(vkCode))
                                 .arg(vkCode, 2, 16, QChar('0'));
                     return 1; // Eat the key press
@@ -550,7 +360,7 @@ LRESULT CALLBACK SystemInteractionModule::LowLevelKeyboardProc(int nCode, WPARAM
                         }
 
                         if (allComboKeysCurrentlyPressed) {
-                            qDebug() << QString("用户模式下拦截组合键: %1 (触发键: %2 - 0x%3)")
+                            qCDebug(lcHook) << QString("用户模式下拦截组合键: %1 (触发键: %2 - 0x%3)")
                                         .arg(instance_->vkCodesToString(comboToBlock))
                                         .arg(instance_->vkCodeToString(vkCode))
                                         .arg(vkCode, 2, 16, QChar('0'));
@@ -567,7 +377,7 @@ LRESULT CALLBACK SystemInteractionModule::LowLevelKeyboardProc(int nCode, WPARAM
 bool SystemInteractionModule::installKeyboardHook()
 {
     if (keyboardHook_ != NULL) {
-        qDebug() << "键盘钩子: 已安装，无需重复安装。";
+        qCDebug(lcHook) << "键盘钩子: 已安装，无需重复安装。";
         return true; // Or false, depending on desired behavior for re-installation
     }
 
@@ -576,7 +386,7 @@ bool SystemInteractionModule::installKeyboardHook()
     // For an EXE, GetModuleHandle(NULL) gets the handle of the EXE itself.
     HINSTANCE hInstance = GetModuleHandle(NULL);
     if (!hInstance) {
-        qWarning() << "键盘钩子: 获取模块句柄失败，错误代码:" << GetLastError();
+        qCWarning(lcHook) << "键盘钩子: 获取模块句柄失败，错误代码:" << GetLastError();
         return false;
     }
 
@@ -590,39 +400,40 @@ bool SystemInteractionModule::installKeyboardHook()
 
     if (keyboardHook_ == NULL)
     {
-        qWarning() << "键盘钩子: 安装失败，错误代码:" << GetLastError();
+        qCWarning(lcHook) << "键盘钩子: 安装失败，错误代码:" << GetLastError();
         return false;
     }
 
-    qDebug() << "键盘钩子: 安装成功。";
-    qDebug() << "钩子安装，句柄:" << (quintptr)keyboardHook_;
+    qCDebug(lcHook) << "键盘钩子: 安装成功。";
+    qCDebug(lcHook) << "钩子安装，句柄:" << (quintptr)keyboardHook_;
     return true;
 }
 
 void SystemInteractionModule::uninstallKeyboardHook()
 {
-    qDebug() << "尝试卸载钩子，当前句柄:" << (quintptr)keyboardHook_;
+    qCDebug(lcHook) << "尝试卸载钩子，当前句柄:" << (quintptr)keyboardHook_;
     if (keyboardHook_ != NULL)
     {
         if (UnhookWindowsHookEx(keyboardHook_))
         {
-            qDebug() << "键盘钩子: 卸载成功。";
+            qCDebug(lcHook) << "键盘钩子: 卸载成功。";
             keyboardHook_ = NULL;
         }
         else
         {
-            qWarning() << "键盘钩子: 卸载失败，错误代码:" << GetLastError();
+            qCWarning(lcHook) << "键盘钩子: 卸载失败，错误代码:" << GetLastError();
         }
     }
     else
     {
-        qDebug() << "键盘钩子: 无需卸载，当前未安装钩子。";
+        qCDebug(lcHook) << "键盘钩子: 无需卸载，当前未安装钩子。";
     }
 }
 
 // Renaming and enhancing this function
 void SystemInteractionModule::bringToFrontAndActivate(WId windowId)
 {
+    Trace::Span span("window.activate");
     qDebug() << "系统交互模块(SystemInteractionModule): 请求置顶并激活窗口 WId:" << windowId;
     HWND hwnd = reinterpret_cast<HWND>(windowId);
 
@@ -759,18 +570,18 @@ BOOL CALLBACK SystemInteractionModule::EnumWindowsProcWithHints(HWND hwnd, LPARA
         // 新增：如果窗口是最小化状态，适当降低分数，但不直接排除
         if (isMinimized) {
             currentScore -= 20; // 最小化窗口降低分数，但不排除
-            qDebug() << "[EnumWindowsProcWithHints] 注意：该窗口处于最小化状态，分数已降低。";
+            qCTrace(lcEnum) << "[EnumWindowsProcWithHints] 注意：该窗口处于最小化状态，分数已降低。";
         }
         
         // todo: Could add exStyleMustHave / exStyleMustNotHave checks here from hints
 
-        qDebug() << "    [EnumWindowsProcWithHints] HWND:" << hwnd << "PID:" << currentWindowProcessId
+        qCTrace(lcEnum) << "    [EnumWindowsProcWithHints] HWND:" << hwnd << "PID:" << currentWindowProcessId
                  << "Class: '" << currentClassName << "' Title: '" << currentTitle.left(50) << "...'"
                  << "Visible:" << IsWindowVisible(hwnd) << "Top-Level:" << isEffectivelyTopLevel
                  << "Score:" << currentScore << "(Min Required:" << minScoreHint << ")";
 
         if (possibleCandidate && currentScore >= minScoreHint && currentScore > pArg->bestScore) {
-            qDebug() << "        >>> [EnumWindowsProcWithHints New Best Candidate!] HWND:" << hwnd << "Score:" << currentScore 
+            qCTrace(lcEnum) << "        >>> [EnumWindowsProcWithHints New Best Candidate!] HWND:" << hwnd << "Score:" << currentScore 
                      << "(Prev Best:" << pArg->bestScore << ") Class:" << currentClassName << "Title:" << currentTitle.left(50);
             pArg->bestHwnd = hwnd;
             pArg->bestScore = currentScore;
@@ -784,16 +595,19 @@ BOOL CALLBACK SystemInteractionModule::EnumWindowsProcWithHints(HWND hwnd, LPARA
 // New findMainWindowForProcess that uses hints
 // Modified to return pair of HWND and score
 QPair<HWND, int> SystemInteractionModule::findMainWindowForProcessWithScore(DWORD processId, const QJsonObject& windowHints) {
-    qDebug() << "[SystemInteractionModule] Attempting to find main window for PID:" << processId << "with hints:" << QJsonDocument(windowHints).toJson(QJsonDocument::Compact);
+    Trace::Span span("desktop.scan");
+    span.attr("pid", qint64(processId));
+    qCDebug(lcEnum) << "[SystemInteractionModule] Attempting to find main window for PID:" << processId << "with hints:" << QJsonDocument(windowHints).toJson(QJsonDocument::Compact);
     HintedEnumWindowsCallbackArg callbackArg(processId, &windowHints);
     // Ensure the callback is properly scoped
     EnumWindows(SystemInteractionModule::EnumWindowsProcWithHints, reinterpret_cast<LPARAM>(&callbackArg));
 
     if (callbackArg.bestHwnd) {
-        qDebug() << "[SystemInteractionModule] Best window found for PID" << processId << "is" << callbackArg.bestHwnd << "with score" << callbackArg.bestScore;
+        qCDebug(lcEnum) << "[SystemInteractionModule] Best window found for PID" << processId << "is" << callbackArg.bestHwnd << "with score" << callbackArg.bestScore;
     } else {
-        qDebug() << "[SystemInteractionModule] No suitable window found for PID" << processId << "with given hints and logic.";
+        qCDebug(lcEnum) << "[SystemInteractionModule] No suitable window found for PID" << processId << "with given hints and logic.";
     }
+    span.attr("score", callbackArg.bestScore);
     return qMakePair(callbackArg.bestHwnd, callbackArg.bestScore);
 }
 
@@ -815,19 +629,19 @@ HWND SystemInteractionModule::findMainWindowForProcess(DWORD processId, const QJ
 QPair<HWND, int> SystemInteractionModule::findMainWindowRecursive(
     DWORD processId, const QJsonObject& windowHints, int depth, int maxDepth) {
     if (depth > maxDepth) {
-        qWarning() << "[递归主窗口查找] 超过最大递归深度，PID:" << processId << "，终止递归。";
+        qCWarning(lcEnum) << "[递归主窗口查找] 超过最大递归深度，PID:" << processId << "，终止递归。";
         return qMakePair(nullptr, -1);
     }
     // 1. 先尝试本进程主窗口（始终用Hint打分）
     QPair<HWND, int> best = SystemInteractionModule::findMainWindowForProcessWithScore(processId, windowHints);
     if (best.first) {
-        qDebug() << QString("[递归主窗口查找] 层级%1，PID:%2，找到主窗口:%3，分数:%4 (Hint生效)").arg(depth).arg(processId).arg((quintptr)best.first).arg(best.second);
+        qCDebug(lcEnum) << QString("[递归主窗口查找] 层级%1，PID:%2，找到主窗口:%3，分数:%4 (Hint生效)").arg(depth).arg(processId).arg((quintptr)best.first).arg(best.second);
         return best;
     }
     // 2. 枚举所有子进程，递归查找（递归时也传递Hint）
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (hSnapshot == INVALID_HANDLE_VALUE) {
-        qWarning() << "[递归主窗口查找] CreateToolhelp32Snapshot失败，PID:" << processId;
+        qCWarning(lcEnum) << "[递归主窗口查找] CreateToolhelp32Snapshot失败，PID:" << processId;
         return qMakePair(nullptr, -1);
     }
     PROCESSENTRY32 pe32;
@@ -847,7 +661,7 @@ QPair<HWND, int> SystemInteractionModule::findMainWindowRecursive(
     }
     CloseHandle(hSnapshot);
     if (bestChild.first) {
-        qDebug() << QString("[递归主窗口查找] 层级%1，PID:%2，子进程找到主窗口:%3，分数:%4 (Hint生效)").arg(depth).arg(processId).arg((quintptr)bestChild.first).arg(bestChild.second);
+        qCDebug(lcEnum) << QString("[递归主窗口查找] 层级%1，PID:%2，子进程找到主窗口:%3，分数:%4 (Hint生效)").arg(depth).arg(processId).arg((quintptr)bestChild.first).arg(bestChild.second);
         return bestChild;
     }
     // 3. 兜底策略：如果递归所有进程后依然没有找到主窗口，则全量枚举本进程及所有子进程的所有窗口，按标题长度和类名频率排序
@@ -911,7 +725,7 @@ QPair<HWND, int> SystemInteractionModule::findMainWindowRecursive(
         return classNameCount[a.className] > classNameCount[b.className];
     });
     if (!candidates.isEmpty()) {
-        qDebug() << "[兜底主窗口查找] 选择标题最长/类名高频窗口:" << candidates.first().className << candidates.first().title;
+        qCDebug(lcEnum) << "[兜底主窗口查找] 选择标题最长/类名高频窗口:" << candidates.first().className << candidates.first().title;
         return qMakePair(candidates.first().hwnd, 100); // 兜底分数100
     }
     // 若无候选，返回失败
@@ -923,19 +737,19 @@ QPair<HWND, int> SystemInteractionModule::findMainWindowRecursive(
 // ... existing code ...
 // 修改findMainWindowForProcessOrChildren，调用递归查找
 HWND SystemInteractionModule::findMainWindowForProcessOrChildren(DWORD initialPid, const QString& executableNameHint) {
-    qDebug() << "[增强] SystemInteractionModule: 递归查找主窗口，初始PID:" << initialPid << "，可执行名Hint:" << executableNameHint;
+    qCDebug(lcEnum) << "[增强] SystemInteractionModule: 递归查找主窗口，初始PID:" << initialPid << "，可执行名Hint:" << executableNameHint;
     QJsonObject emptyHints; // 可根据需要传递Hint
     QPair<HWND, int> result = findMainWindowRecursive(initialPid, emptyHints);
     if (result.first) {
-        qDebug() << "[增强] SystemInteractionModule: 递归查找主窗口成功，HWND:" << (quintptr)result.first << "，分数:" << result.second;
+        qCDebug(lcEnum) << "[增强] SystemInteractionModule: 递归查找主窗口成功，HWND:" << (quintptr)result.first << "，分数:" << result.second;
         return result.first;
     }
     // 查找失败时，收集所有候选窗口并输出详细日志
     QList<WindowCandidateInfo> candidates;
     findMainWindowRecursiveWithCandidates(initialPid, emptyHints, candidates, 0, 4);
-    qWarning() << "[增强] SystemInteractionModule: 递归查找主窗口失败，输出所有候选窗口信息：";
+    qCWarning(lcEnum) << "[增强] SystemInteractionModule: 递归查找主窗口失败，输出所有候选窗口信息：";
     for (const auto& c : candidates) {
-        qWarning() << QString("HWND: %1, 类名: %2, 标题: %3, 可见: %4, 顶层: %5, PID: %6, 分数: %7")
+        qCWarning(lcEnum) << QString("HWND: %1, 类名: %2, 标题: %3, 可见: %4, 顶层: %5, PID: %6, 分数: %7")
                       .arg((quintptr)c.hwnd)
                       .arg(c.className)
                       .arg(c.title)
@@ -966,22 +780,13 @@ bool SystemInteractionModule::isModifierKey(DWORD vkCode) const {
 }
 
 QString SystemInteractionModule::vkCodeToString(DWORD vkCode) const {
-    // Iterate through the VK_CODE_MAP to find a matching QString key for the given DWORD value.
-    // This ensures that the returned string is one that stringToVkCode can parse back.
-    for (auto it = VK_CODE_MAP.constBegin(); it != VK_CODE_MAP.constEnd(); ++it) {
-        if (it.value() == vkCode) {
-            return it.key(); // Return the canonical string representation from the map
-        }
+    // VK 码 -> 名称为稠密数组直接索引，返回的名称可被 stringToVkCode 解析回原值
+    if (const char* name = VkCodeTable::codeToName(vkCode)) {
+        return QString::fromLatin1(name);
     }
 
-    // Fallback for F-keys if they were somehow not in the map or if the map is incomplete.
-    // (initializeVkCodeMap should be comprehensive for F1-F12).
-    if (vkCode >= VK_F1 && vkCode <= VK_F24) {
-        return QString("F%1").arg(vkCode - VK_F1 + 1);
-    }
-    
-    // If no string representation is found in the map, return the hex code as a last resort.
-    qWarning() << "SystemInteractionModule::vkCodeToString - No string representation found in VK_CODE_MAP for vkCode: 0x" + QString::number(vkCode, 16).toUpper();
+    // If no string representation is found in the table, return the hex code as a last resort.
+    qWarning() << "SystemInteractionModule::vkCodeToString - No string representation found in VkCodeTable for vkCode: 0x" + QString::number(vkCode, 16).toUpper();
     return QString("0x%1").arg(vkCode, 2, 16, QChar('0')).toUpper();
 }
 
@@ -994,98 +799,16 @@ QStringList SystemInteractionModule::getCurrentAdminLoginHotkeyStrings() const
     return keyNames;
 }
 
-QIcon SystemInteractionModule::getIconForExecutable(const QString& executablePath)
-{
-    qDebug() << "[SIM::getIcon] Attempting to get icon for:" << executablePath;
-    if (executablePath.isEmpty() || !QFile::exists(executablePath)) {
-        qWarning() << "[SIM::getIcon] Path is empty or file does not exist:" << executablePath;
-        return QIcon();
-    }
-
-    // --- 优先尝试获取大尺寸图标 ---
-    QFileIconProvider provider;
-    QFileInfo fileInfo(executablePath);
-    QIcon icon = provider.icon(fileInfo);
-    qDebug() << "[SIM::getIcon] QFileIconProvider.icon(fileInfo) called.";
-
-    QList<QSize> trySizes = {QSize(256,256), QSize(128,128), QSize(64,64), QSize(48,48), QSize(32,32), QSize(16,16)};
-    QPixmap bestPixmap;
-    QSize bestSize;
-    for (const QSize& sz : trySizes) {
-        QPixmap pix = icon.pixmap(sz);
-        if (!pix.isNull() && pix.width() >= bestSize.width() && pix.height() >= bestSize.height()) {
-            bestPixmap = pix;
-            bestSize = pix.size();
-            if (pix.width() >= 128 && pix.height() >= 128) break; // 已满足大尺寸
-        }
-    }
-    if (!bestPixmap.isNull() && bestPixmap.width() >= 64 && bestPixmap.height() >= 64) {
-        qDebug() << "[SIM::getIcon] Got large pixmap from QFileIconProvider, size:" << bestPixmap.size();
-        return QIcon(bestPixmap);
-    }
-
-    // --- 若QFileIconProvider获取不到大图标，尝试SHGetFileInfo ---
-    qDebug() << "[SIM::getIcon] Attempting SHGetFileInfoW for large icon:" << executablePath;
-    HRESULT comInitResult = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
-    bool comInitializedHere = SUCCEEDED(comInitResult);
-    if (!comInitializedHere && comInitResult != RPC_E_CHANGED_MODE) {
-        qWarning() << "[SIM::getIcon] CoInitializeEx failed with HRESULT:" << QString::number(comInitResult, 16);
-    }
-    SHFILEINFOW sfi = {0};
-    UINT flags = SHGFI_ICON | SHGFI_LARGEICON | SHGFI_USEFILEATTRIBUTES;
-    std::wstring filePathStdW = executablePath.toStdWString();
-    const wchar_t* filePathW = filePathStdW.c_str();
-    DWORD fileAttributes = FILE_ATTRIBUTE_NORMAL;
-    if (SHGetFileInfoW(filePathW, fileAttributes, &sfi, sizeof(sfi), flags)) {
-        if (sfi.hIcon) {
-            QImage image = QImage::fromHICON(sfi.hIcon);
-            DestroyIcon(sfi.hIcon);
-            if (!image.isNull() && (image.width() > bestSize.width() || image.height() > bestSize.height())) {
-                QPixmap pixmap = QPixmap::fromImage(image);
-                if (!pixmap.isNull()) {
-                    bestPixmap = pixmap;
-                    bestSize = pixmap.size();
-                    qDebug() << "[SIM::getIcon] Got large icon from SHGetFileInfoW, size:" << bestPixmap.size();
-                }
-            }
-        }
-    }
-    if (comInitializedHere && comInitResult != RPC_E_CHANGED_MODE) {
-        CoUninitialize();
-    }
-    if (!bestPixmap.isNull() && bestPixmap.width() >= 64 && bestPixmap.height() >= 64) {
-        return QIcon(bestPixmap);
-    }
-
-    // --- 若仍无大图标，尝试查找应用目录下ico/svg资源 ---
-    QDir exeDir = QFileInfo(executablePath).absoluteDir();
-    QString baseName = QFileInfo(executablePath).completeBaseName();
-    QStringList iconCandidates = exeDir.entryList(QStringList{baseName+".ico", "app.ico", "icon.ico", baseName+".svg", "app.svg", "icon.svg"}, QDir::Files);
-    for (const QString& iconFile : iconCandidates) {
-        QString iconPath = exeDir.absoluteFilePath(iconFile);
-        QIcon fileIcon(iconPath);
-        QPixmap pix = fileIcon.pixmap(QSize(128,128));
-        if (!pix.isNull() && (pix.width() > bestSize.width() || pix.height() > bestSize.height())) {
-            bestPixmap = pix;
-            bestSize = pix.size();
-            qDebug() << "[SIM::getIcon] Got icon from app dir resource:" << iconPath << ", size:" << bestPixmap.size();
-        }
-    }
-    if (!bestPixmap.isNull()) {
-        return QIcon(bestPixmap);
-    }
-    qWarning() << "[SIM::getIcon] All attempts to get large icon FAILED for:" << executablePath;
-    return icon; // 兜底返回QFileIconProvider原始icon
-}
-
 DWORD SystemInteractionModule::findProcessIdByName(const QString& executableName) {
     if (executableName.isEmpty()) {
         return 0; // Invalid argument
     }
 
+    Trace::Span span("process.snapshot");
+    span.attr("name", executableName);
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (hSnapshot == INVALID_HANDLE_VALUE) {
-        qWarning() << "SystemInteractionModule::findProcessIdByName - CreateToolhelp32Snapshot failed. Error:" << GetLastError();
+        qCWarning(lcMonitor) << "SystemInteractionModule::findProcessIdByName - CreateToolhelp32Snapshot failed. Error:" << GetLastError();
         return 0;
     }
 
@@ -1101,7 +824,7 @@ DWORD SystemInteractionModule::findProcessIdByName(const QString& executableName
             QString currentProcessName = QString::fromWCharArray(pe32.szExeFile);
             if (currentProcessName.compare(executableName, Qt::CaseInsensitive) == 0) {
                 foundPid = pe32.th32ProcessID;
-                qDebug() << "SystemInteractionModule::findProcessIdByName - Found process:" << executableName << "with PID:" << foundPid;
+                qCDebug(lcMonitor) << "SystemInteractionModule::findProcessIdByName - Found process:" << executableName << "with PID:" << foundPid;
                 break; // Found the first match
             }
         } while (Process32NextW(hSnapshot, &pe32)); // Use Process32NextW
@@ -1129,26 +852,28 @@ void SystemInteractionModule::monitorAndActivateApplication(
     const QJsonObject& windowHints, // New parameter
     bool forceActivateOnly)
 {
-    qDebug() << "SystemInteractionModule::monitorAndActivateApplication for" << originalAppPath 
+    qCDebug(lcMonitor) << "SystemInteractionModule::monitorAndActivateApplication for" << originalAppPath 
              << "LauncherPID:" << launcherPid 
              << "MainExeHint:" << mainExecutableHint 
              << "ForceActivateOnly:" << forceActivateOnly
              << "WindowHints:" << QJsonDocument(windowHints).toJson(QJsonDocument::Compact);
 
     if (m_monitoringApps.contains(originalAppPath) && !forceActivateOnly) {
-        qDebug() << "SystemInteractionModule: Already monitoring" << originalAppPath << "aborting new monitor request.";
+        qCDebug(lcMonitor) << "SystemInteractionModule: Already monitoring" << originalAppPath << "aborting new monitor request.";
         return;
     }
+    // 从请求激活到窗口被激活（或放弃）的整个过程，可能跨越多次定时器回调
+    Trace::asyncBegin("app.activate", qHash(originalAppPath));
 
     QString targetExecutableName = mainExecutableHint;
     if (targetExecutableName.isEmpty()) {
         targetExecutableName = QFileInfo(originalAppPath).fileName();
-        qDebug() << "SystemInteractionModule: mainExecutableHint is empty, using originalAppPath's filename as target:" << targetExecutableName;
+        qCDebug(lcMonitor) << "SystemInteractionModule: mainExecutableHint is empty, using originalAppPath's filename as target:" << targetExecutableName;
     }
 
     // Ensure targetExecutableName ends with .exe
     if (!targetExecutableName.isEmpty() && !targetExecutableName.endsWith(QStringLiteral(".exe"), Qt::CaseInsensitive)) {
-        qDebug() << "[SIM::monitorAndActivateApplication] Appending .exe to targetExecutableName:" << targetExecutableName;
+        qCDebug(lcMonitor) << "[SIM::monitorAndActivateApplication] Appending .exe to targetExecutableName:" << targetExecutableName;
         targetExecutableName.append(QStringLiteral(".exe"));
     }
 
@@ -1156,28 +881,36 @@ void SystemInteractionModule::monitorAndActivateApplication(
     HWND hwnd = nullptr;
 
             if (targetPid != 0) {
-        qDebug() << "SystemInteractionModule: Found target process" << targetExecutableName << "with PID:" << targetPid;
+        qCDebug(lcMonitor) << "SystemInteractionModule: Found target process" << targetExecutableName << "with PID:" << targetPid;
         bool useHints = !windowHints.isEmpty();
         if (useHints) {
-            qDebug() << "SystemInteractionModule: Attempting to find main window for PID:" << targetPid << "(HINTED VERSION)";
+            qCDebug(lcMonitor) << "SystemInteractionModule: Attempting to find main window for PID:" << targetPid << "(HINTED VERSION)";
             hwnd = findMainWindowForProcess(targetPid, windowHints);
         }
         
         if (!hwnd) {
-            qDebug() << "SystemInteractionModule: Window not found with hints (or hints were empty). Trying generic findMainWindowForProcess for PID:" << targetPid;
+            qCDebug(lcMonitor) << "SystemInteractionModule: Window not found with hints (or hints were empty). Trying generic findMainWindowForProcess for PID:" << targetPid;
             hwnd = findMainWindowForProcess(targetPid); // Fallback to non-hinted version
         }
 
         if (hwnd) {
-            qDebug() << "SystemInteractionModule: Found main window" << hwnd << "for PID" << targetPid << (useHints ? "using hints." : "using generic search.");
+            qCDebug(lcMonitor) << "SystemInteractionModule: Found main window" << hwnd << "for PID" << targetPid << (useHints ? "using hints." : "using generic search.");
             
-            qDebug() << "SystemInteractionModule: Applying 500ms delay before activation.";
-            QThread::msleep(500); 
-
-            activateWindow(hwnd);
-            qDebug() << "SystemInteractionModule: Activating window" << hwnd << "for" << originalAppPath;
-            m_lastActivatedAppPath = originalAppPath; // 新增：记录最近一次被激活的应用
-                    emit applicationActivated(originalAppPath);
+            // 窗口刚创建时立即激活常被系统拒绝，延后 500ms 再激活；用定时器延后，不阻塞 GUI 线程
+            qCDebug(lcMonitor) << "SystemInteractionModule: Deferring activation by 500ms.";
+            QTimer::singleShot(500, this, [this, hwnd, originalAppPath]() {
+                if (!IsWindow(hwnd)) {
+                    qCWarning(lcMonitor) << "SystemInteractionModule: Window" << hwnd << "for" << originalAppPath << "closed before activation.";
+                    emit applicationActivationFailed(originalAppPath, "Window closed before activation");
+                    Trace::asyncEnd("app.activate", qHash(originalAppPath));
+                    return;
+                }
+                activateWindow(hwnd);
+                qCDebug(lcMonitor) << "SystemInteractionModule: Activating window" << hwnd << "for" << originalAppPath;
+                m_lastActivatedAppPath = originalAppPath; // 记录最近一次被激活的应用
+                emit applicationActivated(originalAppPath);
+                Trace::asyncEnd("app.activate", qHash(originalAppPath));
+            });
 
             auto it_remove_after_activate = m_monitoringApps.find(originalAppPath);
             if (it_remove_after_activate != m_monitoringApps.end()) {
@@ -1187,24 +920,25 @@ void SystemInteractionModule::monitorAndActivateApplication(
                 }
                 m_monitoringApps.erase(it_remove_after_activate); 
                 delete infoToDel; // Delete the MonitoringInfo object
-                qDebug() << "SystemInteractionModule: Removed monitoring entry for" << originalAppPath << "after successful immediate activation.";
+                qCDebug(lcMonitor) << "SystemInteractionModule: Removed monitoring entry for" << originalAppPath << "before deferred activation.";
             }
         return;
                 } else {
-            qDebug() << "SystemInteractionModule: Found PID" << targetPid << "for" << targetExecutableName << "but failed to find its window even with fallbacks.";
+            qCDebug(lcMonitor) << "SystemInteractionModule: Found PID" << targetPid << "for" << targetExecutableName << "but failed to find its window even with fallbacks.";
         }
     }
 
         if (forceActivateOnly) {
-        qDebug() << "SystemInteractionModule: Force activate only mode, but window not found immediately for" << targetExecutableName << "(PID:" << targetPid << "). Aborting.";
+        qCDebug(lcMonitor) << "SystemInteractionModule: Force activate only mode, but window not found immediately for" << targetExecutableName << "(PID:" << targetPid << "). Aborting.";
         emit applicationActivationFailed(originalAppPath, "Window not found in force activate mode");
+        Trace::asyncEnd("app.activate", qHash(originalAppPath));
         return;
     }
 
-    qDebug() << "SystemInteractionModule: Target process/window for" << targetExecutableName << "not found immediately. Starting/Resetting monitoring timer for" << originalAppPath;
+    qCDebug(lcMonitor) << "SystemInteractionModule: Target process/window for" << targetExecutableName << "not found immediately. Starting/Resetting monitoring timer for" << originalAppPath;
     
     if (m_monitoringApps.contains(originalAppPath)) {
-        qDebug() << "SystemInteractionModule: Replacing existing monitoring info for" << originalAppPath;
+        qCDebug(lcMonitor) << "SystemInteractionModule: Replacing existing monitoring info for" << originalAppPath;
         auto it_replace = m_monitoringApps.find(originalAppPath);
         if (it_replace != m_monitoringApps.end()) {
             MonitoringInfo* oldInfo = it_replace.value();
@@ -1231,27 +965,27 @@ void SystemInteractionModule::monitorAndActivateApplication(
     
     m_monitoringApps[originalAppPath] = newMonitoringInfoRawPtr; // Store raw pointer
     
-    qDebug() << "SystemInteractionModule: Monitoring timer started for" << originalAppPath << "to find" << targetExecutableName;
+    qCDebug(lcMonitor) << "SystemInteractionModule: Monitoring timer started for" << originalAppPath << "to find" << targetExecutableName;
 
     // 在查找窗口前，针对 DroneVirtualFlight 特殊处理
     if (targetExecutableName.compare("DroneVirtualFlight.exe", Qt::CaseInsensitive) == 0) {
         // 优先查找 Shipping 进程
         DWORD shippingPid = findProcessIdByName("DroneVirtualFlight-Win64-Shipping.exe");
         if (shippingPid != 0) {
-            qDebug() << "[特殊处理] 检测到虚幻引擎 Shipping 进程，优先查找其主窗口";
+            qCDebug(lcMonitor) << "[特殊处理] 检测到虚幻引擎 Shipping 进程，优先查找其主窗口";
             hwnd = findMainWindowForProcess(shippingPid, windowHints);
             if (hwnd) {
-                qDebug() << "[特殊处理] 成功找到 Shipping 进程主窗口，立即激活并降级主界面Z序";
+                qCDebug(lcMonitor) << "[特殊处理] 成功找到 Shipping 进程主窗口，立即激活并降级主界面Z序";
                 activateWindow(hwnd);
                 // 激活后无需再进入后续监控定时器逻辑，直接返回
                 m_lastActivatedAppPath = originalAppPath;
                 emit applicationActivated(originalAppPath);
                 return;
             } else {
-                qDebug() << "[特殊处理] Shipping 进程存在但未找到主窗口，继续走常规流程";
+                qCDebug(lcMonitor) << "[特殊处理] Shipping 进程存在但未找到主窗口，继续走常规流程";
             }
         } else {
-            qDebug() << "[特殊处理] 未检测到 Shipping 进程，继续走常规流程";
+            qCDebug(lcMonitor) << "[特殊处理] 未检测到 Shipping 进程，继续走常规流程";
         }
     }
 }
@@ -1261,13 +995,13 @@ void SystemInteractionModule::onMonitoringTimerTimeout() {
     if (!firedTimer) return;
     QString originalAppPath = firedTimer->property("originalAppPathProperty").toString();
     if (originalAppPath.isEmpty() || !m_monitoringApps.contains(originalAppPath)) {
-        qWarning() << "SystemInteractionModule::onMonitoringTimerTimeout - Timer fired for unknown or removed appPath:" << originalAppPath << "Timer object name:" << (firedTimer ? firedTimer->objectName() : "null");
+        qCWarning(lcMonitor) << "SystemInteractionModule::onMonitoringTimerTimeout - Timer fired for unknown or removed appPath:" << originalAppPath << "Timer object name:" << (firedTimer ? firedTimer->objectName() : "null");
         firedTimer->stop(); 
         return;
     }
     MonitoringInfo* currentInfoPtr = m_monitoringApps.value(originalAppPath, nullptr);
     if (!currentInfoPtr) {
-        qWarning() << "SystemInteractionModule::onMonitoringTimerTimeout - currentInfoPtr is null for appPath:" << originalAppPath;
+        qCWarning(lcMonitor) << "SystemInteractionModule::onMonitoringTimerTimeout - currentInfoPtr is null for appPath:" << originalAppPath;
         firedTimer->stop();
         auto it_null_check = m_monitoringApps.find(originalAppPath);
         if (it_null_check != m_monitoringApps.end()) {
@@ -1276,7 +1010,7 @@ void SystemInteractionModule::onMonitoringTimerTimeout() {
                     return;
     }
     currentInfoPtr->attempts++;
-    qDebug() << "SystemInteractionModule::onMonitoringTimerTimeout for" << originalAppPath << "Attempt:" << currentInfoPtr->attempts;
+    qCDebug(lcMonitor) << "SystemInteractionModule::onMonitoringTimerTimeout for" << originalAppPath << "Attempt:" << currentInfoPtr->attempts;
     // 1. 全局遍历所有进程的所有窗口，按Hint优先级查找
         QJsonObject windowHints = QJsonDocument::fromJson(currentInfoPtr->windowHintsJson.toUtf8()).object();
     HWND foundHwnd = nullptr;
@@ -1290,7 +1024,7 @@ void SystemInteractionModule::onMonitoringTimerTimeout() {
         }
     }
     if (foundHwnd) {
-        qDebug() << "SystemInteractionModule: 在全局窗口中找到匹配白名单Hint的窗口，HWND:" << foundHwnd << "Score:" << foundScore;
+        qCDebug(lcMonitor) << "SystemInteractionModule: 在全局窗口中找到匹配白名单Hint的窗口，HWND:" << foundHwnd << "Score:" << foundScore;
         activateWindow(foundHwnd);
         // 激活后统一调用主界面降级接口，确保外部窗口可见
         lowerMainWindowZOrder(3000);
@@ -1298,7 +1032,7 @@ void SystemInteractionModule::onMonitoringTimerTimeout() {
         if (m_forceTopmostEnabled && currentInfoPtr && foundHwnd) {
             currentInfoPtr->windowHandle = foundHwnd;
             // 定时器已在setForceTopmostEnabled中统一管理，这里只需保证windowHandle被记录
-            qDebug() << "[置顶策略] 已将目标窗口加入强力置顶监控，HWND:" << foundHwnd;
+            qCDebug(lcMonitor) << "[置顶策略] 已将目标窗口加入强力置顶监控，HWND:" << foundHwnd;
         }
         emit applicationActivated(originalAppPath);
         currentInfoPtr->timer->stop(); 
@@ -1307,31 +1041,35 @@ void SystemInteractionModule::onMonitoringTimerTimeout() {
             m_monitoringApps.erase(it_success); 
         }
         delete currentInfoPtr;
-        qDebug() << "SystemInteractionModule: Monitoring successful for" << originalAppPath << ", entry removed.";
+        qCDebug(lcMonitor) << "SystemInteractionModule: Monitoring successful for" << originalAppPath << ", entry removed.";
+        Trace::asyncEnd("app.activate", qHash(originalAppPath));
         return;
     }
     // 超时后才彻底放弃
     if (currentInfoPtr->attempts >= MAX_MONITORING_ATTEMPTS) {
-        qWarning() << "SystemInteractionModule: Max monitoring attempts reached for" << originalAppPath << ". Could not find/activate window. Stopping timer.";
+        qCWarning(lcMonitor) << "SystemInteractionModule: Max monitoring attempts reached for" << originalAppPath << ". Could not find/activate window. Stopping timer.";
         emit applicationActivationFailed(originalAppPath, "Monitoring timeout"); 
+        Trace::asyncEnd("app.activate", qHash(originalAppPath));
+        Trace::dump(Trace::defaultDumpFilePath()); // 保留这次超时启动的时间线，供事后分析
         currentInfoPtr->timer->stop();
         auto it_fail = m_monitoringApps.find(originalAppPath);
         if (it_fail != m_monitoringApps.end()) {
             m_monitoringApps.erase(it_fail);
         }
         delete currentInfoPtr;
-        qDebug() << "SystemInteractionModule: Monitoring failed for" << originalAppPath << "after" << MAX_MONITORING_ATTEMPTS << "attempts, entry removed.";
+        qCDebug(lcMonitor) << "SystemInteractionModule: Monitoring failed for" << originalAppPath << "after" << MAX_MONITORING_ATTEMPTS << "attempts, entry removed.";
     }
     // 未超时则继续监控
 }
 
 void SystemInteractionModule::activateWindow(HWND hwnd) {
     if (!hwnd) return;
+    Trace::Span span("window.activate");
     // 让主界面降级Z序，直到外部窗口失去焦点/关闭
     lowerMainWindowZOrderUntilExternalLost(hwnd);
     SetForegroundWindow(hwnd);
     SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_SHOWWINDOW);
-    qDebug() << "[窗口置顶] 已激活外部窗口并降级主界面Z序（持续检测外部窗口状态）";
+    qCDebug(lcMonitor) << "[窗口置顶] 已激活外部窗口并降级主界面Z序（持续检测外部窗口状态）";
 }
 
 bool SystemInteractionModule::nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result)
@@ -1346,7 +1084,7 @@ bool SystemInteractionModule::nativeEventFilter(const QByteArray &eventType, voi
 
 // Make sure this function is defined before startExecutableDetection or called appropriately.
 SuggestedWindowHints SystemInteractionModule::performExecutableDetectionLogic(const QString& executablePath, const QString& initialAppName) {
-    qDebug() << "[SIM::performExeDetectLogic] Path:" << executablePath << "App Name:" << initialAppName;
+    qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Path:" << executablePath << "App Name:" << initialAppName;
     SuggestedWindowHints hints;
     hints.isValid = false;
     hints.detectedExecutableName = QFileInfo(executablePath).fileName(); // Initial exe name
@@ -1358,37 +1096,37 @@ SuggestedWindowHints SystemInteractionModule::performExecutableDetectionLogic(co
 
     DWORD initialPid = 0;
     if (!process.waitForStarted(15000)) { // Increased timeout
-        qWarning() << "[SIM::performExeDetectLogic] Failed to start process:" << executablePath << "Error:" << process.errorString();
+        qCWarning(lcEnum) << "[SIM::performExeDetectLogic] Failed to start process:" << executablePath << "Error:" << process.errorString();
         hints.errorString = tr("无法启动目标程序: %1").arg(process.errorString());
         return hints;
     }
     initialPid = process.processId();
-    qDebug() << "[SIM::performExeDetectLogic] Initial process started. PID:" << initialPid << "Exe:" << QFileInfo(executablePath).fileName();
+    qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Initial process started. PID:" << initialPid << "Exe:" << QFileInfo(executablePath).fileName();
 
-    qDebug() << "[SIM::performExeDetectLogic] Waiting" << this->HINT_DETECTION_DELAY_MS << "ms for app to initialize...";
+    qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Waiting" << this->HINT_DETECTION_DELAY_MS << "ms for app to initialize...";
     QThread::msleep(this->HINT_DETECTION_DELAY_MS); // Wait for app to potentially launch its main window or child process
 
     QPair<HWND, int> windowResult = qMakePair(nullptr, -1); // HWND and score
     DWORD targetPid = initialPid; // Initially assume the launched process is the target
     
     bool initialProcessStillRunning = isProcessRunning(initialPid);
-    qDebug() << "[SIM::performExeDetectLogic] Initial process PID" << initialPid << "still running:" << initialProcessStillRunning;
+    qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Initial process PID" << initialPid << "still running:" << initialProcessStillRunning;
     
     QString actualDetectedExeName = QFileInfo(executablePath).fileName();
 
     if (initialProcessStillRunning) {
-        qDebug() << "[SIM::performExeDetectLogic] Attempt 1: Finding window for initial PID:" << initialPid;
+        qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Attempt 1: Finding window for initial PID:" << initialPid;
         // Pass an empty QJsonObject() if no specific hints are available for this call
         windowResult = findMainWindowForProcessWithScore(initialPid, QJsonObject()); 
         if (windowResult.first) {
             targetPid = initialPid; 
             actualDetectedExeName = getProcessNameByPid(targetPid);
-            qDebug() << "[SIM::performExeDetectLogic] Window found for initial PID:" << initialPid << "HWND:" << windowResult.first << "Score:" << windowResult.second;
+            qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Window found for initial PID:" << initialPid << "HWND:" << windowResult.first << "Score:" << windowResult.second;
         }
     }
 
     if (!windowResult.first && !initialProcessStillRunning) {
-        qDebug() << "[SIM::performExeDetectLogic] Initial process exited or no window found. Assuming launcher, searching for newer processes.";
+        qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Initial process exited or no window found. Assuming launcher, searching for newer processes.";
         QList<DWORD> allPids = getAllProcessIds();
         QList<QPair<QDateTime, DWORD>> recentProcesses;
 
@@ -1419,18 +1157,18 @@ SuggestedWindowHints SystemInteractionModule::performExecutableDetectionLogic(co
         std::sort(recentProcesses.begin(), recentProcesses.end(), [](const QPair<QDateTime, DWORD>& a, const QPair<QDateTime, DWORD>& b){
             return a.first > b.first;
         });
-        qDebug() << "[SIM::performExeDetectLogic] Found" << recentProcesses.count() << "potential recent processes.";
+        qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Found" << recentProcesses.count() << "potential recent processes.";
 
         for (const auto& pair : recentProcesses) {
             DWORD potentialPid = pair.second;
             QString potentialExeName = getProcessNameByPid(potentialPid);
-            qDebug() << "[SIM::performExeDetectLogic] Checking PID:" << potentialPid << "(" << potentialExeName << ")";
+            qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Checking PID:" << potentialPid << "(" << potentialExeName << ")";
             // Pass an empty QJsonObject() if no specific hints are available for this call
             windowResult = findMainWindowForProcessWithScore(potentialPid, QJsonObject()); 
             if (windowResult.first) {
                 targetPid = potentialPid;
                 actualDetectedExeName = potentialExeName;
-                qDebug() << "[SIM::performExeDetectLogic] Window found for recent PID:" << targetPid << "HWND:" << windowResult.first << "Exe:" << actualDetectedExeName << "Score:" << windowResult.second;
+                qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Window found for recent PID:" << targetPid << "HWND:" << windowResult.first << "Exe:" << actualDetectedExeName << "Score:" << windowResult.second;
                 break; 
             }
         }
@@ -1499,10 +1237,10 @@ SuggestedWindowHints SystemInteractionModule::performExecutableDetectionLogic(co
         hints.isMinimized = IsIconic(hints.windowHandle);
         // ====== 采集结束 ======
         
-        qDebug() << "[SIM::performExeDetectLogic] Success! Detected Hints:" << hints.toString() << "Achieved Score:" << hints.bestScoreDuringDetection;
+        qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Success! Detected Hints:" << hints.toString() << "Achieved Score:" << hints.bestScoreDuringDetection;
 
         } else {
-        qWarning() << "[SIM::performExeDetectLogic] Could not find main window for:" << executablePath
+        qCWarning(lcEnum) << "[SIM::performExeDetectLogic] Could not find main window for:" << executablePath
                    << "(Initial PID:" << initialPid << ", Searched PID:" << targetPid << ")";
         hints.errorString = tr("未能找到 '%1' 的主窗口。").arg(initialAppName);
         hints.isValid = false;
@@ -1527,28 +1265,28 @@ SuggestedWindowHints SystemInteractionModule::performExecutableDetectionLogic(co
         hints.candidatesJson = candidatesArray; // 新增字段，供UI层读取
         // 新增：候选窗口为空时日志提示
         if (candidates.isEmpty()) {
-            qWarning() << "[SIM::performExeDetectLogic] 未采集到任何候选窗口，建议检查进程是否正常启动或窗口是否被隐藏。";
+            qCWarning(lcEnum) << "[SIM::performExeDetectLogic] 未采集到任何候选窗口，建议检查进程是否正常启动或窗口是否被隐藏。";
         }
     }
 
     if (initialPid != 0 && ( (initialPid != targetPid && isProcessRunning(initialPid)) || !windowResult.first) ) {
-        qDebug() << "[SIM::performExeDetectLogic] Terminating initial process:" << QFileInfo(executablePath).fileName() << "(PID:" << initialPid << ")";
+        qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Terminating initial process:" << QFileInfo(executablePath).fileName() << "(PID:" << initialPid << ")";
         process.kill(); 
         process.waitForFinished(2000); 
     }
     
-    qDebug() << "[SIM::performExeDetectLogic] Finished. isValid:" << hints.isValid;
+    qCDebug(lcEnum) << "[SIM::performExeDetectLogic] Finished. isValid:" << hints.isValid;
     return hints;
 }
 
 // This is the start of the existing startExecutableDetection function
 void SystemInteractionModule::startExecutableDetection(const QString& executablePath, const QString& appName)
 {
-    qDebug() << "[SystemInteractionModule] Received request to detect executable parameters for:" << executablePath << "App Name:" << appName;
+    qCDebug(lcEnum) << "[SystemInteractionModule] Received request to detect executable parameters for:" << executablePath << "App Name:" << appName;
 
     // Use QtConcurrent::run to execute performExecutableDetectionLogic in a separate thread
     QFuture<void> future = QtConcurrent::run([this, executablePath, appName]() {
-        qDebug() << "[SystemInteractionModule] Starting detection task in thread:" << QThread::currentThreadId();
+        qCDebug(lcEnum) << "[SystemInteractionModule] Starting detection task in thread:" << QThread::currentThreadId();
         // Assuming performExecutableDetectionLogic is a member function
         // and it's thread-safe or primarily calls external processes/APIs.
         SuggestedWindowHints hints = this->performExecutableDetectionLogic(executablePath, appName);
@@ -1559,12 +1297,12 @@ void SystemInteractionModule::startExecutableDetection(const QString& executable
             // Construct a more meaningful error string if possible, 
             // or rely on performExecutableDetectionLogic to populate some part of hints even on failure.
             errorString = QString("Failed to detect main executable or window for '%1'.").arg(appName.isEmpty() ? executablePath : appName);
-            qWarning() << "[SystemInteractionModule] Detection task failed for:" << executablePath << errorString;
+            qCWarning(lcEnum) << "[SystemInteractionModule] Detection task failed for:" << executablePath << errorString;
         }
 
-        qDebug() << "[SystemInteractionModule] Detection task finished for:" << executablePath << "Success:" << success;
+        qCDebug(lcEnum) << "[SystemInteractionModule] Detection task finished for:" << executablePath << "Success:" << success;
         if (success) {
-            qDebug() << "[SystemInteractionModule] Detected hints:" << hints.toString();
+            qCDebug(lcEnum) << "[SystemInteractionModule] Detected hints:" << hints.toString();
         }
 
         // Emit the signal. This will be marshalled to the main thread if the receiver lives there.
@@ -1578,37 +1316,38 @@ void SystemInteractionModule::startExecutableDetection(const QString& executable
 // इंप्लीमेंटेशन को SystemInteractionModule.cpp में जोड़ा जाना है।
 void SystemInteractionModule::installHookAsync()
 {
-    qDebug() << "[SystemInteractionModule] installHookAsync() called.";
+    qCDebug(lcHook) << "[SystemInteractionModule] installHookAsync() called.";
     if (installKeyboardHook()) {
-        qDebug() << "[SystemInteractionModule] Keyboard hook installed asynchronously.";
+        qCDebug(lcHook) << "[SystemInteractionModule] Keyboard hook installed asynchronously.";
     } else {
-        qWarning() << "[SystemInteractionModule] Failed to install keyboard hook asynchronously.";
+        qCWarning(lcHook) << "[SystemInteractionModule] Failed to install keyboard hook asynchronously.";
     }
 }
 
 void SystemInteractionModule::uninstallHookAsync()
 {
-    qDebug() << "[SystemInteractionModule] uninstallHookAsync() called.";
+    qCDebug(lcHook) << "[SystemInteractionModule] uninstallHookAsync() called.";
     uninstallKeyboardHook();
-    qDebug() << "[SystemInteractionModule] Keyboard hook uninstalled asynchronously (or attempt was made).";
+    qCDebug(lcHook) << "[SystemInteractionModule] Keyboard hook uninstalled asynchronously (or attempt was made).";
 }
 
 // Implementation for getAllProcessIds
 QList<DWORD> SystemInteractionModule::getAllProcessIds() {
+    Trace::Span span("process.snapshot");
     QList<DWORD> pids;
     HANDLE hProcessSnap;
     PROCESSENTRY32 pe32;
 
     hProcessSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (hProcessSnap == INVALID_HANDLE_VALUE) {
-        qWarning() << "[SIM::getAllProcessIds] CreateToolhelp32Snapshot failed. Error:" << GetLastError();
+        qCWarning(lcMonitor) << "[SIM::getAllProcessIds] CreateToolhelp32Snapshot failed. Error:" << GetLastError();
         return pids;
     }
 
     pe32.dwSize = sizeof(PROCESSENTRY32);
 
     if (!Process32First(hProcessSnap, &pe32)) {
-        qWarning() << "[SIM::getAllProcessIds] Process32First failed. Error:" << GetLastError();
+        qCWarning(lcMonitor) << "[SIM::getAllProcessIds] Process32First failed. Error:" << GetLastError();
         CloseHandle(hProcessSnap);
         return pids;
     }
@@ -1683,9 +1422,11 @@ bool SystemInteractionModule::isProcessRunning(DWORD pid) {
 QString SystemInteractionModule::getProcessNameByPid(DWORD pid) {
     if (pid == 0) return QString();
 
+    Trace::Span span("process.snapshot");
+    span.attr("pid", qint64(pid));
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (hSnapshot == INVALID_HANDLE_VALUE) {
-        qWarning() << "[SIM::getProcessNameByPid] CreateToolhelp32Snapshot failed. Error:" << GetLastError();
+        qCWarning(lcMonitor) << "[SIM::getProcessNameByPid] CreateToolhelp32Snapshot failed. Error:" << GetLastError();
         return QString();
     }
 
@@ -1701,7 +1442,7 @@ QString SystemInteractionModule::getProcessNameByPid(DWORD pid) {
             }
         } while (Process32NextW(hSnapshot, &pe32)); // Use Process32NextW
     } else {
-        qWarning() << "[SIM::getProcessNameByPid] Process32FirstW failed. Error:" << GetLastError();
+        qCWarning(lcMonitor) << "[SIM::getProcessNameByPid] Process32FirstW failed. Error:" << GetLastError();
     }
 
     CloseHandle(hSnapshot);
@@ -1713,7 +1454,7 @@ QString SystemInteractionModule::getProcessNameByPid(DWORD pid) {
 
 // Add the new function definition here
 void SystemInteractionModule::stopMonitoringProcess(const QString& appPath) {
-    qDebug() << "SystemInteractionModule::stopMonitoringProcess called for:" << appPath;
+    qCDebug(lcMonitor) << "SystemInteractionModule::stopMonitoringProcess called for:" << appPath;
     if (m_monitoringApps.contains(appPath)) {
         MonitoringInfo* info = m_monitoringApps.take(appPath); // Remove from map and get the pointer
         if (info) {
@@ -1722,94 +1463,15 @@ void SystemInteractionModule::stopMonitoringProcess(const QString& appPath) {
                 // Timer is assumed to be parented and auto-deleted, or handled by MonitoringInfo destructor if it owned it.
             }
             delete info; // Delete the MonitoringInfo struct itself
-            qDebug() << "SystemInteractionModule: Stopped monitoring and cleaned up for" << appPath;
+            qCDebug(lcMonitor) << "SystemInteractionModule: Stopped monitoring and cleaned up for" << appPath;
         }
     } else {
-        qDebug() << "SystemInteractionModule: No active monitoring found for" << appPath << "to stop.";
+        qCDebug(lcMonitor) << "SystemInteractionModule: No active monitoring found for" << appPath << "to stop.";
     }
 }
 
 // ... (rest of the SystemInteractionModule.cpp file) ... 
 
-// 静态函数：统一获取配置文件路径，始终使用当前登录用户的USERPROFILE目录，避免管理员/普通用户路径不一致
-QString SystemInteractionModule::getConfigFilePath() {
-    // 通过环境变量USERPROFILE获取当前登录用户主目录，确保所有身份下配置一致
-    QString userProfile = qEnvironmentVariable("USERPROFILE");
-    QString configDir = userProfile + "/AppData/Roaming/雪鸮团队/剑鞘系统";
-    QDir().mkpath(configDir); // 确保目录存在
-    return configDir + "/config.json";
-}
-
-/**
- * @brief 获取所有白名单应用的实时状态
- * @param whitelist 当前白名单应用信息列表
- * @return 所有应用的AppStatus状态列表
- */
-QList<AppStatus> SystemInteractionModule::getAllAppStatus(const QList<AppInfo>& whitelist) {
-    QList<AppStatus> result;
-    for (const AppInfo& info : whitelist) {
-        AppStatus status;
-        status.appName = info.name;
-        status.exePath = info.exePath;
-        status.icon = getIconForExecutable(info.exePath);
-        status.pid = 0;
-        status.hwnd = nullptr;
-        status.status = AppRunStatus::NotRunning;
-        status.lastActive = QDateTime();
-
-        // 优先用mainExecutableHint查找进程，否则用path
-        QString processName = !info.mainExecutableHint.isEmpty() ? info.mainExecutableHint : QFileInfo(info.exePath).fileName();
-        DWORD pid = findProcessIdByName(processName);
-        if (pid != 0) {
-            status.pid = pid;
-            // 查找主窗口
-            HWND hwnd = findMainWindowForProcess(pid);
-            status.hwnd = hwnd;
-            if (hwnd) {
-                // 判断窗口是否最小化、激活
-                if (IsIconic(hwnd)) {
-                    status.status = AppRunStatus::Minimized;
-                } else if (GetForegroundWindow() == hwnd) {
-                    status.status = AppRunStatus::Activated;
-                } else {
-                    status.status = AppRunStatus::Running;
-                }
-                status.lastActive = QDateTime::currentDateTime();
-            } else {
-                // 优化：进程存在但未找到主窗口，尝试查找所有属于该进程的窗口
-                bool hasAnyWindow = false;
-                EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
-                    DWORD winPid = 0;
-                    GetWindowThreadProcessId(hwnd, &winPid);
-                    if (winPid == (DWORD)lParam) {
-                        // 只要有窗口就算
-                        return FALSE; // 找到一个就停止
-                    }
-                    return TRUE;
-                }, (LPARAM)pid);
-                if (hasAnyWindow) {
-                    status.status = AppRunStatus::Minimized; // 只要有窗口但未激活，视为最小化
-                } else {
-                    status.status = AppRunStatus::Running; // 无窗口，纯进程
-                }
-            }
-        } else {
-            status.status = AppRunStatus::NotRunning;
-        }
-        // TODO: 可扩展异常检测逻辑
-        result.append(status);
-        // 新增：如果该应用是最近一次被激活的应用，则强制高亮
-        if (info.exePath == m_lastActivatedAppPath) {
-            status.status = AppRunStatus::Activated;
-        }
-        // 新增：如果进程不存在且正好是上次激活的应用，清空记录
-        if (info.exePath == m_lastActivatedAppPath) {
-            m_lastActivatedAppPath.clear();
-        }
-    }
-    return result;
-}
-
 /**
  * @brief 自动采集并推荐主窗口特征（windowFindingHints）
  * @param processId 目标进程ID
@@ -1817,6 +1479,8 @@ QList<AppStatus> SystemInteractionModule::getAllAppStatus(const QList<AppInfo>&
  */
 QJsonObject SystemInteractionModule::autoDetectWindowFindingHints(DWORD processId)
 {
+    Trace::Span span("desktop.scan.hints");
+    span.attr("pid", qint64(processId));
     // 用于统计类名出现频率
     std::map<QString, int> classNameCount;
     // 用于记录所有窗口标题
@@ -1919,8 +1583,11 @@ QPair<HWND, int> SystemInteractionModule::findMainWindowRecursiveWithCandidates(
     int depth,
     int maxDepth)
 {
+    Trace::Span span("desktop.scan.candidates");
+    span.attr("pid", qint64(processId));
+    span.attr("depth", depth);
     if (depth > maxDepth) {
-        qWarning() << "[递归主窗口查找] 超过最大递归深度，PID:" << processId << "，终止递归。";
+        qCWarning(lcEnum) << "[递归主窗口查找] 超过最大递归深度，PID:" << processId << "，终止递归。";
         return qMakePair(nullptr, -1);
     }
     // 1. 本进程所有窗口打分，收集分数大于0的候选（始终用Hint打分）
@@ -1988,7 +1655,7 @@ QPair<HWND, int> SystemInteractionModule::findMainWindowRecursiveWithCandidates(
             d->bestScore = score;
         }
         // 日志输出每个窗口的Hint匹配和分数
-        qDebug() << QString("[递归主窗口查找][Hint] PID:%1 HWND:%2 类名:%3 标题:%4 分数:%5").arg(winPid).arg((quintptr)hwnd).arg(className).arg(title.left(50)).arg(score);
+        qCTrace(lcEnum) << QString("[递归主窗口查找][Hint] PID:%1 HWND:%2 类名:%3 标题:%4 分数:%5").arg(winPid).arg((quintptr)hwnd).arg(className).arg(title.left(50)).arg(score);
         return TRUE;
     };
     EnumWindows(enumProc, (LPARAM)&data);
@@ -2135,18 +1802,19 @@ static BOOL CALLBACK EnumWindowsProcForLooseFind(HWND hwnd, LPARAM lParam) {
     BOOL isVisible = IsWindowVisible(hwnd);
     BOOL isMinimized = IsIconic(hwnd);
     // 调试日志
-    qDebug() << "[窗口枚举] HWND:" << hwnd << "PID:" << pid
+    qCTrace(lcEnum) << "[窗口枚举] HWND:" << hwnd << "PID:" << pid
              << "Class:" << QString::fromWCharArray(className)
              << "Title:" << QString::fromWCharArray(title)
              << "Visible:" << isVisible << "Minimized:" << isMinimized;
     if (pid == s_looseFindProcessId && isVisible && !isMinimized) {
         s_looseFindResultHwnd = hwnd;
-        qDebug() << "[宽松兜底] 命中第一个可见窗口:" << hwnd;
+        qCDebug(lcEnum) << "[宽松兜底] 命中第一个可见窗口:" << hwnd;
         return FALSE;
     }
     return TRUE;
 }
 static HWND findFirstVisibleTopLevelWindow(DWORD processId) {
+    Trace::Span span("desktop.scan.loose");
     s_looseFindProcessId = processId;
     s_looseFindResultHwnd = nullptr;
     EnumWindows(EnumWindowsProcForLooseFind, 0);
@@ -9,7 +9,6 @@
 #include <QWidget> // Added to ensure WId is defined
 #include <QVector>
 #include <QSet> // For m_pressedKeys
-#include <QIcon> // Added for getIconForExecutable
 #include <QTimer> // ADDED for monitoring
 #include <QJsonObject>
 #include <QAbstractNativeEventFilter>
@@ -77,6 +76,9 @@ public:
     bool installKeyboardHook();
     void uninstallKeyboardHook();
     bool loadConfiguration();
+    // 分别重新加载管理员热键 / 用户模式拦截键（配置对应分区变化时调用）
+    bool loadAdminLoginHotkey();
+    void loadBlockedKeys();
     void bringToFrontAndActivate(WId windowId);
     HWND findMainWindowForProcess(DWORD processId, const QJsonObject& windowHints = QJsonObject());
     // 查找指定进程的主窗口（带分数，支持Hint打分，静态函数，便于递归调用）
@@ -91,25 +93,14 @@ public:
     );
     void setUserModeActive(bool active);
     bool isUserModeActive() const;
-    DWORD stringToVkCode(const QString& keyString);
+    static DWORD stringToVkCode(const QString& keyString);
     QString vkCodeToString(DWORD vkCode) const;
-    QIcon getIconForExecutable(const QString& executablePath);
     QStringList getCurrentAdminLoginHotkeyStrings() const;
     bool isMonitoring(const QString& appPath) const;
     void stopMonitoringProcess(const QString& appPath);
 
     virtual bool nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result) override;
 
-    // 新增：统一获取配置文件路径的静态函数声明
-    static QString getConfigFilePath();
-
-    /**
-     * @brief 获取所有白名单应用的实时状态
-     * @param whitelist 当前白名单应用信息列表
-     * @return 所有应用的AppStatus状态列表
-     */
-    QList<AppStatus> getAllAppStatus(const QList<AppInfo>& whitelist);
-
     void activateWindow(HWND hwnd); // Moved here, now public
 
     /**
@@ -192,8 +183,6 @@ private:
     static HHOOK keyboardHook_;
     static SystemInteractionModule* instance_; // For emitting signals from static callback
     static LRESULT CALLBACK LowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam);
-    static QMap<QString, DWORD> initializeVkCodeMap();
-    static const QMap<QString, DWORD> VK_CODE_MAP;
     static BOOL CALLBACK EnumWindowsProcWithHints(HWND hwnd, LPARAM lParam); // Moved static callback here
 
     // Regular private methods
@@ -0,0 +1,53 @@
+#include "Theme.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include <QApplication>
+#include <QFile>
+#include <QStyle>
+#include <QWidget>
+
+// 按顺序拼接的样式文件；后面的文件中同等优先级的规则覆盖前面的
+static const char* const THEME_FILES[] = {
+    ":/styles/Common.qss",
+    ":/styles/UserView.qss",
+    ":/styles/AppCardWidget.qss",
+    ":/styles/AdminLoginView.qss",
+    ":/styles/AdminDashboardView.qss",
+};
+
+namespace Theme {
+
+bool apply(QApplication& app)
+{
+    Trace::Span span("ui.theme.apply");
+    bool ok = true;
+    QString styleSheet;
+    for (const char* path : THEME_FILES) {
+        QFile file(QString::fromLatin1(path));
+        if (!file.open(QFile::ReadOnly | QFile::Text)) {
+            qCWarning(lcUi) << "[Theme] 无法加载样式文件:" << path << file.errorString();
+            ok = false;
+            continue;
+        }
+        styleSheet += QString::fromUtf8(file.readAll());
+        styleSheet += QLatin1Char('\n');
+    }
+    span.attr("bytes", styleSheet.size());
+    app.setStyleSheet(styleSheet);
+    qCDebug(lcUi) << "[Theme] 已应用主题样式表，共" << styleSheet.size() << "字符";
+    return ok;
+}
+
+void setVariant(QWidget* widget, const char* property, const QVariant& value)
+{
+    if (widget->property(property) == value) {
+        return;
+    }
+    widget->setProperty(property, value);
+    // 属性选择器只在 polish 时求值，已显示的控件需要重新 polish 才能切换变体
+    widget->style()->unpolish(widget);
+    widget->style()->polish(widget);
+    widget->update();
+}
+
+} // namespace Theme
@@ -0,0 +1,31 @@
+#pragma once
+#include <QByteArray>
+#include <QVariant>
+
+class QApplication;
+class QWidget;
+
+// =============================
+// 界面主题
+// =============================
+// 所有 QSS（:/styles/ 下各视图的样式文件）在启动时读取一次，拼接后通过 QApplication::setStyleSheet
+// 在应用级别设置，Qt 只解析这一次；各视图与控件不再自行读取 QSS 或调用 setStyleSheet。
+// 每个文件中的规则都以所属视图的 objectName 限定作用范围（如 QWidget#userView QPushButton），互不影响。
+// 同一控件的状态差异（加载中、运行状态、提示文字类别等）通过动态属性选择样式变体，见 setVariant。
+namespace Theme {
+
+/**
+ * @brief 读取并在应用级别设置主题样式表，应在创建任何窗口之前调用一次
+ * @return 有样式文件读取失败时返回 false（其余文件仍会生效）
+ */
+bool apply(QApplication& app);
+
+/**
+ * @brief 设置控件的样式变体属性；值变化时才重新 polish 该控件
+ * @param widget 目标控件
+ * @param property 动态属性名，与 QSS 中的 [property="value"] 选择器对应
+ * @param value 新值
+ */
+void setVariant(QWidget* widget, const char* property, const QVariant& value);
+
+} // namespace Theme
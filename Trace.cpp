@@ -0,0 +1,278 @@
+#include "Trace.h"
+#include "TraceFormat.h"
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using TraceFormat::EventKind;
+
+namespace {
+
+// 每个线程保留的事件数（必须为 2 的幂），每条 64 字节，约 256 KB
+constexpr quint64 RING_CAPACITY = 4096;
+// 已退出线程的缓冲区最多保留的个数，超出时丢弃最早退出的
+constexpr size_t MAX_RETIRED_RINGS = 32;
+
+struct LiveEvent {
+    quint64 timestampNs;
+    const char* name;
+    EventKind kind;
+    quint16 stringBytes;
+    union {
+        qint64 intValue;
+        char stringValue[TraceFormat::INLINE_STRING_BYTES];
+    };
+};
+
+// 单写者环形缓冲区：只有所属线程写入，written 为累计写入条数
+struct ThreadRing {
+    quint32 threadId = 0;
+    QString threadName;
+    std::atomic<quint64> written{0};
+    std::atomic<bool> retired{false};
+    LiveEvent events[RING_CAPACITY];
+};
+
+struct ThreadRingHolder {
+    std::shared_ptr<ThreadRing> ring;
+    ~ThreadRingHolder()
+    {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+    }
+};
+
+std::atomic<bool> s_enabled{true};
+const std::chrono::steady_clock::time_point s_origin = std::chrono::steady_clock::now();
+const qint64 s_originEpochUs = QDateTime::currentMSecsSinceEpoch() * 1000;
+
+QMutex& registryMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+std::vector<std::shared_ptr<ThreadRing>>& registry()
+{
+    static std::vector<std::shared_ptr<ThreadRing>> rings;
+    return rings;
+}
+
+quint64 nowNs()
+{
+    return quint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_origin)
+                       .count());
+}
+
+ThreadRing* currentRing()
+{
+    thread_local ThreadRingHolder holder;
+    if (!holder.ring) {
+        auto ring = std::make_shared<ThreadRing>();
+        ring->threadId = quint32(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+        QThread* thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+            ring->threadName = QStringLiteral("GUI");
+        } else if (thread) {
+            ring->threadName = thread->objectName();
+        }
+
+        QMutexLocker locker(&registryMutex());
+        auto& rings = registry();
+        const auto retiredCount = std::count_if(rings.begin(), rings.end(), [](const std::shared_ptr<ThreadRing>& r) {
+            return r->retired.load(std::memory_order_acquire);
+        });
+        if (size_t(retiredCount) >= MAX_RETIRED_RINGS) {
+            rings.erase(std::find_if(rings.begin(), rings.end(), [](const std::shared_ptr<ThreadRing>& r) {
+                return r->retired.load(std::memory_order_acquire);
+            }));
+        }
+        rings.push_back(ring);
+        holder.ring = std::move(ring);
+    }
+    return holder.ring.get();
+}
+
+void record(EventKind kind, const char* name, qint64 intValue, const QString* text = nullptr)
+{
+    ThreadRing* ring = currentRing();
+    const quint64 index = ring->written.load(std::memory_order_relaxed);
+    LiveEvent& event = ring->events[index & (RING_CAPACITY - 1)];
+    event.timestampNs = nowNs();
+    event.name = name;
+    event.kind = kind;
+    if (text) {
+        const QByteArray utf8 = text->toUtf8();
+        qsizetype bytes = std::min<qsizetype>(utf8.size(), TraceFormat::INLINE_STRING_BYTES);
+        // 不在多字节字符中间截断
+        while (bytes > 0 && bytes < utf8.size() && (uchar(utf8.at(bytes)) & 0xC0) == 0x80) {
+            --bytes;
+        }
+        std::memcpy(event.stringValue, utf8.constData(), size_t(bytes));
+        event.stringBytes = quint16(bytes);
+    } else {
+        event.intValue = intValue;
+        event.stringBytes = 0;
+    }
+    ring->written.store(index + 1, std::memory_order_release);
+}
+
+void appendRaw(QByteArray& out, const void* data, size_t size)
+{
+    out.append(static_cast<const char*>(data), qsizetype(size));
+}
+
+} // namespace
+
+namespace Trace {
+
+void setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isEnabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+Span::Span(const char* name)
+    : m_name(name)
+    , m_active(s_enabled.load(std::memory_order_relaxed))
+{
+    if (m_active) record(EventKind::Begin, m_name, 0);
+}
+
+Span::~Span()
+{
+    if (m_active) record(EventKind::End, m_name, 0);
+}
+
+void Span::attr(const char* key, qint64 value)
+{
+    if (m_active) record(EventKind::AttrInt, key, value);
+}
+
+void Span::attr(const char* key, const QString& value)
+{
+    if (m_active) record(EventKind::AttrString, key, 0, &value);
+}
+
+void instant(const char* name, qint64 value)
+{
+    if (s_enabled.load(std::memory_order_relaxed)) record(EventKind::Instant, name, value);
+}
+
+void asyncBegin(const char* name, quint64 id)
+{
+    if (s_enabled.load(std::memory_order_relaxed)) record(EventKind::AsyncBegin, name, qint64(id));
+}
+
+void asyncEnd(const char* name, quint64 id)
+{
+    if (s_enabled.load(std::memory_order_relaxed)) record(EventKind::AsyncEnd, name, qint64(id));
+}
+
+QString defaultDumpFilePath()
+{
+    return QDir::currentPath() + "/trace.bin";
+}
+
+bool dump(const QString& filePath)
+{
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        QMutexLocker locker(&registryMutex());
+        rings = registry();
+    }
+
+    // 字符串表按内容去重（同一字面量在不同编译单元中地址可能不同）
+    QHash<QByteArray, quint32> stringIndex;
+    std::vector<QByteArray> strings;
+    auto intern = [&](const QByteArray& text) {
+        const auto it = stringIndex.constFind(text);
+        if (it != stringIndex.constEnd()) return *it;
+        const quint32 index = quint32(strings.size());
+        stringIndex.insert(text, index);
+        strings.push_back(text);
+        return index;
+    };
+
+    QByteArray threads;
+    quint32 threadCount = 0;
+    std::vector<LiveEvent> copy;
+    for (const auto& ring : rings) {
+        const quint64 end = ring->written.load(std::memory_order_acquire);
+        const quint64 begin = end > RING_CAPACITY ? end - RING_CAPACITY : 0;
+        copy.resize(size_t(end - begin));
+        for (quint64 i = begin; i < end; ++i) {
+            copy[size_t(i - begin)] = ring->events[i & (RING_CAPACITY - 1)];
+        }
+        // 复制期间所属线程可能继续写入，被覆盖（或正在写入）的槽位对应的记录不可信，丢弃
+        const quint64 after = ring->written.load(std::memory_order_acquire);
+        const quint64 validBegin = std::max(begin, after >= RING_CAPACITY ? after - RING_CAPACITY + 1 : quint64(0));
+        if (validBegin >= end) continue;
+
+        const QString name = ring->threadName.isEmpty() ? QStringLiteral("Thread %1").arg(ring->threadId)
+                                                        : ring->threadName;
+        TraceFormat::ThreadHeader header{};
+        header.threadId = ring->threadId;
+        header.nameIndex = intern(name.toUtf8());
+        header.eventCount = quint32(end - validBegin);
+        header.droppedCount = quint32(std::min<quint64>(validBegin, 0xFFFFFFFFu));
+        appendRaw(threads, &header, sizeof(header));
+        ++threadCount;
+
+        for (quint64 i = validBegin; i < end; ++i) {
+            const LiveEvent& live = copy[size_t(i - begin)];
+            TraceFormat::Event event{};
+            event.timestampNs = live.timestampNs;
+            event.nameIndex = intern(QByteArray(live.name));
+            event.kind = std::uint8_t(live.kind);
+            event.stringBytes = live.stringBytes;
+            if (live.kind == EventKind::AttrString) {
+                std::memcpy(event.stringValue, live.stringValue, live.stringBytes);
+            } else {
+                event.intValue = live.intValue;
+            }
+            appendRaw(threads, &event, sizeof(event));
+        }
+    }
+
+    TraceFormat::FileHeader fileHeader{};
+    std::memcpy(fileHeader.magic, TraceFormat::MAGIC, sizeof(fileHeader.magic));
+    fileHeader.version = TraceFormat::VERSION;
+    fileHeader.stringCount = quint32(strings.size());
+    fileHeader.threadCount = threadCount;
+    fileHeader.startEpochUs = s_originEpochUs;
+
+    QByteArray data;
+    appendRaw(data, &fileHeader, sizeof(fileHeader));
+    for (const QByteArray& text : strings) {
+        const quint32 size = quint32(text.size());
+        appendRaw(data, &size, sizeof(size));
+        data.append(text);
+    }
+    data.append(threads);
+
+    QSaveFile out(filePath);
+    if (!out.open(QIODevice::WriteOnly) || out.write(data) != data.size() || !out.commit()) {
+        qWarning() << "[Trace] 写入追踪转储失败:" << filePath << out.errorString();
+        return false;
+    }
+    qDebug() << "[Trace] 已写入追踪转储:" << filePath << data.size() << "bytes";
+    return true;
+}
+
+} // namespace Trace
@@ -0,0 +1,58 @@
+#pragma once
+#include <QString>
+#include <QtGlobal>
+
+// =============================
+// 结构化追踪 span
+// =============================
+// 轻量的耗时追踪：span 的开始、结束和键值属性以定长二进制记录写入当前线程的环形缓冲区，
+// 写入不加锁、不格式化；缓冲区写满后回绕覆盖最旧的记录，始终保留每个线程最近的一段时间线。
+// Trace::dump() 将所有线程的缓冲区写成 TraceFormat.h 描述的文件，
+// 再用 JianqiaoTraceToJson 转换为 Chrome / Perfetto 可打开的 trace JSON，在时间线上查看整条流程。
+//
+// 用法：
+//   Trace::Span span("config.load");      // 析构时结束
+//   span.attr("bytes", data.size());
+//
+// span 名与属性键必须是字符串字面量（只保存指针，转储时才复制）。
+// 开始与结束不在同一作用域（例如跨定时器回调的启动激活）时使用 asyncBegin/asyncEnd，以相同 id 配对。
+namespace Trace {
+
+// 是否记录（默认开启）；关闭后 span 构造只做一次原子读
+void setEnabled(bool enabled);
+bool isEnabled();
+
+class Span
+{
+public:
+    explicit Span(const char* name);
+    ~Span();
+
+    void attr(const char* key, qint64 value);
+    // 字符串值只保留前 TraceFormat::INLINE_STRING_BYTES 字节（UTF-8），路径请传文件名
+    void attr(const char* key, const QString& value);
+
+private:
+    Q_DISABLE_COPY(Span)
+
+    const char* m_name;
+    bool m_active;
+};
+
+// 瞬时事件（没有持续时间），可附带一个整数值
+void instant(const char* name, qint64 value = 0);
+// 异步 span：id 在同名 span 中唯一即可，可在不同线程开始与结束
+void asyncBegin(const char* name, quint64 id);
+void asyncEnd(const char* name, quint64 id);
+
+/**
+ * @brief 将所有线程缓冲区中的记录写入追踪转储文件
+ * @param filePath 目标文件（整体替换）
+ * @return 写入失败时返回 false
+ * @note 可在任意线程调用；正在记录的线程不会被阻塞，转储期间被覆盖的记录会被丢弃
+ */
+bool dump(const QString& filePath);
+// 默认转储位置：与 log.txt 同目录的 trace.bin
+QString defaultDumpFilePath();
+
+} // namespace Trace
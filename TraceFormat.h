@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+// =============================
+// 追踪转储文件格式
+// =============================
+// Trace::dump() 写出、tools/TraceToJson 读取的二进制格式，两边共用本头文件（不依赖 Qt）。
+// 布局（小端、紧凑排列）：
+//   FileHeader
+//   stringCount 个字符串：uint32 字节数 + UTF-8 内容（span 名、属性键、线程名）
+//   threadCount 个线程块：ThreadHeader + eventCount 个 Event（按时间先后）
+namespace TraceFormat {
+
+constexpr char MAGIC[8] = {'J', 'Q', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr std::uint32_t VERSION = 1;
+// 字符串属性值内联保存的最大字节数，超出部分截断
+constexpr int INLINE_STRING_BYTES = 40;
+
+enum class EventKind : std::uint8_t {
+    Begin = 1,      // 同步 span 开始
+    End = 2,        // 同步 span 结束
+    AttrInt = 3,    // 整数属性，属于本线程最内层未结束的 span
+    AttrString = 4, // 字符串属性，同上
+    AsyncBegin = 5, // 跨线程/跨事件循环的异步 span 开始，intValue 为 span 标识
+    AsyncEnd = 6,   // 异步 span 结束
+    Instant = 7     // 瞬时事件
+};
+
+#pragma pack(push, 1)
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t stringCount;
+    std::uint32_t threadCount;
+    std::uint32_t reserved;
+    std::int64_t startEpochUs; // 时间戳 0 对应的墙上时间（微秒）
+};
+
+struct ThreadHeader {
+    std::uint32_t threadId;
+    std::uint32_t nameIndex;     // 线程名在字符串表中的下标
+    std::uint32_t eventCount;
+    std::uint32_t droppedCount;  // 环形缓冲区回绕覆盖掉的事件数
+};
+
+struct Event {
+    std::uint64_t timestampNs;   // 相对进程启动的单调时间
+    std::uint32_t nameIndex;     // span 名或属性键
+    std::uint8_t kind;           // EventKind
+    std::uint8_t reserved;
+    std::uint16_t stringBytes;   // AttrString 时 stringValue 的有效字节数
+    union {
+        std::int64_t intValue;
+        char stringValue[INLINE_STRING_BYTES];
+    };
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FileHeader) == 32, "unexpected FileHeader size");
+static_assert(sizeof(ThreadHeader) == 16, "unexpected ThreadHeader size");
+static_assert(sizeof(Event) == 56, "unexpected Event size");
+
+} // namespace TraceFormat
@@ -0,0 +1,276 @@
+#include "UiHealthMonitor.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include <QAbstractEventDispatcher>
+#include <QMetaEnum>
+#include <QThread>
+#include <algorithm>
+
+static constexpr int DEFAULT_SLOW_EVENT_MS = 32;
+static constexpr int DEFAULT_HEARTBEAT_MS = 50;
+// 计算近期延迟所用的心跳数
+static constexpr int HEARTBEAT_WINDOW = 200;
+static constexpr int REPORT_INTERVAL_MS = 30000;
+static constexpr int REPORT_LIMIT = 5;
+
+bool UiHealthMonitor::s_active = false;
+
+static QString eventTypeName(QEvent::Type type)
+{
+    static const QMetaEnum typeEnum = QMetaEnum::fromType<QEvent::Type>();
+    const char* name = typeEnum.valueToKey(type);
+    return name ? QString::fromLatin1(name) : QString::number(int(type));
+}
+
+static QString receiverName(const QMetaObject* meta, const QString& objectName)
+{
+    const QString className = QString::fromLatin1(meta->className());
+    return objectName.isEmpty() ? className : className + QLatin1Char('#') + objectName;
+}
+
+static QList<UiHealthMonitor::Stat> sortedStats(QList<UiHealthMonitor::Stat> stats, qint64 UiHealthMonitor::Stat::*member, int limit)
+{
+    std::sort(stats.begin(), stats.end(), [member](const UiHealthMonitor::Stat& a, const UiHealthMonitor::Stat& b) {
+        return a.*member > b.*member;
+    });
+    if (limit >= 0 && stats.size() > limit) {
+        stats.resize(limit);
+    }
+    return stats;
+}
+
+UiHealthMonitor& UiHealthMonitor::instance()
+{
+    static UiHealthMonitor monitor;
+    return monitor;
+}
+
+UiHealthMonitor::UiHealthMonitor()
+    : m_slowEventNs(DEFAULT_SLOW_EVENT_MS * 1000000LL)
+    , m_recentLateness(HEARTBEAT_WINDOW, 0)
+{
+    m_clock.start();
+    m_heartbeatTimer.setTimerType(Qt::PreciseTimer);
+    m_heartbeatTimer.setInterval(DEFAULT_HEARTBEAT_MS);
+    connect(&m_heartbeatTimer, &QTimer::timeout, this, &UiHealthMonitor::onHeartbeat);
+    m_reportTimer.setInterval(REPORT_INTERVAL_MS);
+    connect(&m_reportTimer, &QTimer::timeout, this, &UiHealthMonitor::reportSlowEvents);
+}
+
+void UiHealthMonitor::applySettings(const QJsonObject& settings)
+{
+    const int slowEventMs = qBound(1, settings.value("slow_event_ms").toInt(DEFAULT_SLOW_EVENT_MS), 10000);
+    const int heartbeatMs = qBound(5, settings.value("heartbeat_ms").toInt(DEFAULT_HEARTBEAT_MS), 1000);
+    m_slowEventNs = slowEventMs * 1000000LL;
+    m_heartbeatTimer.setInterval(heartbeatMs);
+    m_configEnabled = settings.value("enabled").toBool(false);
+    updateActive();
+    qCDebug(lcUi) << "[UiHealth] 配置：" << (m_configEnabled ? "开启" : "关闭") << "，慢事件阈值" << slowEventMs
+                  << "ms，心跳间隔" << heartbeatMs << "ms";
+}
+
+void UiHealthMonitor::setOverlayAttached(bool attached)
+{
+    m_overlayAttached = attached;
+    updateActive();
+}
+
+void UiHealthMonitor::updateActive()
+{
+    const bool active = m_configEnabled || m_overlayAttached;
+    if (active == s_active) {
+        return;
+    }
+    s_active = active;
+    QAbstractEventDispatcher* dispatcher = QAbstractEventDispatcher::instance(thread());
+    if (active) {
+        m_lastBeatNs = 0;
+        m_blockStartNs = -1;
+        m_heartbeatTimer.start();
+        m_reportTimer.start();
+        if (dispatcher) {
+            connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, &UiHealthMonitor::onAboutToBlock,
+                    Qt::DirectConnection);
+            connect(dispatcher, &QAbstractEventDispatcher::awake, this, &UiHealthMonitor::onAwake, Qt::DirectConnection);
+        }
+    } else {
+        m_heartbeatTimer.stop();
+        m_reportTimer.stop();
+        if (dispatcher) {
+            disconnect(dispatcher, nullptr, this, nullptr);
+        }
+        reportSlowEvents();
+    }
+    qCInfo(lcUi) << "[UiHealth] GUI 线程健康监视已" << (active ? "开启" : "关闭");
+}
+
+void UiHealthMonitor::reset()
+{
+    m_recentLateness.fill(0);
+    m_recentIndex = 0;
+    m_maxLatenessNs = 0;
+    m_lateBeats = 0;
+    m_slowEvents.clear();
+    m_windowFrames.clear();
+    m_paintsByClass.clear();
+    m_unreportedSlowEvents = 0;
+}
+
+void UiHealthMonitor::record(Stat& stat, qint64 ns)
+{
+    ++stat.count;
+    stat.totalNs += ns;
+    stat.maxNs = qMax(stat.maxNs, ns);
+    stat.lastNs = ns;
+}
+
+void UiHealthMonitor::beginEventTiming()
+{
+    m_frames.append(Frame{m_clock.nsecsElapsed(), 0, 0, 0});
+}
+
+void UiHealthMonitor::onAboutToBlock()
+{
+    m_blockStartNs = m_frames.isEmpty() ? -1 : m_clock.nsecsElapsed(); // 顶层事件循环的等待不属于任何事件
+}
+
+void UiHealthMonitor::onAwake()
+{
+    if (m_blockStartNs < 0) {
+        return;
+    }
+    // 等待发生在最内层正在处理的事件所开启的嵌套循环中
+    if (!m_frames.isEmpty()) {
+        m_frames.last().blockedNs += m_clock.nsecsElapsed() - m_blockStartNs;
+    }
+    m_blockStartNs = -1;
+}
+
+void UiHealthMonitor::endEventTiming(const QMetaObject* meta, const QString& objectName, QEvent::Type type, bool isWindow)
+{
+    if (m_frames.isEmpty()) {
+        return;
+    }
+    const Frame frame = m_frames.takeLast();
+    const qint64 elapsedNs = m_clock.nsecsElapsed() - frame.startNs;
+    // 嵌套事件的耗时已含其中的空闲时间，因此自身耗时只需再扣除本事件嵌套循环的空闲
+    const qint64 selfNs = elapsedNs - frame.childNs - frame.blockedNs;
+    const qint64 totalNs = elapsedNs - frame.blockedNs - frame.childBlockedNs;
+    if (!m_frames.isEmpty()) {
+        m_frames.last().childNs += elapsedNs;
+        m_frames.last().childBlockedNs += frame.blockedNs + frame.childBlockedNs;
+    }
+
+    if (type == QEvent::UpdateRequest && isWindow) {
+        // 顶层窗口的 UpdateRequest 包含整次重绘（各子控件的 Paint 嵌套在其中），计总耗时
+        const QString key = receiverName(meta, objectName);
+        Stat& stat = m_windowFrames[key];
+        stat.key = key;
+        record(stat, totalNs);
+    } else if (type == QEvent::Paint) {
+        Stat& stat = m_paintsByClass[meta];
+        if (stat.key.isEmpty()) {
+            stat.key = QString::fromLatin1(meta->className());
+        }
+        record(stat, selfNs);
+    }
+
+    if (selfNs >= m_slowEventNs) {
+        const QString key = receiverName(meta, objectName) + QLatin1String(" / ") + eventTypeName(type);
+        Stat& stat = m_slowEvents[key];
+        stat.key = key;
+        record(stat, selfNs);
+        ++m_unreportedSlowEvents;
+        Trace::instant("ui.slowEvent", selfNs / 1000);
+        qCTrace(lcUi) << "[UiHealth] 慢事件" << key << selfNs / 1000 << "us";
+    }
+}
+
+void UiHealthMonitor::onHeartbeat()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+    if (m_lastBeatNs > 0) {
+        const qint64 latenessNs = qMax<qint64>(0, now - m_lastBeatNs - m_heartbeatTimer.interval() * 1000000LL);
+        m_recentLateness[m_recentIndex] = latenessNs;
+        m_recentIndex = (m_recentIndex + 1) % m_recentLateness.size();
+        m_maxLatenessNs = qMax(m_maxLatenessNs, latenessNs);
+        if (latenessNs >= m_slowEventNs) {
+            ++m_lateBeats;
+            Trace::instant("ui.heartbeatLate", latenessNs / 1000);
+        }
+    }
+    m_lastBeatNs = now;
+}
+
+UiHealthMonitor::HeartbeatStats UiHealthMonitor::heartbeat() const
+{
+    HeartbeatStats stats;
+    stats.intervalMs = m_heartbeatTimer.interval();
+    QVector<qint64> recent = m_recentLateness;
+    std::sort(recent.begin(), recent.end());
+    stats.recentMaxNs = recent.last();
+    stats.recentP95Ns = recent.at((recent.size() * 95) / 100);
+    stats.maxNs = m_maxLatenessNs;
+    stats.lateBeats = m_lateBeats;
+    return stats;
+}
+
+QList<UiHealthMonitor::Stat> UiHealthMonitor::slowEvents(int limit) const
+{
+    return sortedStats(m_slowEvents.values(), &Stat::maxNs, limit);
+}
+
+QList<UiHealthMonitor::Stat> UiHealthMonitor::windowFrames() const
+{
+    return sortedStats(m_windowFrames.values(), &Stat::maxNs, -1);
+}
+
+QList<UiHealthMonitor::Stat> UiHealthMonitor::paintsByClass(int limit) const
+{
+    return sortedStats(m_paintsByClass.values(), &Stat::totalNs, limit);
+}
+
+void UiHealthMonitor::reportSlowEvents()
+{
+    if (m_unreportedSlowEvents == 0) {
+        return;
+    }
+    const HeartbeatStats beats = heartbeat();
+    qCWarning(lcUi) << "[UiHealth] 新增" << m_unreportedSlowEvents << "个超过" << slowEventThresholdMs()
+                    << "ms 的事件处理；事件循环延迟近期最大" << beats.recentMaxNs / 1000000 << "ms，累计最大"
+                    << beats.maxNs / 1000000 << "ms";
+    for (const Stat& stat : slowEvents(REPORT_LIMIT)) {
+        qCWarning(lcUi).noquote() << "[UiHealth]   " << stat.key << "最大" << stat.maxNs / 1000000 << "ms，"
+                                  << stat.count << "次";
+    }
+    for (const Stat& stat : windowFrames()) {
+        qCInfo(lcUi).noquote() << "[UiHealth]   重绘" << stat.key << "平均" << (stat.totalNs / stat.count) / 1000 << "us，最大"
+                               << stat.maxNs / 1000 << "us";
+    }
+    m_unreportedSlowEvents = 0;
+}
+
+// ========== UiHealthApplication ========== //
+
+UiHealthApplication::UiHealthApplication(int& argc, char** argv)
+    : QApplication(argc, argv)
+{
+}
+
+bool UiHealthApplication::notify(QObject* receiver, QEvent* event)
+{
+    if (!UiHealthMonitor::isActive() || QThread::currentThread() != thread()) {
+        return QApplication::notify(receiver, event);
+    }
+    // 接收者可能在处理事件时被删除，计时所需的信息先取出
+    const QMetaObject* meta = receiver->metaObject();
+    const QString objectName = receiver->objectName();
+    const QEvent::Type type = event->type();
+    const bool isWindow = receiver->isWidgetType() && static_cast<QWidget*>(receiver)->isWindow();
+
+    UiHealthMonitor& monitor = UiHealthMonitor::instance();
+    monitor.beginEventTiming();
+    const bool result = QApplication::notify(receiver, event);
+    monitor.endEventTiming(meta, objectName, type, isWindow);
+    return result;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVarLengthArray>
+#include <QVector>
+
+// =============================
+// GUI 线程健康监视
+// =============================
+// 用于判断界面卡顿来自绘制、布局还是 GUI 线程上的阻塞调用：
+// - 心跳：高精度定时器按固定间隔触发，实际触发时刻比预期晚多少即事件循环延迟；
+// - 事件处理：UiHealthApplication::notify 对 GUI 线程的每个事件计时，扣除嵌套事件后的自身耗时
+//   达到阈值即记为慢事件，按"接收者类名#objectName / 事件类型"汇总；
+//   事件处理中打开的嵌套事件循环（QDialog::exec、QMessageBox、QMenu::exec 等）里等待输入的空闲时间
+//   通过事件调度器的 aboutToBlock / awake 扣除，不计入打开它的事件（系统原生模态循环不经过调度器，无法扣除）；
+// - 绘制：每个顶层窗口一次完整重绘（UpdateRequest）的耗时，以及按控件类汇总的 paintEvent 自身耗时。
+// 慢事件与迟到的心跳同时写入追踪（Trace::instant），可在时间线上与其它 span 对照；
+// 有新的慢事件时每 30 秒把最严重的几项写入日志（lcUi）。管理员可打开 UiHealthOverlay 实时查看。
+// 由 config.json 的 "ui_health" 节控制，默认关闭；关闭时 notify 只多一次布尔判断：
+//   "ui_health": { "enabled": true, "slow_event_ms": 32, "heartbeat_ms": 50 }
+// 仅在 GUI 线程使用。
+class UiHealthMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    // 一项耗时统计
+    struct Stat {
+        QString key;
+        int count = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+        qint64 lastNs = 0;
+    };
+    // 事件循环延迟统计（"近期"为最近 HEARTBEAT_WINDOW 次心跳）
+    struct HeartbeatStats {
+        int intervalMs = 0;
+        qint64 recentMaxNs = 0;
+        qint64 recentP95Ns = 0;
+        qint64 maxNs = 0;
+        int lateBeats = 0;    // 延迟达到慢事件阈值的心跳数
+    };
+
+    static UiHealthMonitor& instance();
+    // 是否正在计时；UiHealthApplication::notify 对每个事件查询
+    static bool isActive() { return s_active; }
+
+    /**
+     * @brief 按配置中的 "ui_health" 节设置阈值与开关，可在运行时重复调用
+     * @param settings 形如 {"enabled": true, "slow_event_ms": 32, "heartbeat_ms": 50} 的对象，缺失的键取默认值
+     */
+    void applySettings(const QJsonObject& settings);
+    // 浮层显示期间强制开启监视，与配置开关取或
+    void setOverlayAttached(bool attached);
+    int slowEventThresholdMs() const { return int(m_slowEventNs / 1000000); }
+    // 清空所有统计
+    void reset();
+
+    HeartbeatStats heartbeat() const;
+    // 慢事件，按最大自身耗时降序
+    QList<Stat> slowEvents(int limit) const;
+    // 各顶层窗口的重绘耗时
+    QList<Stat> windowFrames() const;
+    // 按控件类汇总的绘制自身耗时，按总耗时降序
+    QList<Stat> paintsByClass(int limit) const;
+
+    // ==== notify 计时入口（仅 UiHealthApplication 调用）====
+    void beginEventTiming();
+    void endEventTiming(const QMetaObject* meta, const QString& objectName, QEvent::Type type, bool isWindow);
+
+private:
+    UiHealthMonitor();
+    Q_DISABLE_COPY(UiHealthMonitor)
+
+    void updateActive();
+    void onHeartbeat();
+    // 事件调度器进入 / 结束等待，用于扣除嵌套事件循环中的空闲时间
+    void onAboutToBlock();
+    void onAwake();
+    void reportSlowEvents();
+    static void record(Stat& stat, qint64 ns);
+
+    // 正在处理的嵌套事件：开始时刻、其中嵌套事件的总耗时（含空闲）、
+    // 自身嵌套循环的空闲时间以及嵌套事件中累计的空闲时间
+    struct Frame {
+        qint64 startNs;
+        qint64 childNs;
+        qint64 blockedNs;
+        qint64 childBlockedNs;
+    };
+
+    static bool s_active;
+    bool m_configEnabled = false;
+    bool m_overlayAttached = false;
+    qint64 m_slowEventNs;
+
+    QElapsedTimer m_clock;
+    QVarLengthArray<Frame, 16> m_frames;
+    qint64 m_blockStartNs = -1;          // 调度器开始等待的时刻，未在等待时为 -1
+
+    QTimer m_heartbeatTimer;
+    qint64 m_lastBeatNs = 0;
+    QVector<qint64> m_recentLateness;    // 环形缓冲
+    int m_recentIndex = 0;
+    qint64 m_maxLatenessNs = 0;
+    int m_lateBeats = 0;
+
+    QHash<QString, Stat> m_slowEvents;
+    QHash<QString, Stat> m_windowFrames;
+    QHash<const QMetaObject*, Stat> m_paintsByClass;
+    int m_unreportedSlowEvents = 0;
+    QTimer m_reportTimer;
+};
+
+// =============================
+// 带事件计时的 QApplication
+// =============================
+// 监视开启时为 GUI 线程的每个事件计时并交给 UiHealthMonitor；其余行为与 QApplication 相同。
+class UiHealthApplication : public QApplication
+{
+    Q_OBJECT
+public:
+    UiHealthApplication(int& argc, char** argv);
+
+    bool notify(QObject* receiver, QEvent* event) override;
+};
@@ -0,0 +1,123 @@
+#include "UiHealthOverlay.h"
+#include "UiHealthMonitor.h"
+#include <QEvent>
+#include <QFontMetrics>
+#include <QPainter>
+
+static constexpr int REFRESH_INTERVAL_MS = 500;
+static constexpr int OVERLAY_MARGIN = 12;
+static constexpr int OVERLAY_PADDING = 10;
+static constexpr int PAINT_CLASS_LIMIT = 6;
+static constexpr int SLOW_EVENT_LIMIT = 8;
+
+static QString formatMs(qint64 ns)
+{
+    return QString::number(ns / 1e6, 'f', 1) + QStringLiteral(" ms");
+}
+
+UiHealthOverlay::UiHealthOverlay(QWidget* host)
+    : QWidget(host)
+{
+    setObjectName("uiHealthOverlay");
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+    QFont overlayFont(QStringLiteral("Consolas"));
+    overlayFont.setStyleHint(QFont::Monospace);
+    overlayFont.setPointSize(9);
+    setFont(overlayFont);
+
+    m_refreshTimer.setInterval(REFRESH_INTERVAL_MS);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &UiHealthOverlay::refresh);
+    host->installEventFilter(this);
+    hide();
+}
+
+void UiHealthOverlay::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    UiHealthMonitor::instance().setOverlayAttached(true);
+    m_refreshTimer.start();
+    refresh();
+}
+
+void UiHealthOverlay::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+    m_refreshTimer.stop();
+    UiHealthMonitor::instance().setOverlayAttached(false);
+}
+
+bool UiHealthOverlay::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == parentWidget() && event->type() == QEvent::Resize && isVisible()) {
+        reposition();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void UiHealthOverlay::refresh()
+{
+    const UiHealthMonitor& monitor = UiHealthMonitor::instance();
+    const UiHealthMonitor::HeartbeatStats beats = monitor.heartbeat();
+
+    m_lines.clear();
+    m_lines << QStringLiteral("GUI 线程健康（Ctrl+Shift+F12 关闭）");
+    m_lines << QStringLiteral("事件循环延迟  近期最大 %1 · P95 %2 · 累计最大 %3 · 超时 %4 次")
+                   .arg(formatMs(beats.recentMaxNs), formatMs(beats.recentP95Ns), formatMs(beats.maxNs))
+                   .arg(beats.lateBeats);
+    m_lines << QString() << QStringLiteral("窗口重绘");
+    for (const UiHealthMonitor::Stat& stat : monitor.windowFrames()) {
+        m_lines << QStringLiteral("  %1  最近 %2 · 平均 %3 · 最大 %4 · %5 次")
+                       .arg(stat.key, formatMs(stat.lastNs), formatMs(stat.totalNs / stat.count), formatMs(stat.maxNs))
+                       .arg(stat.count);
+    }
+    m_lines << QString() << QStringLiteral("绘制（按控件类，自身耗时）");
+    for (const UiHealthMonitor::Stat& stat : monitor.paintsByClass(PAINT_CLASS_LIMIT)) {
+        m_lines << QStringLiteral("  %1  平均 %2 · 最大 %3 · %4 次")
+                       .arg(stat.key, formatMs(stat.totalNs / stat.count), formatMs(stat.maxNs))
+                       .arg(stat.count);
+    }
+    m_lines << QString() << QStringLiteral("慢事件（≥ %1 ms）").arg(monitor.slowEventThresholdMs());
+    const QList<UiHealthMonitor::Stat> slowEvents = monitor.slowEvents(SLOW_EVENT_LIMIT);
+    if (slowEvents.isEmpty()) {
+        m_lines << QStringLiteral("  无");
+    }
+    for (const UiHealthMonitor::Stat& stat : slowEvents) {
+        m_lines << QStringLiteral("  %1  最大 %2 · %3 次").arg(stat.key, formatMs(stat.maxNs)).arg(stat.count);
+    }
+
+    const QFontMetrics metrics(font());
+    int width = 0;
+    for (const QString& line : qAsConst(m_lines)) {
+        width = qMax(width, metrics.horizontalAdvance(line));
+    }
+    resize(width + 2 * OVERLAY_PADDING, m_lines.size() * metrics.lineSpacing() + 2 * OVERLAY_PADDING);
+    reposition();
+    raise(); // 视图切换后保持在最上层
+    update();
+}
+
+void UiHealthOverlay::reposition()
+{
+    if (QWidget* host = parentWidget()) {
+        move(host->width() - width() - OVERLAY_MARGIN, OVERLAY_MARGIN);
+    }
+}
+
+void UiHealthOverlay::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 190));
+    painter.drawRoundedRect(rect(), 6, 6);
+
+    const QFontMetrics metrics(font());
+    painter.setPen(QColor(230, 230, 230));
+    int y = OVERLAY_PADDING + metrics.ascent();
+    for (const QString& line : qAsConst(m_lines)) {
+        painter.drawText(OVERLAY_PADDING, y, line);
+        y += metrics.lineSpacing();
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <QStringList>
+#include <QTimer>
+#include <QWidget>
+
+// =============================
+// GUI 线程健康浮层
+// =============================
+// 叠在宿主窗口右上角的半透明信息层，每 500 ms 读取 UiHealthMonitor 的统计并重绘：
+// 事件循环延迟、各顶层窗口的重绘耗时、按控件类汇总的绘制耗时以及最严重的慢事件。
+// 显示期间强制开启监视；不接收鼠标事件，不影响下层界面操作。
+class UiHealthOverlay : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit UiHealthOverlay(QWidget* host);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    // 重新生成文本并按内容调整大小
+    void refresh();
+    // 贴到宿主右上角
+    void reposition();
+
+    QStringList m_lines;
+    QTimer m_refreshTimer;
+};
@@ -5,11 +5,11 @@
 #include <QObject>
 #include <QList>
 #include <QMap> // For QMap
-#include <QProcess>
-#include <QTimer>
+#include "LaunchController.h"
 #include "UserView.h"       // For m_userView interaction
 #include "SystemInteractionModule.h" // For icon fetching and process interaction
 #include "JianqiaoCoreShell.h"
+#include "ConfigStore.h"
 #include <QSet>
 
 // 前置声明
@@ -101,22 +101,16 @@ public:
      */
     void updateUserAppList(const QList<AppInfo>& apps);
     /**
-     * @brief 终止所有已启动的进程
+     * @brief 终止所有已启动的进程（仅在退出流程中调用）
      */
     void terminateActiveProcesses();
 
-    /**
-     * @brief 获取配置文件路径（静态方法）
-     * @return 配置文件绝对路径
-     */
-    static QString getConfigFilePath();
-
 signals:
     /** 用户模式激活信号 */
     void userModeActivated();
     /** 用户模式关闭信号 */
     void userModeDeactivated();
-    /** 应用启动失败信号 */
+    /** 应用启动失败信号（UserView 据此在 Dock 下方显示提示） */
     void applicationFailedToLaunch(const QString& appName, const QString& error);
     /** 白名单应用列表更新信号 */
     void userAppListUpdated(const QList<AppInfo>& apps);
@@ -128,84 +122,35 @@ public slots:
      * @param appName 应用名称
      */
     void onApplicationLaunchRequested(const QString& appPath, const QString& appName);
+
+private slots:
     /**
-     * @brief 进程状态变化槽
-     * @param newState 新状态
-     */
-    void onProcessStateChanged(QProcess::ProcessState newState);
-    /**
-     * @brief 应用窗口激活成功槽
-     * @param appPath 应用路径
-     */
-    void onApplicationActivated(const QString& appPath);
-    /**
-     * @brief 应用窗口激活失败槽
+     * @brief 启动状态变化时更新界面：启动中显示加载动画，激活后高亮状态栏，失败时发出 applicationFailedToLaunch
      * @param appPath 应用路径
+     * @param state 新状态
+     * @param detail 失败时的错误描述
      */
-    void onApplicationActivationFailed(const QString& appPath);
+    void onLaunchStateChanged(const QString& appPath, LaunchController::State state, const QString& detail);
     /**
-     * @brief 进程启动完成槽
-     * @param appPath 应用路径
+     * @brief 配置文件被外部修改后增量更新白名单，只重建受影响的卡片
+     * @param diff 配置差异
      */
-    void onProcessStarted(const QString& appPath);
-    /**
-     * @brief 进程结束槽
-     * @param appPath 应用路径
-     * @param exitCode 退出码
-     * @param exitStatus 退出状态
-     */
-    void onProcessFinished(const QString& appPath, int exitCode, QProcess::ExitStatus exitStatus);
-    /**
-     * @brief 进程错误槽
-     * @param appPath 应用路径
-     * @param error 错误类型
-     */
-    void onProcessError(const QString& appPath, QProcess::ProcessError error);
+    void onConfigReloaded(const ConfigStore::ConfigDiff& diff);
 
 private:
     /**
-     * @brief 启动应用进程
-     * @param appPath 应用路径
-     * @param appName 应用名称
-     */
-    void launchApplication(const QString& appPath, const QString& appName);
-    /**
-     * @brief 监控已启动进程
-     * @param process 进程指针
-     * @param appName 应用名称
-     */
-    void monitorLaunchedProcess(QProcess* process, const QString& appName);
-    /**
-     * @brief 查找可执行文件名
+     * @brief 按路径查找白名单应用
      * @param appPath 应用路径
-     * @return 可执行文件名
-     */
-    QString findExecutableName(const QString& appPath) const;
-    /**
-     * @brief 启动进程监控定时器
-     */
-    void startProcessMonitoringTimer();
-    /**
-     * @brief 定时监控所有已启动进程
-     */
-    void monitorLaunchedProcesses();
-    /**
-     * @brief 根据进程指针查找应用路径
-     * @param process 进程指针
-     * @return 应用路径
+     * @return 找不到时返回 nullptr
      */
-    QString findAppPathForProcess(QProcess* process);
+    const AppInfo* findWhitelistedApp(const QString& appPath) const;
 
     JianqiaoCoreShell *m_coreShellPtr; ///< 主程序核心指针
     UserView *m_userViewPtr; ///< 用户视图指针
     SystemInteractionModule *m_systemInteractionModulePtr; ///< 系统交互模块指针
     QList<AppInfo> m_whitelistedApps; ///< 白名单应用列表
-    QHash<QString, QProcess*> m_launchedProcesses; ///< 已启动进程映射（appPath->QProcess*）
-    QTimer* m_processMonitoringTimer; ///< 进程监控定时器
+    LaunchController* m_launchController; ///< 应用启动状态机（异步启动、超时与窗口激活）
     bool m_configLoaded = false; ///< 配置是否已加载
-    QMap<QString, QTimer*> m_launchTimers; ///< 启动超时定时器映射
-    QSet<QString> m_launchingApps; ///< 正在启动的应用路径集合
-    QSet<QString> m_pendingActivationApps; ///< 等待激活的应用路径集合
     QString m_configFilePath; ///< 配置文件路径
 };
 
@@ -1,19 +1,26 @@
 #include "UserView.h"
-#include "AppCardWidget.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include "BackgroundRenderer.h"
+#include "DockView.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFrame>
-#include <QScrollArea>
 #include <QLabel>
 #include <QDebug>
 #include <QPainter>
 #include <QTimer>
 #include <QResizeEvent>
+#include <QPaintEvent>
 #include <QPixmap>
 #include "AppStatusBar.h"
 #include "AppStatusModel.h"
 #include "SystemInteractionModule.h"
-#include <QFile>
+
+// 启动失败提示的显示时长
+static constexpr int LAUNCH_FAILURE_TOAST_MS = 6000;
+// 提示与 Dock 下边缘的间距
+static constexpr int LAUNCH_FAILURE_TOAST_GAP = 16;
 
 //======================== UserView类实现 ========================
 
@@ -22,12 +29,11 @@ UserView::UserView(QWidget *parent)
     : QWidget(parent),
       m_mainLayout(nullptr),
       m_dockFrame(nullptr),
-      m_dockScrollArea(nullptr),
-      m_dockScrollContentWidget(nullptr),
-      m_dockItemsLayout(nullptr),
+      m_dockView(nullptr),
       m_isFirstShow(true)
 {
-    qDebug() << "用户视图(UserView): 已创建。";
+    qCDebug(lcUi) << "用户视图(UserView): 已创建。";
+    m_background = new BackgroundRenderer(this, QColor(30, 30, 30)); // 默认深色背景
     setupUi(); // 初始化界面
     setCurrentBackground(":/images/user_bg.jpg"); // 设置默认背景图
     this->setObjectName("userView"); 
@@ -36,8 +42,7 @@ UserView::UserView(QWidget *parent)
 // 析构函数：清理资源
 UserView::~UserView()
 {
-    qDebug() << "用户视图(UserView): 已销毁。";
-    clearAppCards(); // 清理所有App卡片和定时器
+    qCDebug(lcUi) << "用户视图(UserView): 已销毁。";
 }
 
 // 初始化界面布局和控件
@@ -62,28 +67,13 @@ void UserView::setupUi() {
     QVBoxLayout* dockFrameInternalLayout = new QVBoxLayout(m_dockFrame); 
     dockFrameInternalLayout->setContentsMargins(0, 5, 0, 5);
     
-    // Dock栏滚动区域，横向滚动，禁止竖直滚动
-    m_dockScrollArea = new QScrollArea(m_dockFrame); 
-    m_dockScrollArea->setObjectName("dockScrollArea");
-    m_dockScrollArea->setWidgetResizable(true);
-    m_dockScrollArea->setFrameShape(QFrame::NoFrame);
-    m_dockScrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    m_dockScrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    m_dockScrollArea->setFixedHeight(256); 
-    m_dockScrollArea->setAlignment(Qt::AlignCenter);
-
-    // Dock栏内容区，承载所有App卡片
-    m_dockScrollContentWidget = new QWidget(); 
-    m_dockScrollContentWidget->setObjectName("dockScrollContentWidget");
-    m_dockScrollArea->setWidget(m_dockScrollContentWidget);
-
-    // Dock栏卡片横向布局，卡片居中排列
-    m_dockItemsLayout = new QHBoxLayout(m_dockScrollContentWidget);
-    m_dockItemsLayout->setContentsMargins(5, 0, 5, 0);
-    m_dockItemsLayout->setSpacing(5);
-    m_dockItemsLayout->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
+    // Dock栏卡片视图，横向滚动，禁止竖直滚动；只为可见槽位创建卡片，卡片居中排列
+    m_dockView = new DockView(m_dockFrame);
+    m_dockView->setObjectName("dockScrollArea");
+    m_dockView->setFixedHeight(256);
+    connect(m_dockView, &DockView::launchAppRequested, this, &UserView::onCardLaunchRequested);
 
-    dockFrameInternalLayout->addWidget(m_dockScrollArea);
+    dockFrameInternalLayout->addWidget(m_dockView);
     m_dockFrame->setLayout(dockFrameInternalLayout);
 
     // Dock栏整体居中
@@ -100,53 +90,48 @@ void UserView::setupUi() {
     m_statusBar->setModel(m_statusModel);//设置模型
     m_mainLayout->addWidget(m_statusBar); // 添加到底部
 
-    // 定时刷新应用状态，每秒刷新一次
-    m_statusRefreshTimer = new QTimer(this);
-    m_statusRefreshTimer->setInterval(1000);
-    connect(m_statusRefreshTimer, &QTimer::timeout, this, [this]() {
-        // 定时获取所有应用状态并刷新状态栏
-        extern SystemInteractionModule* systemInteractionModule; // 需在主程序中定义
-        if (systemInteractionModule) {
-            QList<AppStatus> statusList = systemInteractionModule->getAllAppStatus(m_currentApps);
-            m_statusModel->updateStatus(statusList);
-        }
-    });
-    m_statusRefreshTimer->start();
+    // 应用状态由监视器在进程/窗口事件发生时推送，不再定时轮询
+    m_statusMonitor = new AppStatusMonitor(this);
+    connect(m_statusMonitor, &AppStatusMonitor::statusTableReset, m_statusModel, &AppStatusModel::updateStatus);
+    connect(m_statusMonitor, &AppStatusMonitor::appStatusChanged, m_statusModel, &AppStatusModel::updateAppStatus);
+
+    // 启动失败提示：不参与布局，显示时浮在 Dock 下方，鼠标可穿透
+    m_launchFailureToast = new QLabel(this);
+    m_launchFailureToast->setObjectName("launchFailureToast"); // 样式见 UserView.qss
+    m_launchFailureToast->setAlignment(Qt::AlignCenter);
+    m_launchFailureToast->setWordWrap(true);
+    m_launchFailureToast->setAttribute(Qt::WA_TransparentForMouseEvents);
+    m_launchFailureToast->hide();
+    m_launchFailureTimer.setSingleShot(true);
+    m_launchFailureTimer.setInterval(LAUNCH_FAILURE_TOAST_MS);
+    connect(&m_launchFailureTimer, &QTimer::timeout, m_launchFailureToast, &QWidget::hide);
 
     setLayout(m_mainLayout);
-    this->setObjectName("userView");
-    // 加载并应用 UserView.qss 样式表
-    QFile userViewStyleFile(":/styles/UserView.qss");
-    if (userViewStyleFile.open(QFile::ReadOnly | QFile::Text)) {
-        QString userViewStyleSheet = QLatin1String(userViewStyleFile.readAll());
-        this->setStyleSheet(userViewStyleSheet);
-        userViewStyleFile.close();
-    } else {
-        qWarning() << "UserView: Could not load QSS file.";
-    }
-}
-
-// 清空所有App卡片及相关定时器，释放资源
-void UserView::clearAppCards() {
-    for (AppCardWidget* card : qAsConst(m_appCards)) {
-        if (card) {
-            m_dockItemsLayout->removeWidget(card);
-            card->deleteLater();
-        }
-    }
-    m_appCards.clear();
-    qDeleteAll(m_launchTimers);
-    m_launchTimers.clear();
-    m_launchingApps.clear();
+    this->setObjectName("userView"); // UserView.qss 中的规则以此限定，样式表由 Theme 在应用级别设置
 }
 
 // 设置当前应用列表并刷新界面
 void UserView::setAppList(const QList<AppInfo>& apps) {
     m_currentApps = apps;
-    qDebug() << "UserView::setAppList - 收到新白名单，数量:" << apps.count() << ", 当前视图可见:" << isVisible();
+    if (m_statusMonitor) {
+        m_statusMonitor->setWatchedApps(m_currentApps);
+    }
+    qCDebug(lcUi) << "UserView::setAppList - 收到新白名单，数量:" << apps.count() << ", 当前视图可见:" << isVisible();
     populateAppList(m_currentApps);
 }
 
+void UserView::applyAppChanges(const QList<AppInfo>& apps, const QSet<QString>& changedPaths) {
+    m_currentApps = apps;
+    if (m_statusMonitor) {
+        m_statusMonitor->setWatchedApps(m_currentApps);
+    }
+    if (m_isFirstShow || !m_dockView) {
+        return; // 尚未填充过 Dock，首次显示时按完整列表填充
+    }
+    qCDebug(lcUi) << "UserView::applyAppChanges - 增量更新白名单，数量:" << apps.count() << ", 变化:" << changedPaths.size();
+    m_dockView->applyAppChanges(m_currentApps, changedPaths); // 已删除应用的加载状态由 DockView 一并清除
+}
+
 // 首次显示时填充应用列表
 void UserView::showEvent(QShowEvent *event) {
     QWidget::showEvent(event);
@@ -160,68 +145,31 @@ void UserView::showEvent(QShowEvent *event) {
 void UserView::resizeEvent(QResizeEvent *event) {
     QWidget::resizeEvent(event);
     updateDockFrameOptimalWidth();
-    updateDockItemsLayoutAlignment();
-}
-
-void UserView::updateDockItemsLayoutAlignment()
-{
-    if (!m_dockItemsLayout || !m_dockScrollArea || !m_dockScrollContentWidget) return;
-
-    // 计算所有卡片总宽度
-    int totalCardWidth = 0;
-    for (AppCardWidget* card : m_appCards) {
-        totalCardWidth += card->width() + m_dockItemsLayout->spacing();
-    }
-    int visibleWidth = m_dockScrollArea->viewport()->width();
-
-    // 设置内容区最小宽度，保证未溢出时居中
-    if (totalCardWidth < visibleWidth) {
-        m_dockScrollContentWidget->setMinimumWidth(visibleWidth);
-    } else {
-        m_dockScrollContentWidget->setMinimumWidth(totalCardWidth);
+    if (m_launchFailureToast && m_launchFailureToast->isVisible()) {
+        positionLaunchFailureToast();
     }
 }
 
-// 填充应用卡片到Dock栏，先清空再插入新卡片
+// 填充应用到Dock栏：DockView 只为可见槽位创建（或复用）卡片
 void UserView::populateAppList(const QList<AppInfo>& apps) {
-    qDebug() << "UserView::populateAppList - Received" << apps.count() << "apps. Clearing existing cards.";
+    qCDebug(lcUi) << "UserView::populateAppList - Received" << apps.count() << "apps.";
     for (const AppInfo& app : apps) {
-        qDebug() << "  App:" << app.name << "Path:" << app.path << "Icon isNull:" << app.icon.isNull();
+        qCTrace(lcUi) << "  App:" << app.name << "Path:" << app.path << "Icon isNull:" << app.icon.isNull();
     }
-    clearAppCards();
     m_currentApps = apps;
     
-    if (!m_dockItemsLayout) {
-        qWarning() << "UserView::populateAppList: m_dockItemsLayout is null!";
+    if (!m_dockView) {
+        qCWarning(lcUi) << "UserView::populateAppList: m_dockView is null!";
         return;
     }
-
-    // 居中插入卡片，实现从中间向两边扩散排列
-    for (const AppInfo& appInfo : qAsConst(m_currentApps)) {
-        QIcon icon = appInfo.icon;
-        if (icon.isNull()) {
-            // 只在首次发现icon为null时警告，避免重复
-            static QSet<QString> warnedApps;
-            if (!warnedApps.contains(appInfo.name)) {
-                qWarning() << "UserView: Icon for" << appInfo.name << "is null. AppCardWidget will use default icon.";
-                warnedApps.insert(appInfo.name);
-            }
-        }
-        AppCardWidget *card = new AppCardWidget(appInfo.name, appInfo.path, icon, m_dockScrollContentWidget);
-        connect(card, &AppCardWidget::launchAppRequested, this, &UserView::onCardLaunchRequested);
-        int mid = m_dockItemsLayout->count() / 2;
-        m_dockItemsLayout->insertWidget(mid, card);
-        m_appCards.append(card);
-    }
-    if (m_dockScrollContentWidget) { 
-        m_dockScrollContentWidget->adjustSize();
-    }
+    // icon 为空时卡片先显示占位图标，再异步加载可执行文件图标
+    m_dockView->setApps(m_currentApps);
     updateDockFrameOptimalWidth();
 }
 
 // 动态调整Dock栏宽度（如需自适应，当前由布局和QSS控制）
 void UserView::updateDockFrameOptimalWidth() {
-    if (!m_dockFrame || !m_dockScrollContentWidget || !this->parentWidget()) {
+    if (!m_dockFrame || !m_dockView || !this->parentWidget()) {
         return;
     }
     // 目前宽度由布局和QSS控制，无需手动设置
@@ -229,86 +177,56 @@ void UserView::updateDockFrameOptimalWidth() {
 
 // 设置背景图片，imagePath为空则清除背景
 void UserView::setCurrentBackground(const QString& imagePath) {
+    // 解码与缩放在后台进行，完成后自动重绘
+    m_background->setImage(imagePath);
     if (imagePath.isEmpty()) {
-        m_currentBackground = QPixmap();
-        qDebug() << "UserView: Background image cleared.";
+        qCDebug(lcUi) << "UserView: Background image cleared.";
     } else {
-        if (!m_currentBackground.load(imagePath)) {
-            qWarning() << "UserView: Failed to load background image from" << imagePath;
-            m_currentBackground = QPixmap();
-        }
-         qDebug() << "UserView: Background image set to" << imagePath;
+        qCDebug(lcUi) << "UserView: Background image set to" << imagePath;
     }
-    update(); // 触发重绘
 }
 
 // 绘制背景图片或默认背景色
 void UserView::paintEvent(QPaintEvent *event) {
-    Q_UNUSED(event);
+    Trace::Span span("ui.paint.userView");
     QPainter painter(this);
-    if (!m_currentBackground.isNull()) {
-        painter.drawPixmap(this->rect(), m_currentBackground);
-    } else {
-        painter.fillRect(this->rect(), QColor(30, 30, 30)); // 默认深色背景
-    }
-}
-
-// 根据应用路径查找对应的App卡片，找不到返回nullptr
-AppCardWidget* UserView::findAppCardByPath(const QString& appPath) const {
-    for (AppCardWidget* card : qAsConst(m_appCards)) {
-        if (card && card->getAppPath() == appPath) {
-            return card;
-        }
-    }
-    return nullptr;
+    m_background->paint(painter, event->rect());
 }
 
 // 处理应用卡片的启动请求信号，转发为UserView信号
 void UserView::onCardLaunchRequested(const QString& appPath, const QString& appName) {
-    qDebug() << "UserView: Launch requested for" << appName << "at" << appPath;
+    qCDebug(lcUi) << "UserView: Launch requested for" << appName << "at" << appPath;
+    if (m_statusMonitor) {
+        m_statusMonitor->expectProcessStart(); // 无窗口的程序不会触发窗口事件，主动匹配新进程
+    }
     emit applicationLaunchRequested(appPath, appName);
 }
 
-// 设置指定应用的加载中状态，并管理超时定时器
+// 设置指定应用的加载中状态（启动超时由 LaunchController 统一调度，结束时由其通知）
 void UserView::setAppLoadingState(const QString& appPath, bool isLoading) {
-    AppCardWidget* card = findAppCardByPath(appPath);
-    if (card) {
-        card->setLoadingState(isLoading);
-    } else {
-        qWarning() << "UserView: Could not find app card for path:" << appPath << "to set loading state.";
-    }
-    if (isLoading) {
-        // 启动时添加定时器，超时自动重置状态
-        if (!m_launchingApps.contains(appPath)) {
-            m_launchingApps.insert(appPath);
-            QTimer* timer = new QTimer(this);
-            timer->setSingleShot(true);
-            connect(timer, &QTimer::timeout, this, [this, appPath]() { this->onLaunchTimerTimeout(appPath); });
-            m_launchTimers.insert(appPath, timer);
-            timer->start(LAUNCH_TIMEOUT_MS);
-        }
+    if (m_dockView && m_dockView->hasApp(appPath)) {
+        m_dockView->setAppLoading(appPath, isLoading); // 卡片不可见时由 DockView 记录，滚动到可见时生效
     } else {
-        // 结束时移除定时器
-        m_launchingApps.remove(appPath);
-        if (m_launchTimers.contains(appPath)) {
-            QTimer* timer = m_launchTimers.value(appPath);
-            if (timer) {
-                timer->stop();
-                timer->deleteLater();
-            }
-            m_launchTimers.remove(appPath);
-        }
+        qCWarning(lcUi) << "UserView: Could not find app card for path:" << appPath << "to set loading state.";
     }
 }
 
-// 启动超时处理槽函数，超时后重置加载状态
-void UserView::onLaunchTimerTimeout(const QString& appPath) {
-    if (m_launchingApps.contains(appPath)) {
-        qWarning() << "UserView: Launch timed out for" << appPath;
-        this->setAppLoadingState(appPath, false);
-    } else {
-        qWarning() << "UserView: Launch timer for" << appPath << "fired, but app not in launching state or path mismatch.";
-    }
+// 显示启动失败提示；连续失败时只保留最新一条，并重新计时
+void UserView::showLaunchFailure(const QString& appName, const QString& error) {
+    qCInfo(lcUi) << "UserView: 启动失败提示:" << appName << error;
+    m_launchFailureToast->setText(tr("无法启动「%1」：%2").arg(appName, error));
+    positionLaunchFailureToast();
+    m_launchFailureToast->show();
+    m_launchFailureToast->raise();
+    m_launchFailureTimer.start();
+}
+
+void UserView::positionLaunchFailureToast() {
+    const int maxWidth = qMin(width() - 2 * LAUNCH_FAILURE_TOAST_GAP, APP_MAX_DOCK_WIDTH / 2);
+    m_launchFailureToast->setMaximumWidth(qMax(0, maxWidth));
+    m_launchFailureToast->adjustSize();
+    const int y = m_dockFrame ? m_dockFrame->geometry().bottom() + LAUNCH_FAILURE_TOAST_GAP : height() / 2;
+    m_launchFailureToast->move((width() - m_launchFailureToast->width()) / 2, y);
 }
 
 // 设置状态栏高亮指定应用
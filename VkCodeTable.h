@@ -0,0 +1,192 @@
+#pragma once
+#include <windows.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// =============================
+// 虚拟键名称 <-> VK 码 编译期查找表
+// =============================
+// 名称 -> VK 码：编译期构造的两级完美哈希（hash-and-displace），查找为 O(1)，无堆分配、无静态初始化开销。
+// VK 码 -> 名称：256 项稠密数组直接索引。
+// 名称均为大写规范形式，与 config.json 中的写法一致（如 "VK_LCONTROL"、"A"、"F5"）。
+namespace VkCodeTable {
+
+struct Entry {
+    const char* name;
+    unsigned char code;
+};
+
+inline constexpr Entry kEntries[] = {
+    // Modifiers
+    {"VK_LCONTROL", VK_LCONTROL}, {"VK_RCONTROL", VK_RCONTROL},
+    {"VK_LSHIFT", VK_LSHIFT},     {"VK_RSHIFT", VK_RSHIFT},
+    {"VK_LMENU", VK_LMENU},       {"VK_RMENU", VK_RMENU},       // Left/Right Alt
+    {"VK_CONTROL", VK_CONTROL},   {"VK_SHIFT", VK_SHIFT},   {"VK_MENU", VK_MENU},
+    {"VK_LWIN", VK_LWIN},         {"VK_RWIN", VK_RWIN},
+    // Letters
+    {"A", 'A'}, {"B", 'B'}, {"C", 'C'}, {"D", 'D'}, {"E", 'E'}, {"F", 'F'}, {"G", 'G'},
+    {"H", 'H'}, {"I", 'I'}, {"J", 'J'}, {"K", 'K'}, {"L", 'L'}, {"M", 'M'}, {"N", 'N'},
+    {"O", 'O'}, {"P", 'P'}, {"Q", 'Q'}, {"R", 'R'}, {"S", 'S'}, {"T", 'T'}, {"U", 'U'},
+    {"V", 'V'}, {"W", 'W'}, {"X", 'X'}, {"Y", 'Y'}, {"Z", 'Z'},
+    // Numbers
+    {"0", '0'}, {"1", '1'}, {"2", '2'}, {"3", '3'}, {"4", '4'},
+    {"5", '5'}, {"6", '6'}, {"7", '7'}, {"8", '8'}, {"9", '9'},
+    // Function keys
+    {"F1", VK_F1},   {"F2", VK_F2},   {"F3", VK_F3},   {"F4", VK_F4},
+    {"F5", VK_F5},   {"F6", VK_F6},   {"F7", VK_F7},   {"F8", VK_F8},
+    {"F9", VK_F9},   {"F10", VK_F10}, {"F11", VK_F11}, {"F12", VK_F12},
+    {"F13", VK_F13}, {"F14", VK_F14}, {"F15", VK_F15}, {"F16", VK_F16},
+    {"F17", VK_F17}, {"F18", VK_F18}, {"F19", VK_F19}, {"F20", VK_F20},
+    {"F21", VK_F21}, {"F22", VK_F22}, {"F23", VK_F23}, {"F24", VK_F24},
+    // 编辑/导航键
+    {"VK_DELETE", VK_DELETE}, {"VK_INSERT", VK_INSERT},
+    {"VK_HOME", VK_HOME},     {"VK_END", VK_END},
+    {"VK_PRIOR", VK_PRIOR},   {"VK_NEXT", VK_NEXT},     // Page Up / Page Down
+    {"VK_BACK", VK_BACK},     {"VK_ESCAPE", VK_ESCAPE},
+    {"VK_RETURN", VK_RETURN}, {"VK_TAB", VK_TAB},       {"VK_SPACE", VK_SPACE},
+    // 方向键
+    {"VK_LEFT", VK_LEFT}, {"VK_UP", VK_UP}, {"VK_RIGHT", VK_RIGHT}, {"VK_DOWN", VK_DOWN},
+    // 锁定键
+    {"VK_CAPITAL", VK_CAPITAL}, {"VK_NUMLOCK", VK_NUMLOCK}, {"VK_SCROLL", VK_SCROLL},
+    // 小键盘
+    {"VK_NUMPAD0", VK_NUMPAD0}, {"VK_NUMPAD1", VK_NUMPAD1}, {"VK_NUMPAD2", VK_NUMPAD2},
+    {"VK_NUMPAD3", VK_NUMPAD3}, {"VK_NUMPAD4", VK_NUMPAD4}, {"VK_NUMPAD5", VK_NUMPAD5},
+    {"VK_NUMPAD6", VK_NUMPAD6}, {"VK_NUMPAD7", VK_NUMPAD7}, {"VK_NUMPAD8", VK_NUMPAD8},
+    {"VK_NUMPAD9", VK_NUMPAD9},
+    {"VK_MULTIPLY", VK_MULTIPLY}, {"VK_ADD", VK_ADD},         {"VK_SEPARATOR", VK_SEPARATOR},
+    {"VK_SUBTRACT", VK_SUBTRACT}, {"VK_DECIMAL", VK_DECIMAL}, {"VK_DIVIDE", VK_DIVIDE},
+    // OEM 键（常见符号键）
+    {"VK_OEM_1", VK_OEM_1},         {"VK_OEM_PLUS", VK_OEM_PLUS},
+    {"VK_OEM_COMMA", VK_OEM_COMMA}, {"VK_OEM_MINUS", VK_OEM_MINUS},
+    {"VK_OEM_PERIOD", VK_OEM_PERIOD},
+    {"VK_OEM_2", VK_OEM_2}, {"VK_OEM_3", VK_OEM_3}, {"VK_OEM_4", VK_OEM_4},
+    {"VK_OEM_5", VK_OEM_5}, {"VK_OEM_6", VK_OEM_6}, {"VK_OEM_7", VK_OEM_7},
+    // 其它常用
+    {"VK_PAUSE", VK_PAUSE}, {"VK_SNAPSHOT", VK_SNAPSHOT}, // PrintScreen
+    {"VK_APPS", VK_APPS},   {"VK_SLEEP", VK_SLEEP},       // 菜单键 / 睡眠键
+};
+
+inline constexpr std::size_t kEntryCount = sizeof(kEntries) / sizeof(kEntries[0]);
+inline constexpr std::size_t kBucketCount = 64;  // 一级桶数
+inline constexpr std::size_t kSlotCount = 256;   // 二级槽数（装载率约 0.5）
+inline constexpr std::size_t kMaxBucketSize = 8;  // 单个一级桶允许的最大条目数
+inline constexpr std::size_t kMaxNameLength = 16;
+
+constexpr std::size_t nameLength(const char* s) {
+    std::size_t n = 0;
+    while (s[n] != '\0') ++n;
+    return n;
+}
+
+// FNV-1a，seed 参与初始状态，用于二级位移
+constexpr std::uint32_t hashName(const char* s, std::size_t len, std::uint32_t seed) {
+    std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (std::size_t i = 0; i < len; ++i) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+struct NameTable {
+    std::array<std::uint16_t, kBucketCount> seeds{};  // 每个一级桶的位移种子
+    std::array<std::uint8_t, kSlotCount> slots{};     // 条目下标 + 1，0 表示空槽
+    bool ok = false;
+};
+
+// 按桶大小降序为每个桶寻找种子，使桶内所有名称落入互不冲突的空槽
+constexpr NameTable buildNameTable() {
+    NameTable t{};
+    std::array<std::size_t, kEntryCount> lengths{};
+    std::array<std::size_t, kBucketCount + 1> bucketStart{}; // 计数排序后每个桶在 order 中的起点
+    std::array<std::uint8_t, kEntryCount> order{};
+    std::array<std::uint8_t, kEntryCount> bucketOf{};
+    for (std::size_t i = 0; i < kEntryCount; ++i) {
+        lengths[i] = nameLength(kEntries[i].name);
+        bucketOf[i] = static_cast<std::uint8_t>(hashName(kEntries[i].name, lengths[i], 0) % kBucketCount);
+        ++bucketStart[bucketOf[i] + 1];
+    }
+    std::size_t maxBucketSize = 0;
+    for (std::size_t b = 0; b < kBucketCount; ++b) {
+        if (bucketStart[b + 1] > maxBucketSize) maxBucketSize = bucketStart[b + 1];
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    if (maxBucketSize > kMaxBucketSize) return t; // ok == false，由 static_assert 报告
+    std::array<std::size_t, kBucketCount> fill{};
+    for (std::size_t i = 0; i < kEntryCount; ++i) {
+        order[bucketStart[bucketOf[i]] + fill[bucketOf[i]]++] = static_cast<std::uint8_t>(i);
+    }
+
+    for (std::size_t want = maxBucketSize; want > 0; --want) {
+        for (std::size_t b = 0; b < kBucketCount; ++b) {
+            const std::size_t first = bucketStart[b];
+            if (bucketStart[b + 1] - first != want) continue;
+            bool placed = false;
+            for (std::uint32_t seed = 1; seed < 0xFFFF && !placed; ++seed) {
+                std::array<std::size_t, kMaxBucketSize> trial{};
+                bool fits = true;
+                for (std::size_t m = 0; m < want && fits; ++m) {
+                    const std::size_t i = order[first + m];
+                    const std::size_t s = hashName(kEntries[i].name, lengths[i], seed) % kSlotCount;
+                    if (t.slots[s] != 0) fits = false;
+                    for (std::size_t k = 0; k < m && fits; ++k) {
+                        if (trial[k] == s) fits = false;
+                    }
+                    trial[m] = s;
+                }
+                if (!fits) continue;
+                for (std::size_t m = 0; m < want; ++m) {
+                    t.slots[trial[m]] = static_cast<std::uint8_t>(order[first + m] + 1);
+                }
+                t.seeds[b] = static_cast<std::uint16_t>(seed);
+                placed = true;
+            }
+            if (!placed) return t;
+        }
+    }
+    t.ok = true;
+    return t;
+}
+
+constexpr std::array<const char*, 256> buildCodeNames() {
+    std::array<const char*, 256> names{};
+    for (std::size_t i = 0; i < kEntryCount; ++i) {
+        if (names[kEntries[i].code] == nullptr) names[kEntries[i].code] = kEntries[i].name;
+    }
+    return names;
+}
+
+inline constexpr NameTable kNameTable = buildNameTable();
+inline constexpr std::array<const char*, 256> kCodeNames = buildCodeNames();
+
+static_assert(kEntryCount < 255, "VkCodeTable: slots 以 uint8 存储条目下标");
+static_assert(kNameTable.ok, "VkCodeTable: 无法构造完美哈希，请检查是否有重复名称或增大 kSlotCount");
+
+/**
+ * @brief 名称 -> VK 码。name 须为大写 ASCII。
+ * @return 未找到时返回 0
+ */
+constexpr DWORD nameToCode(const char* name, std::size_t len) {
+    if (len == 0 || len > kMaxNameLength) return 0;
+    const std::size_t b = hashName(name, len, 0) % kBucketCount;
+    const std::size_t s = hashName(name, len, kNameTable.seeds[b]) % kSlotCount;
+    const std::uint8_t idx = kNameTable.slots[s];
+    if (idx == 0) return 0;
+    const Entry& e = kEntries[idx - 1];
+    if (nameLength(e.name) != len) return 0;
+    for (std::size_t i = 0; i < len; ++i) {
+        if (e.name[i] != name[i]) return 0;
+    }
+    return e.code;
+}
+
+/**
+ * @brief VK 码 -> 规范名称。
+ * @return 未收录的 VK 码返回 nullptr
+ */
+constexpr const char* codeToName(DWORD vkCode) {
+    return vkCode < kCodeNames.size() ? kCodeNames[vkCode] : nullptr;
+}
+
+} // namespace VkCodeTable
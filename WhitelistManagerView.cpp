@@ -99,8 +99,8 @@ void WhitelistManagerView::setupUi()
 
     setLayout(mainLayout);
 
-    // Style (optional, can be refined with QSS later)
-    setStyleSheet("QPushButton { padding: 5px 10px; } QListWidget { font-size: 14px; }");
+    // Style comes from the application theme (Common.qss), scoped by this object name
+    setObjectName("whitelistManagerView");
 }
 
 void WhitelistManagerView::populateList(const QList<AppInfo>& apps)
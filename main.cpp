@@ -1,8 +1,11 @@
 #include "JianqiaoCoreShell.h"
+#include "LogSink.h"
+#include "LogCategories.h"
+#include "Trace.h"
+#include "ConfigStore.h"
+#include "Theme.h"
+#include "UiHealthMonitor.h"
 #include <QApplication>
-#include <QFile>
-#include <QTextStream>
-#include <QDateTime>
 #include <QDir>
 #include <QCoreApplication>
 
@@ -12,64 +15,14 @@ SystemInteractionModule* systemInteractionModule = nullptr;
 // 全局主窗口指针，供部分模块需要主窗口句柄时使用
 QWidget* mainWindow = nullptr;
 
-// Global file object for logging - ensure it's accessible and managed correctly.
-// For simplicity in a single file main.cpp, a static or global instance can be used,
-// but proper RAII / explicit open/close is better in larger apps.
-static QFile logFile;
-
-void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
-{
-    if (!logFile.isOpen()) {
-        // Attempt to open the log file if it's not already open.
-        // This is a fallback, ideally it's opened once in main.
-        QString logFilePath = QDir::currentPath() + "/log.txt";
-        logFile.setFileName(logFilePath);
-        if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-            // Cannot open log file, so just output to console as a last resort
-            fprintf(stderr, "Cannot open log file %s. Logging to console: %s\n", qPrintable(logFilePath), qPrintable(msg));
-            return;
-        }
-    }
-
-    QTextStream out(&logFile);
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-    out << timestamp << " ";
-
-    switch (type) {
-    case QtDebugMsg:       out << "DEBUG:   "; break;
-    case QtInfoMsg:        out << "INFO:    "; break;
-    case QtWarningMsg:     out << "WARNING: "; break;
-    case QtCriticalMsg:    out << "CRITICAL:"; break;
-    case QtFatalMsg:       out << "FATAL:   "; break;
-    }
-
-    // Include file and line info if available and useful (can be verbose)
-    // out << context.file << ":" << context.line << " "; 
-    out << msg << "\n";
-    out.flush(); // Ensure data is written immediately
-
-    // For fatal messages, abort after logging.
-    if (type == QtFatalMsg)
-        abort();
-}
-
 int main(int argc, char *argv[])
 {
-    // Open the log file at the beginning of the application run.
-    // Overwrite existing log file each time.
-    QString logFilePath = QDir::currentPath() + "/log.txt";
-    logFile.setFileName(logFilePath);
-    if (logFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
-        QTextStream(&logFile) << "--- Log started at " << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss") << " ---\n";
-        logFile.flush();
-    } else {
-        fprintf(stderr, "Failed to open log file: %s\n", qPrintable(logFilePath));
-        // Continue without file logging if it fails to open initially.
-    }
+    // 日志由 LogSink 异步批量写入 log.txt（每次启动覆盖），打开失败时输出到 stderr
+    LogSink::instance().open(QDir::currentPath() + "/log.txt");
+    qInstallMessageHandler(LogSink::messageHandler);
 
-    qInstallMessageHandler(myMessageOutput);
-
-    QApplication a(argc, argv);
+    // 与 QApplication 相同，另可按配置为 GUI 线程的事件计时（见 UiHealthMonitor）
+    UiHealthApplication a(argc, argv);
 
     // 设置应用元信息
     QCoreApplication::setOrganizationName("雪鸮团队");
@@ -81,6 +34,22 @@ int main(int argc, char *argv[])
 
     qDebug() << "Application started."; // This should now go to log.txt
 
+    // 按配置设置各子系统的日志级别、追踪与界面健康监视开关，配置文件被修改后立即生效
+    ConfigStore& config = ConfigStore::instance();
+    LogCategories::applyLevels(config.loggingLevels());
+    Trace::setEnabled(config.traceSpansEnabled());
+    UiHealthMonitor::instance().applySettings(config.uiHealthSettings());
+    QObject::connect(&config, &ConfigStore::loggingSettingsChanged, [&config] {
+        LogCategories::applyLevels(config.loggingLevels());
+        Trace::setEnabled(config.traceSpansEnabled());
+    });
+    QObject::connect(&config, &ConfigStore::uiHealthSettingsChanged, [&config] {
+        UiHealthMonitor::instance().applySettings(config.uiHealthSettings());
+    });
+
+    // 所有视图的样式表在此解析一次，之后创建的控件直接套用
+    Theme::apply(a);
+
     JianqiaoCoreShell w;
     w.show();
 
@@ -93,10 +62,9 @@ int main(int argc, char *argv[])
 
     int result = a.exec();
     qDebug() << "Application finished with exit code:" << result;
+    // 写出各线程最近的追踪记录，可用 JianqiaoTraceToJson 转换后在 Perfetto 中查看
+    Trace::dump(Trace::defaultDumpFilePath());
 
-    if (logFile.isOpen()) {
-        QTextStream(&logFile) << "--- Log finished at " << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss") << " ---\n";
-        logFile.close();
-    }
+    LogSink::instance().close();
     return result;
 } 
\ No newline at end of file
@@ -0,0 +1,194 @@
+// =============================
+// Dock 构建基准
+// =============================
+// 用法：JianqiaoDockBenchmark [次数]
+// 在 offscreen 平台下（未设置 QT_QPA_PLATFORM 时自动使用）分别为 10、100、1000 个应用构建 Dock，
+// 对比虚拟化的 DockView 与"每个应用一张卡片"的旧做法，输出构建耗时、滚动一遍的耗时、
+// 创建的卡片控件数与常驻内存增量（Windows 为工作集，Linux 为 /proc/self/statm 的 RSS）。每种规模重复若干次取中位数。
+// 应用使用内存中生成的图标，不触发可执行文件图标提取，测得的是纯界面开销。
+#include "AppCardWidget.h"
+#include "DockView.h"
+#include "Theme.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHBoxLayout>
+#include <QScrollArea>
+#include <QScrollBar>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+class SystemInteractionModule;
+
+// 应用代码通过 extern 引用的全局变量（正常由 main.cpp 定义）
+SystemInteractionModule* systemInteractionModule = nullptr;
+QWidget* mainWindow = nullptr;
+
+namespace {
+
+constexpr int DOCK_WIDTH = 1200;
+constexpr int DOCK_HEIGHT = 256;
+
+struct Sample {
+    double buildMs = 0;
+    double scrollMs = 0;
+    int cardWidgets = 0;
+    qint64 workingSetDeltaKb = 0;
+};
+
+// 进程常驻内存（KB），无法读取的平台返回 0
+qint64 workingSetKb()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters{};
+    counters.cb = sizeof(counters);
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return qint64(counters.WorkingSetSize / 1024);
+#elif defined(Q_OS_LINUX)
+    // statm：总页数 常驻页数 ...
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) {
+        return 0;
+    }
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE) / 1024;
+#else
+    return 0;
+#endif
+}
+
+QList<AppInfo> makeApps(int count)
+{
+    QList<AppInfo> apps;
+    apps.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QPixmap pixmap(64, 64);
+        pixmap.fill(QColor::fromHsv((i * 37) % 360, 160, 220));
+        AppInfo app;
+        app.name = QStringLiteral("App %1").arg(i);
+        app.path = QStringLiteral("C:/bench/app%1.exe").arg(i);
+        app.icon = QIcon(pixmap);
+        apps.append(app);
+    }
+    return apps;
+}
+
+void settle()
+{
+    QCoreApplication::processEvents();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+// 从头到尾按页滚动一遍
+double scrollThrough(QScrollBar* bar)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int value = bar->minimum(); value <= bar->maximum(); value += qMax(1, bar->pageStep() / 2)) {
+        bar->setValue(value);
+        QCoreApplication::processEvents();
+    }
+    return timer.nsecsElapsed() / 1e6;
+}
+
+Sample runVirtualized(const QList<AppInfo>& apps)
+{
+    Sample sample;
+    const qint64 before = workingSetKb();
+    QElapsedTimer timer;
+    timer.start();
+    DockView dock;
+    dock.resize(DOCK_WIDTH, DOCK_HEIGHT);
+    dock.show();
+    dock.setApps(apps);
+    QCoreApplication::processEvents();
+    sample.buildMs = timer.nsecsElapsed() / 1e6;
+    sample.workingSetDeltaKb = workingSetKb() - before;
+    sample.scrollMs = scrollThrough(dock.horizontalScrollBar());
+    sample.cardWidgets = dock.cardWidgetCount();
+    return sample;
+}
+
+// 旧做法：每个应用一张卡片，放进横向布局，由 QScrollArea 滚动
+Sample runEager(const QList<AppInfo>& apps)
+{
+    Sample sample;
+    const qint64 before = workingSetKb();
+    QElapsedTimer timer;
+    timer.start();
+    QScrollArea area;
+    area.setWidgetResizable(true);
+    area.resize(DOCK_WIDTH, DOCK_HEIGHT);
+    QWidget* content = new QWidget();
+    QHBoxLayout* layout = new QHBoxLayout(content);
+    layout->setContentsMargins(5, 0, 5, 0);
+    layout->setSpacing(5);
+    for (const AppInfo& app : apps) {
+        layout->insertWidget(layout->count() / 2, new AppCardWidget(app.name, app.path, app.icon, content));
+    }
+    area.setWidget(content);
+    area.show();
+    QCoreApplication::processEvents();
+    sample.buildMs = timer.nsecsElapsed() / 1e6;
+    sample.workingSetDeltaKb = workingSetKb() - before;
+    sample.scrollMs = scrollThrough(area.horizontalScrollBar());
+    sample.cardWidgets = apps.size();
+    return sample;
+}
+
+Sample median(std::vector<Sample> samples)
+{
+    auto pick = [&samples](auto member) {
+        std::sort(samples.begin(), samples.end(), [member](const Sample& a, const Sample& b) { return a.*member < b.*member; });
+        return samples[samples.size() / 2].*member;
+    };
+    Sample result;
+    result.buildMs = pick(&Sample::buildMs);
+    result.scrollMs = pick(&Sample::scrollMs);
+    result.workingSetDeltaKb = pick(&Sample::workingSetDeltaKb);
+    result.cardWidgets = samples.front().cardWidgets;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    Theme::apply(app);
+    const int runs = argc > 1 ? qMax(1, QString::fromLocal8Bit(argv[1]).toInt()) : 5;
+
+    QTextStream out(stdout);
+    out << "apps\tmode\tbuild_ms\tscroll_ms\tcard_widgets\tworking_set_delta_kb\n";
+    for (int count : {10, 100, 1000}) {
+        const QList<AppInfo> apps = makeApps(count);
+        for (const bool virtualized : {true, false}) {
+            std::vector<Sample> samples;
+            for (int i = 0; i < runs; ++i) {
+                samples.push_back(virtualized ? runVirtualized(apps) : runEager(apps));
+                settle();
+            }
+            const Sample result = median(samples);
+            out << count << '\t' << (virtualized ? "virtualized" : "eager") << '\t'
+                << QString::number(result.buildMs, 'f', 2) << '\t' << QString::number(result.scrollMs, 'f', 2) << '\t'
+                << result.cardWidgets << '\t' << result.workingSetDeltaKb << '\n';
+            out.flush();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+// =============================
+// 追踪转储 -> Chrome trace JSON
+// =============================
+// 用法：JianqiaoTraceToJson <trace.bin> [out.json]
+// 读取 Trace::dump() 写出的转储（格式见 TraceFormat.h），输出 Chrome Trace Event 格式的 JSON，
+// 可直接在 chrome://tracing 或 https://ui.perfetto.dev 中打开。未指定输出文件时写到标准输出。
+// span 的属性附加在结束事件上；环形缓冲区回绕导致缺少开始事件的结束事件会被跳过。
+#include "TraceFormat.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct OpenSpan {
+    std::uint32_t nameIndex;
+    std::string args; // 已格式化的 "key":value 列表
+};
+
+std::string escapeJson(const char* data, size_t size)
+{
+    std::string out;
+    out.reserve(size + 2);
+    out += '"';
+    for (size_t i = 0; i < size; ++i) {
+        const unsigned char c = static_cast<unsigned char>(data[i]);
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                out += buffer;
+            } else {
+                out += char(c);
+            }
+        }
+    }
+    out += '"';
+    return out;
+}
+
+std::string escapeJson(const std::string& text)
+{
+    return escapeJson(text.data(), text.size());
+}
+
+// 纳秒 -> 微秒（Chrome trace 的时间单位），保留三位小数
+std::string microseconds(std::uint64_t ns)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03u", static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned>(ns % 1000));
+    return buffer;
+}
+
+template <typename T>
+bool readValue(std::istream& in, T* value)
+{
+    return bool(in.read(reinterpret_cast<char*>(value), sizeof(T)));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3) {
+        std::cerr << "usage: " << argv[0] << " <trace.bin> [out.json]\n";
+        return 2;
+    }
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "cannot open " << argv[1] << "\n";
+        return 1;
+    }
+
+    TraceFormat::FileHeader header;
+    if (!readValue(in, &header) || std::memcmp(header.magic, TraceFormat::MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << argv[1] << " is not a trace dump\n";
+        return 1;
+    }
+    if (header.version != TraceFormat::VERSION) {
+        std::cerr << "unsupported trace dump version " << header.version << "\n";
+        return 1;
+    }
+
+    std::vector<std::string> strings(header.stringCount);
+    for (std::string& text : strings) {
+        std::uint32_t size = 0;
+        if (!readValue(in, &size)) {
+            std::cerr << "truncated string table\n";
+            return 1;
+        }
+        text.resize(size);
+        if (size > 0 && !in.read(&text[0], size)) {
+            std::cerr << "truncated string table\n";
+            return 1;
+        }
+    }
+    auto stringAt = [&](std::uint32_t index) -> const std::string& {
+        static const std::string unknown = "?";
+        return index < strings.size() ? strings[index] : unknown;
+    };
+
+    std::ofstream file;
+    if (argc == 3) {
+        file.open(argv[2], std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "cannot write " << argv[2] << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = argc == 3 ? static_cast<std::ostream&>(file) : std::cout;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"startEpochUs\":" << header.startEpochUs
+        << "},\"traceEvents\":[\n";
+    bool first = true;
+    auto writeEvent = [&](const std::string& event) {
+        out << (first ? "" : ",\n") << event;
+        first = false;
+    };
+
+    for (std::uint32_t t = 0; t < header.threadCount; ++t) {
+        TraceFormat::ThreadHeader thread;
+        if (!readValue(in, &thread)) {
+            std::cerr << "truncated thread block\n";
+            return 1;
+        }
+        const std::string tid = std::to_string(thread.threadId);
+        const std::string common = ",\"pid\":1,\"tid\":" + tid;
+        writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\"" + common + ",\"args\":{\"name\":"
+             + escapeJson(stringAt(thread.nameIndex)) + "}}");
+        if (thread.droppedCount > 0) {
+            std::cerr << "thread " << stringAt(thread.nameIndex) << ": " << thread.droppedCount
+                      << " older events were overwritten\n";
+        }
+
+        std::vector<OpenSpan> stack;
+        std::uint64_t lastTimestampNs = 0;
+        for (std::uint32_t e = 0; e < thread.eventCount; ++e) {
+            TraceFormat::Event event;
+            if (!readValue(in, &event)) {
+                std::cerr << "truncated event list\n";
+                return 1;
+            }
+            lastTimestampNs = event.timestampNs;
+            const std::string name = escapeJson(stringAt(event.nameIndex));
+            const std::string ts = ",\"ts\":" + microseconds(event.timestampNs);
+            switch (TraceFormat::EventKind(event.kind)) {
+            case TraceFormat::EventKind::Begin:
+                stack.push_back({event.nameIndex, std::string()});
+                writeEvent("{\"name\":" + name + ",\"ph\":\"B\"" + ts + common + "}");
+                break;
+            case TraceFormat::EventKind::End:
+                if (stack.empty()) break; // 开始事件已被覆盖
+                writeEvent("{\"name\":" + name + ",\"ph\":\"E\"" + ts + common + ",\"args\":{" + stack.back().args + "}}");
+                stack.pop_back();
+                break;
+            case TraceFormat::EventKind::AttrInt:
+            case TraceFormat::EventKind::AttrString: {
+                const std::string value = TraceFormat::EventKind(event.kind) == TraceFormat::EventKind::AttrInt
+                    ? std::to_string(event.intValue)
+                    : escapeJson(event.stringValue, std::min<size_t>(event.stringBytes, TraceFormat::INLINE_STRING_BYTES));
+                if (stack.empty()) {
+                    writeEvent("{\"name\":" + name + ",\"ph\":\"i\",\"s\":\"t\"" + ts + common + ",\"args\":{\"value\":" + value + "}}");
+                } else {
+                    std::string& args = stack.back().args;
+                    args += (args.empty() ? "" : ",") + name + ":" + value;
+                }
+                break;
+            }
+            case TraceFormat::EventKind::AsyncBegin:
+            case TraceFormat::EventKind::AsyncEnd: {
+                const char* phase = TraceFormat::EventKind(event.kind) == TraceFormat::EventKind::AsyncBegin ? "b" : "e";
+                writeEvent("{\"name\":" + name + ",\"cat\":\"async\",\"ph\":\"" + phase + "\",\"id\":\""
+                     + std::to_string(static_cast<unsigned long long>(event.intValue)) + "\"" + ts + common + "}");
+                break;
+            }
+            case TraceFormat::EventKind::Instant:
+                writeEvent("{\"name\":" + name + ",\"ph\":\"i\",\"s\":\"t\"" + ts + common + ",\"args\":{\"value\":"
+                     + std::to_string(event.intValue) + "}}");
+                break;
+            default:
+                break;
+            }
+        }
+        // 转储时仍未结束的 span 以最后一个事件的时间闭合，避免在时间线上丢失
+        while (!stack.empty()) {
+            writeEvent("{\"name\":" + escapeJson(stringAt(stack.back().nameIndex)) + ",\"ph\":\"E\",\"ts\":"
+                 + microseconds(lastTimestampNs) + common + ",\"args\":{" + stack.back().args + "}}");
+            stack.pop_back();
+        }
+    }
+    out << "\n]}\n";
+    return out.good() ? 0 : 1;
+}